@@ -130,6 +130,7 @@ bool Sample_Status(int handle);
 bool Is_Sample_Playing(void const* sample);
 void Stop_Sample_Playing(void const* sample);
 int Play_Sample(void const* sample, int priority = 0xFF, int volume = 0xFF, signed short panloc = 0x0);
+void Preload_Sample(void const* sample);
 int Set_Score_Vol(int volume);
 void Fade_Sample(int handle, int ticks);
 int Get_Digi_Handle(void);
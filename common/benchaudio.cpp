@@ -0,0 +1,312 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "audio.h"
+#include "endianness.h"
+#include "samplecache.h"
+#include "soscomp.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+/*
+** Sound effect decoding benchmark.
+**
+** Makes an SOS ADPCM sample from synthetic sound and decodes it with the block decoder in soscodec.cpp and with a
+** copy of the decoder as it was written originally, which decoded one nybble per table lookup. Both must give the
+** same samples. Mono and stereo are timed separately since the block decoder works on both stereo channels at once.
+**
+** It then times what playing the same effect over and over costs: decoding the whole .AUD every time, as the game
+** used to, against finding the decoded copy in a SampleCacheClass.
+**
+** Usage: bench_audio [-SECONDS:<length>] [-REPEAT:<count>] [-EVENTS:<count>]
+*/
+
+static const short RefIndexTab[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+static const short RefStepTab[89] = {
+    7,    8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,   28,
+    31,   34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,  118,
+    130,  143,   157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,  494,
+    544,  598,   658,   724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878, 2066,
+    2272, 2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+static struct
+{
+    int diff;
+    short index;
+} RefTable[89][16];
+
+static void Ref_Generate(void)
+{
+    for (int index = 0; index < 89; index++) {
+        int step = RefStepTab[index];
+
+        for (int nybble = 0; nybble < 16; nybble++) {
+            int diff = step >> 3;
+            if (nybble & 4) {
+                diff += step;
+            }
+            if (nybble & 2) {
+                diff += step >> 1;
+            }
+            if (nybble & 1) {
+                diff += step >> 2;
+            }
+            if (nybble & 8) {
+                diff = -diff;
+            }
+
+            int next = index + RefIndexTab[nybble & 7];
+            RefTable[index][nybble].diff = diff;
+            RefTable[index][nybble].index = next < 0 ? 0 : (next > 88 ? 88 : next);
+        }
+    }
+}
+
+/*
+** The 16 bit decoder as it was originally written: each channel in turn, one nybble per lookup.
+*/
+static void Ref_Decompress(_SOS_COMPRESS_INFO* stream, unsigned bytes)
+{
+    bytes /= 4;
+    if (bytes == 0) {
+        return;
+    }
+
+    int channels = stream->wChannels;
+    for (int channel = 0; channel < channels; ++channel) {
+        unsigned char* src = (unsigned char*)stream->lpSource + channel;
+        short* dst = (short*)stream->lpDest + channel;
+        short index = stream->Channels[channel].wIndex;
+        int sample = stream->Channels[channel].dwPredicted;
+
+        for (unsigned j = 0; j < bytes; ++j) {
+            unsigned char code = *src;
+            src += channels;
+
+            sample += RefTable[index][code & 0xF].diff;
+            sample = sample > 32767 ? 32767 : (sample < -32768 ? -32768 : sample);
+            *dst = sample;
+            dst += channels;
+            index = RefTable[index][code & 0xF].index;
+
+            sample += RefTable[index][code >> 4].diff;
+            sample = sample > 32767 ? 32767 : (sample < -32768 ? -32768 : sample);
+            *dst = sample;
+            dst += channels;
+            index = RefTable[index][code >> 4].index;
+        }
+
+        stream->Channels[channel].dwPredicted = sample;
+        stream->Channels[channel].wIndex = index;
+    }
+}
+
+/*
+** Something that sounds a little like gunfire: a few tones, noise and a decaying envelope.
+*/
+static std::vector<short> Make_Sound(int samples, unsigned seed)
+{
+    std::vector<short> pcm(samples);
+
+    for (int i = 0; i < samples; ++i) {
+        seed = seed * 1103515245 + 12345;
+        double envelope = 1.0 - (double)(i % 11025) / 11025.0;
+        double tone = sin(i * 0.031) * 9000.0 + sin(i * 0.17) * 4000.0;
+        double noise = (double)((int)((seed >> 16) & 0x7FFF) - 0x4000) * 0.9;
+        pcm[i] = (short)((tone + noise) * envelope);
+    }
+
+    return pcm;
+}
+
+static std::vector<char> Compress(std::vector<short> const& pcm, int channels)
+{
+    std::vector<char> adpcm(pcm.size() / 2 + 16);
+    _SOS_COMPRESS_INFO stream;
+    memset(&stream, 0, sizeof(stream));
+    stream.wBitSize = 16;
+    stream.wChannels = channels;
+    sosCODECInitStream(&stream);
+    stream.lpSource = (char*)&pcm[0];
+    stream.lpDest = &adpcm[0];
+    sosCODECCompressData(&stream, pcm.size() * 2);
+    return adpcm;
+}
+
+/*
+** Builds a mono .AUD sample in the game's chunked format.
+*/
+static std::vector<char> Make_Aud(std::vector<short> const& pcm)
+{
+    enum
+    {
+        CHUNK_SAMPLES = 2048
+    };
+
+    std::vector<char> aud(sizeof(AUDHeaderType));
+    _SOS_COMPRESS_INFO stream;
+    memset(&stream, 0, sizeof(stream));
+    stream.wBitSize = 16;
+    stream.wChannels = 1;
+    sosCODECInitStream(&stream);
+
+    std::vector<char> chunk(CHUNK_SAMPLES / 2);
+    int decoded = 0;
+
+    for (size_t start = 0; start + CHUNK_SAMPLES <= pcm.size(); start += CHUNK_SAMPLES) {
+        stream.lpSource = (char*)&pcm[start];
+        stream.lpDest = &chunk[0];
+        sosCODECCompressData(&stream, CHUNK_SAMPLES * 2);
+
+        uint16_t fsize = htole16(CHUNK_SAMPLES / 2);
+        uint16_t dsize = htole16(CHUNK_SAMPLES * 2);
+        uint32_t magic = htole32(0x0000DEAF);
+        aud.insert(aud.end(), (char*)&fsize, (char*)&fsize + sizeof(fsize));
+        aud.insert(aud.end(), (char*)&dsize, (char*)&dsize + sizeof(dsize));
+        aud.insert(aud.end(), (char*)&magic, (char*)&magic + sizeof(magic));
+        aud.insert(aud.end(), chunk.begin(), chunk.end());
+        decoded += CHUNK_SAMPLES * 2;
+    }
+
+    AUDHeaderType header;
+    header.Rate = htole16(22050);
+    header.Size = htole32((int32_t)(aud.size() - sizeof(AUDHeaderType)));
+    header.UncompSize = htole32(decoded);
+    header.Flags = AUD_FLAG_16BIT;
+    header.Compression = 99;
+    memcpy(&aud[0], &header, sizeof(header));
+    return aud;
+}
+
+static double Now(void)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+** Decodes the stream with both decoders, checks they agree, and prints how fast each was.
+*/
+static bool Compare_Decoders(char const* title, std::vector<char>& adpcm, int samples, int channels, int repeat)
+{
+    std::vector<short> ref(samples);
+    std::vector<short> block(samples);
+    double ref_time = 0;
+    double block_time = 0;
+
+    for (int pass = 0; pass < repeat; ++pass) {
+        _SOS_COMPRESS_INFO stream;
+        memset(&stream, 0, sizeof(stream));
+        stream.wBitSize = 16;
+        stream.wChannels = channels;
+
+        sosCODECInitStream(&stream);
+        stream.lpSource = &adpcm[0];
+        stream.lpDest = (char*)&ref[0];
+        double start = Now();
+        Ref_Decompress(&stream, samples * 2 / channels);
+        ref_time += Now() - start;
+
+        sosCODECInitStream(&stream);
+        stream.lpSource = &adpcm[0];
+        stream.lpDest = (char*)&block[0];
+        start = Now();
+        sosCODECDecompressData(&stream, samples * 2 / channels);
+        block_time += Now() - start;
+    }
+
+    bool same = memcmp(&ref[0], &block[0], samples * sizeof(short)) == 0;
+    double mega = (double)samples * repeat / 1000000.0;
+
+    printf("%s: original %.1f Msamples/s, block %.1f Msamples/s, %.2fx, output %s\n",
+           title,
+           mega / ref_time,
+           mega / block_time,
+           ref_time / block_time,
+           same ? "matches" : "DIFFERS");
+    return same;
+}
+
+int main(int argc, char** argv)
+{
+    int seconds = 30;
+    int repeat = 20;
+    int events = 2000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "-SECONDS:", 9) == 0) {
+            seconds = atoi(argv[i] + 9);
+        } else if (strncmp(argv[i], "-REPEAT:", 8) == 0) {
+            repeat = atoi(argv[i] + 8);
+        } else if (strncmp(argv[i], "-EVENTS:", 8) == 0) {
+            events = atoi(argv[i] + 8);
+        } else {
+            printf("Usage: bench_audio [-SECONDS:<length>] [-REPEAT:<count>] [-EVENTS:<count>]\n");
+            return 1;
+        }
+    }
+
+    if (seconds < 1 || repeat < 1 || events < 1) {
+        printf("The length and counts must be at least 1.\n");
+        return 1;
+    }
+
+    Ref_Generate();
+
+    int samples = (seconds * 22050) & ~3;
+    std::vector<short> mono = Make_Sound(samples, 1);
+    std::vector<char> mono_adpcm = Compress(mono, 1);
+    bool same = Compare_Decoders("Mono", mono_adpcm, samples, 1, repeat);
+
+    std::vector<short> stereo = Make_Sound(samples * 2, 2);
+    std::vector<char> stereo_adpcm = Compress(stereo, 2);
+    same &= Compare_Decoders("Stereo", stereo_adpcm, samples * 2, 2, repeat);
+
+    /*
+    ** A two second effect played over and over, as in a large battle.
+    */
+    std::vector<char> aud = Make_Aud(Make_Sound(2 * 22050, 3));
+    AUDHeaderType header;
+    memcpy(&header, &aud[0], sizeof(header));
+    std::vector<char> pcm(le32toh(header.UncompSize));
+
+    double start = Now();
+    for (int i = 0; i < events; ++i) {
+        SampleCacheClass::Decode(&aud[0], &pcm[0], (int)pcm.size());
+    }
+    double decode_time = Now() - start;
+
+    SampleCacheClass cache;
+    start = Now();
+    for (int i = 0; i < events; ++i) {
+        cache.Get(&aud[0]);
+    }
+    double cache_time = Now() - start;
+
+    void const* copy = cache.Get(&aud[0]);
+    same &= copy != &aud[0]
+            && memcmp((char const*)copy + sizeof(AUDHeaderType), &pcm[0], pcm.size()) == 0;
+
+    printf("Effect playback: decode every time %.1f us/event, sample cache %.2f us/event (%u hits, %u misses, "
+           "%u bytes held)\n",
+           decode_time * 1000000.0 / events,
+           cache_time * 1000000.0 / events,
+           cache.Hits,
+           cache.Misses,
+           cache.Bytes);
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "benchjobs.h"
+#include <stdio.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+int Run_Bench_Jobs(int count, int max_running, BenchJobType job, void* data)
+{
+    if (count > 1) {
+        printf("Running more than one job at a time is not supported on this platform.\n");
+        return count;
+    }
+
+    return (count == 1 && !job(0, data)) ? 1 : 0;
+}
+#else
+/*
+** Copies what a finished job printed to stdout and throws the copy away.
+*/
+static void Print_Output(FILE* output)
+{
+    char buffer[4096];
+    size_t length;
+
+    rewind(output);
+    while ((length = fread(buffer, 1, sizeof(buffer), output)) > 0) {
+        fwrite(buffer, 1, length, stdout);
+    }
+    fclose(output);
+    fflush(stdout);
+}
+
+int Run_Bench_Jobs(int count, int max_running, BenchJobType job, void* data)
+{
+    if (count <= 0) {
+        return 0;
+    }
+
+    if (max_running < 1) {
+        max_running = 1;
+    }
+
+    pid_t* pids = new pid_t[count];
+    FILE** outputs = new FILE*[count];
+    bool* done = new bool[count];
+    int failed = 0;
+    int started = 0;
+    int printed = 0;
+    int running = 0;
+
+    /*
+    ** Anything still buffered would otherwise be printed again by every child.
+    */
+    fflush(stdout);
+    fflush(stderr);
+
+    while (printed < count) {
+        if (started < count && running < max_running) {
+            int index = started++;
+            FILE* output = tmpfile();
+            pid_t pid = output != NULL ? fork() : -1;
+
+            if (pid == 0) {
+                dup2(fileno(output), STDOUT_FILENO);
+                bool succeeded = job(index, data);
+                fflush(stdout);
+                _exit(succeeded ? 0 : 1);
+            }
+
+            pids[index] = pid;
+            outputs[index] = output;
+            done[index] = pid < 0;
+
+            if (pid < 0) {
+                printf("Unable to start job %d.\n", index);
+                if (output != NULL) {
+                    fclose(output);
+                    outputs[index] = NULL;
+                }
+                ++failed;
+            } else {
+                ++running;
+            }
+        } else if (running > 0) {
+            int status;
+            pid_t pid = waitpid(-1, &status, 0);
+
+            if (pid < 0 && errno == EINTR) {
+                continue;
+            }
+
+            /*
+            ** If there is nothing left to wait for the jobs still running can never be reaped, so they are
+            ** counted as failed. Their output is still printed and the files thrown away.
+            */
+            for (int index = 0; index < started; ++index) {
+                if (pid < 0 && !done[index]) {
+                    pids[index] = -1;
+                    done[index] = true;
+                    --running;
+                    ++failed;
+                } else if (!done[index] && pids[index] == pid) {
+                    done[index] = true;
+                    --running;
+                    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                        ++failed;
+                    }
+                    break;
+                }
+            }
+        }
+
+        while (printed < started && done[printed]) {
+            if (outputs[printed] != NULL) {
+                Print_Output(outputs[printed]);
+                if (pids[printed] < 0) {
+                    printf("Lost track of job %d.\n", printed);
+                }
+            }
+            ++printed;
+        }
+    }
+
+    delete[] pids;
+    delete[] outputs;
+    delete[] done;
+
+    return failed;
+}
+#endif
@@ -0,0 +1,28 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef BENCHJOBS_H
+#define BENCHJOBS_H
+
+/*
+** Runs a batch of independent jobs, such as playing back recorded games, each in a child process of its own and
+** at most max_running at a time. The simulation keeps its state in globals, so one game per process is the only
+** way to run several side by side. A job returns true if it succeeded. What a job prints is held back until it
+** finishes and then printed in job order, so the reports of jobs running together don't get mixed up.
+**
+** Returns the number of jobs that failed or could not be started. Platforms without fork() can only run a
+** single job, in the calling process.
+*/
+typedef bool (*BenchJobType)(int job, void* data);
+
+int Run_Bench_Jobs(int count, int max_running, BenchJobType job, void* data);
+
+#endif
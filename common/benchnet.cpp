@@ -0,0 +1,420 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "wsploop.h"
+#include "connect.h"
+#include "crc.h"
+#include "delayctl.h"
+#include "winstub.h"
+#include "wwkeyboard.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/*
+** Lockstep network benchmark.
+**
+** Runs several nodes in one process, joined by a simulated network with adjustable latency, jitter, packet loss and
+** reordering. Each node talks to every other node through the same ConnectionClass send, ACK and retry logic as the
+** game's private connections. The nodes follow the game's lockstep rules: events are scheduled MaxAhead frames
+** ahead, they are sent every FrameSendRate frames, and a node can only advance once it has the events of every
+** other node for the frame it is about to run. Every node folds all the events into a running CRC, so the final
+** CRCs must all agree.
+**
+** With -ADAPTIVE:1 the first node acts as the game host and picks MaxAhead with a DelayControlClass every -ADJUST
+** frames, from the -PERCENT percentile of its response times. Every node uses the new value straight away. As in the
+** game, response times are then measured in whole 60ths of a second rather than in steps of a tenth.
+**
+** Usage: bench_net [-NODES:<count>] [-FRAMES:<count>] [-MAXAHEAD:<frames>] [-SENDRATE:<frames>] [-FRAMEMS:<ms>]
+**                  [-EVENTSIZE:<bytes>] [-LATENCY:<ms>] [-JITTER:<ms>] [-LOSS:<percent>] [-REORDER:<percent>]
+**                  [-RETRY:<ticks>] [-SEED:<number>] [-ADAPTIVE:<0|1>] [-ADJUST:<frames>] [-PERCENT:<percentile>]
+**                  [-VERBOSE:<0|1>]
+*/
+
+/*
+** The network code calls the keyboard to pump the message loop. None of that happens here.
+*/
+WWKeyboardClass* Keyboard = nullptr;
+
+/*
+** Same queue sizes and packet length as the game's private connections.
+*/
+#define BENCH_QUEUE_SIZE 32
+#define BENCH_PACKET_LEN (546 - sizeof(CommHeaderType))
+#define BENCH_MAGIC      0x5A3C
+
+/*
+** Body of each packet: the events for a run of frames.
+*/
+struct FramePacketType
+{
+    unsigned First;           // First frame the events are for.
+    unsigned short Count;     // Number of frames.
+    unsigned short EventSize; // Bytes of events per frame.
+};
+
+/*
+** A connection to one other node, sent over the node's loopback interface.
+*/
+class BenchConnClass : public ConnectionClass
+{
+public:
+    BenchConnClass(LoopbackInterfaceClass& port, unsigned address, unsigned retry)
+        : ConnectionClass(BENCH_QUEUE_SIZE, BENCH_QUEUE_SIZE, BENCH_PACKET_LEN, BENCH_MAGIC, retry, -1, -1)
+        , Port(port)
+        , Address(address)
+    {
+    }
+
+    LoopbackInterfaceClass& Port;
+    unsigned Address;
+
+protected:
+    virtual int Send(char* buf, int buflen, void*, int)
+    {
+        unsigned char address[64] = {0};
+        memcpy(address + 4, &Address, 4);
+        Port.WriteTo(buf, buflen, address);
+        return (1);
+    }
+};
+
+struct NodeType
+{
+    LoopbackInterfaceClass* Port;
+    std::vector<BenchConnClass*> Conns; // Indexed by node, NULL for this node.
+    std::vector<unsigned> Covered;      // First frame each node hasn't sent the events for yet.
+    std::vector<std::vector<int32_t>> Events; // Event CRC for each node and frame.
+    unsigned Frame;                     // Next frame to run.
+    unsigned SentTo;                    // First frame this node hasn't sent its events for.
+    int32_t CRC;                        // Running CRC of every event run so far.
+    long long StallUs;                  // Time spent waiting for other nodes.
+    unsigned Stalls;                    // Number of times the node had to wait.
+    bool IsStalled;
+};
+
+static bool Verbose = false;
+static unsigned Adjustments = 0;
+
+static void Timing_Decision(DelayControlClass::DecisionType const& decision)
+{
+    if (decision.MaxAhead != decision.Previous) {
+        Adjustments++;
+    }
+    if (Verbose) {
+        printf("  response %u jitter %u ticks at %d fps needs %d frames, MaxAhead %d -> %d\n",
+               decision.ResponseTime,
+               decision.Jitter,
+               decision.FrameRate,
+               decision.Needed,
+               decision.Previous,
+               decision.MaxAhead);
+    }
+}
+
+static int Option(int argc, char* argv[], char const* name, int value)
+{
+    size_t length = strlen(name);
+    for (int index = 1; index < argc; index++) {
+        if (strncasecmp(argv[index], name, length) == 0) {
+            value = atoi(argv[index] + length);
+        }
+    }
+    return (value);
+}
+
+/*
+** The events a node schedules for a frame. They only depend on the node, the frame and the seed so every node can
+** check what it was sent.
+*/
+static void Make_Events(unsigned char* buffer, int size, int node, unsigned frame, unsigned seed)
+{
+    unsigned value = seed ^ (node * 0x9E3779B9u) ^ (frame * 0x85EBCA6Bu);
+    for (int index = 0; index < size; index++) {
+        value = value * 1103515245u + 12345u;
+        buffer[index] = (unsigned char)(value >> 16);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int nodes = Option(argc, argv, "-NODES:", 4);
+    int frames = Option(argc, argv, "-FRAMES:", 2000);
+    int max_ahead = Option(argc, argv, "-MAXAHEAD:", 15);
+    int send_rate = Option(argc, argv, "-SENDRATE:", 3);
+    int frame_ms = Option(argc, argv, "-FRAMEMS:", 0);
+    int event_size = Option(argc, argv, "-EVENTSIZE:", 20);
+    int latency = Option(argc, argv, "-LATENCY:", 30);
+    int jitter = Option(argc, argv, "-JITTER:", 10);
+    int loss = Option(argc, argv, "-LOSS:", 0);
+    int reorder = Option(argc, argv, "-REORDER:", 0);
+    int retry = Option(argc, argv, "-RETRY:", 6);
+    unsigned seed = Option(argc, argv, "-SEED:", 1);
+    bool adaptive = Option(argc, argv, "-ADAPTIVE:", 0) != 0;
+    int adjust = Option(argc, argv, "-ADJUST:", 128);
+    int percent = Option(argc, argv, "-PERCENT:", 95);
+    Verbose = Option(argc, argv, "-VERBOSE:", 0) != 0;
+    ConnectionClass::IsFineTime = adaptive;
+
+    if (nodes < 2 || nodes > LoopbackNetworkClass::MAX_PORTS || frames <= 0 || max_ahead <= 0 || send_rate <= 0
+        || event_size <= 0 || event_size > (int)(BENCH_PACKET_LEN - sizeof(FramePacketType)) || adjust <= 0) {
+        printf("bench_net: bad options.\n");
+        return 1;
+    }
+
+    /*
+    ** Each send covers at least the frames up to the next send, otherwise the nodes would deadlock.
+    */
+    int lead = max_ahead > send_rate ? max_ahead : send_rate;
+    long long lead_total = 0;
+    int per_packet = (int)(BENCH_PACKET_LEN - sizeof(FramePacketType)) / event_size;
+
+    LoopbackNetworkClass* network = new LoopbackNetworkClass;
+    network->Set_Latency(latency, jitter);
+    network->Set_Loss(loss);
+    network->Set_Reorder(reorder);
+    network->Set_Seed(seed);
+
+    /*
+    ** The events are stored for the furthest any node could send ahead.
+    */
+    int lead_max = adaptive ? frames : lead;
+
+    /*
+    ** The response time is converted to frames at the rate they are run at, or at the game's top speed.
+    */
+    int frame_rate = frame_ms > 0 ? 1000 / frame_ms : 60;
+    DelayControlClass control(Timing_Decision);
+
+    std::vector<NodeType> node(nodes);
+    for (int index = 0; index < nodes; index++) {
+        node[index].Port = new LoopbackInterfaceClass(*network);
+        node[index].Port->Open_Socket(0);
+        node[index].Port->Start_Listening();
+    }
+
+    for (int index = 0; index < nodes; index++) {
+        NodeType& n = node[index];
+        n.Conns.assign(nodes, nullptr);
+        n.Covered.assign(nodes, 0);
+        n.Events.assign(nodes, std::vector<int32_t>(frames + lead_max + send_rate, 0));
+        n.Frame = 0;
+        n.SentTo = 0;
+        n.CRC = 0;
+        n.StallUs = 0;
+        n.Stalls = 0;
+        n.IsStalled = false;
+        for (int other = 0; other < nodes; other++) {
+            if (other != index) {
+                n.Conns[other] = new BenchConnClass(*n.Port, node[other].Port->Address, retry);
+                n.Conns[other]->Init();
+            }
+        }
+    }
+
+    std::vector<unsigned char> buffer(1024);
+    auto start = std::chrono::steady_clock::now();
+    auto last = start;
+    bool done = false;
+
+    while (!done) {
+        auto now = std::chrono::steady_clock::now();
+        long long step_us = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+        long long elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
+        last = now;
+        done = true;
+
+        for (int index = 0; index < nodes; index++) {
+            NodeType& n = node[index];
+
+            /*
+            ** Pick up whatever has arrived and pass it to the right connection.
+            */
+            for (;;) {
+                unsigned char address[64];
+                int length = (int)buffer.size();
+                int address_len = sizeof(address);
+                if (n.Port->Read(buffer.data(), length, address, address_len) == 0) {
+                    break;
+                }
+                unsigned from;
+                memcpy(&from, address + 4, 4);
+                for (int other = 0; other < nodes; other++) {
+                    if (n.Conns[other] != nullptr && n.Conns[other]->Address == from) {
+                        n.Conns[other]->Receive_Packet(buffer.data(), length);
+                    }
+                }
+            }
+
+            for (int other = 0; other < nodes; other++) {
+                BenchConnClass* conn = n.Conns[other];
+                if (conn == nullptr) {
+                    continue;
+                }
+
+                int length;
+                while (conn->Get_Packet(buffer.data(), &length)) {
+                    FramePacketType* packet = (FramePacketType*)buffer.data();
+                    unsigned char* data = buffer.data() + sizeof(FramePacketType);
+                    for (int frame = 0; frame < packet->Count; frame++) {
+                        unsigned f = packet->First + frame;
+                        if (f < n.Events[other].size()) {
+                            n.Events[other][f] = Calculate_CRC(data + frame * packet->EventSize, packet->EventSize);
+                        }
+                    }
+                    n.Covered[other] = packet->First + packet->Count;
+                }
+                conn->Service();
+            }
+
+            if (n.Frame >= (unsigned)frames) {
+                continue;
+            }
+            done = false;
+
+            /*
+            ** Send this node's events every FrameSendRate frames.
+            */
+            if (n.Frame % send_rate == 0 && n.SentTo < n.Frame + lead) {
+                unsigned end = n.Frame + lead;
+                while (n.SentTo < end) {
+                    FramePacketType* packet = (FramePacketType*)buffer.data();
+                    unsigned count = end - n.SentTo;
+                    if (count > (unsigned)per_packet) {
+                        count = per_packet;
+                    }
+                    packet->First = n.SentTo;
+                    packet->Count = count;
+                    packet->EventSize = event_size;
+                    for (unsigned frame = 0; frame < count; frame++) {
+                        unsigned char* data = buffer.data() + sizeof(FramePacketType) + frame * event_size;
+                        Make_Events(data, event_size, index, n.SentTo + frame, seed);
+                        if (n.SentTo + frame < n.Events[index].size()) {
+                            n.Events[index][n.SentTo + frame] = Calculate_CRC(data, event_size);
+                        }
+                    }
+                    for (int other = 0; other < nodes; other++) {
+                        if (n.Conns[other] != nullptr) {
+                            n.Conns[other]->Send_Packet(buffer.data(), sizeof(FramePacketType) + count * event_size, 1);
+                        }
+                    }
+                    n.SentTo += count;
+                }
+                n.Covered[index] = n.SentTo;
+            }
+
+            /*
+            ** Frames are run at the requested rate, or as fast as possible.
+            */
+            if (frame_ms > 0 && (long long)n.Frame * frame_ms > elapsed_ms) {
+                continue;
+            }
+
+            bool can_advance = true;
+            for (int other = 0; other < nodes; other++) {
+                if (n.Covered[other] <= n.Frame) {
+                    can_advance = false;
+                }
+            }
+
+            if (!can_advance) {
+                if (n.IsStalled) {
+                    n.StallUs += step_us;
+                } else {
+                    n.Stalls++;
+                }
+                n.IsStalled = true;
+                continue;
+            }
+            n.IsStalled = false;
+
+            CRCEngine crc(n.CRC);
+            for (int other = 0; other < nodes; other++) {
+                int32_t value = n.Events[other][n.Frame];
+                crc(&value, sizeof(value));
+            }
+            n.CRC = crc();
+            n.Frame++;
+
+            /*
+            ** The host works out the new MaxAhead from its own connections.
+            */
+            if (index == 0) {
+                lead_total += lead;
+                if (adaptive && n.Frame % adjust == 0) {
+                    unsigned response = 0;
+                    unsigned jitter = 0;
+                    for (int other = 1; other < nodes; other++) {
+                        CommBufferClass* queue = n.Conns[other]->Queue;
+                        unsigned value = queue->Percentile_Response_Time(percent);
+                        response = value > response ? value : response;
+                        value = queue->Response_Jitter();
+                        jitter = value > jitter ? value : jitter;
+                    }
+                    lead = control.Compute(response, jitter, frame_rate, send_rate, send_rate * 2);
+                }
+            }
+        }
+
+        if (!done) {
+            std::this_thread::yield();
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    /*
+    ** Every node has run the same events, so the CRCs have to agree.
+    */
+    bool agree = true;
+    long long stall_us = 0;
+    unsigned stalls = 0;
+    for (int index = 0; index < nodes; index++) {
+        if (node[index].CRC != node[0].CRC) {
+            agree = false;
+        }
+        stall_us += node[index].StallUs;
+        stalls += node[index].Stalls;
+    }
+
+    printf("bench_net: %d nodes, MaxAhead %d%s, FrameSendRate %d\n",
+           nodes,
+           max_ahead,
+           adaptive ? " (adaptive)" : "",
+           send_rate);
+    printf("  network:      %d ms latency, %d ms jitter, %d%% loss, %d%% reorder\n", latency, jitter, loss, reorder);
+    printf("  frames:       %d\n", frames);
+    printf("  elapsed:      %.3f s\n", seconds);
+    printf("  frames/sec:   %.1f\n", seconds > 0 ? frames / seconds : 0.0);
+    printf("  stalls:       %u\n", stalls);
+    printf("  stall/node:   %.1f ms\n", stall_us / 1000.0 / nodes);
+    printf("  MaxAhead:     %.1f frames average, %d final, %u changes\n",
+           (double)lead_total / frames,
+           lead,
+           Adjustments);
+    printf("  packets:      %u sent, %u lost\n", network->PacketsSent, network->PacketsLost);
+    printf("  bytes/frame:  %.1f\n", (double)network->BytesSent / frames);
+    printf("  CRC:          %08X (%s)\n", (unsigned)node[0].CRC, agree ? "all nodes agree" : "MISMATCH");
+
+    for (int index = 0; index < nodes; index++) {
+        for (int other = 0; other < nodes; other++) {
+            delete node[index].Conns[other];
+        }
+        delete node[index].Port;
+    }
+    delete network;
+
+    return agree ? 0 : 1;
+}
@@ -43,6 +43,7 @@
  *   CCFileClass::Write -- Writes data to the file (non mixfile files only).                   *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 #include <errno.h>
+#include <mutex>
 #include "ccfile.h"
 
 /***********************************************************************************************
@@ -480,16 +481,38 @@ int CCFileClass::Open(int rights)
 
 static CCFileClass Handles[10];
 
+/*
+**	The audio and movie threads open and close files through these handles as well as the game
+**	thread. A handle belongs to whoever opened it until it is closed, so only picking a free
+**	handle and giving one back need the lock.
+*/
+static bool HandleTaken[ARRAY_SIZE(Handles)];
+static std::mutex HandleLock;
+
 int Open_File(char const* file_name, int mode)
 {
-    for (int index = 0; index < ARRAY_SIZE(Handles); index++) {
-        if (!Handles[index].Is_Open()) {
-            if (Handles[index].Open(file_name, mode)) {
-                return (index);
+    int index;
+
+    {
+        std::lock_guard<std::mutex> lock(HandleLock);
+        for (index = 0; index < ARRAY_SIZE(Handles); index++) {
+            if (!HandleTaken[index]) {
+                HandleTaken[index] = true;
+                break;
             }
-            break;
         }
     }
+
+    if (index == ARRAY_SIZE(Handles)) {
+        return (WWERROR);
+    }
+
+    if (Handles[index].Open(file_name, mode)) {
+        return (index);
+    }
+
+    std::lock_guard<std::mutex> lock(HandleLock);
+    HandleTaken[index] = false;
     return (WWERROR);
 }
 
@@ -497,6 +520,9 @@ void Close_File(int handle)
 {
     if (handle != WWERROR && Handles[handle].Is_Open()) {
         Handles[handle].Close();
+
+        std::lock_guard<std::mutex> lock(HandleLock);
+        HandleTaken[handle] = false;
     }
 }
 
@@ -44,6 +44,8 @@
  *   CommBufferClass::Avg_Response_Time -- returns average response time  	*
  *   CommBufferClass::Max_Response_Time -- returns max response time  		*
  *   CommBufferClass::Reset_Response_Time -- resets computations				*
+ *   CommBufferClass::Percentile_Response_Time -- returns recent percentile*
+ *   CommBufferClass::Response_Jitter -- returns variation in response time*
  *   Mono_Debug_Print -- Debug output routine                              *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
@@ -191,6 +193,9 @@ void CommBufferClass::Init(void)
     NumDelay = 0;
     MeanDelay = 0;
     MaxDelay = 0;
+    DelayNext = 0;
+    LastDelay = 0;
+    DelayJitter = 0;
 
     SendCount = 0;
 
@@ -684,6 +689,19 @@ void CommBufferClass::Add_Delay(unsigned int delay)
         MaxDelay = delay;
     }
 
+    /*------------------------------------------------------------------------
+    Keep the most recent delays for the percentiles, and a running average of
+    how much each delay differs from the one before it.
+    ------------------------------------------------------------------------*/
+    DelayHistory[DelayNext % DELAY_HISTORY] = delay;
+    DelayNext++;
+
+    if (DelayNext > 1) {
+        unsigned int change = (delay > LastDelay) ? (delay - LastDelay) : (LastDelay - delay);
+        DelayJitter = DelayJitter + change - ((DelayJitter + 8) >> 4);
+    }
+    LastDelay = delay;
+
 } /* end of Add_Delay */
 
 /***************************************************************************
@@ -749,9 +767,78 @@ void CommBufferClass::Reset_Response_Time(void)
     NumDelay = 0;
     MeanDelay = 0;
     MaxDelay = 0;
+    DelayNext = 0;
+    LastDelay = 0;
+    DelayJitter = 0;
 
 } /* end of Reset_Response_Time */
 
+/***************************************************************************
+ * CommBufferClass::Percentile_Response_Time -- returns recent percentile  *
+ *                                                                         *
+ * Sorts the most recent delay values & returns the one that the given		*
+ * percentage of them are at or below.  Unlike the average, this isn't		*
+ * pulled down by a run of fast packets, so it's a better measure of how	*
+ * long a packet might take.																*
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		percent		percentile to return, 0 - 100										*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		response time percentile, 0 if no delays have been recorded				*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *                                                                         *
+ *=========================================================================*/
+unsigned int CommBufferClass::Percentile_Response_Time(int percent)
+{
+    unsigned int sorted[DELAY_HISTORY];
+    int count = (DelayNext < DELAY_HISTORY) ? DelayNext : DELAY_HISTORY;
+    int i;
+    int j;
+
+    if (count == 0) {
+        return (0);
+    }
+
+    for (i = 0; i < count; i++) {
+        unsigned int value = DelayHistory[i];
+        for (j = i; j > 0 && sorted[j - 1] > value; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+
+    if (percent < 0) {
+        percent = 0;
+    } else if (percent > 100) {
+        percent = 100;
+    }
+
+    return (sorted[((count - 1) * percent + 99) / 100]);
+
+} /* end of Percentile_Response_Time */
+
+/***************************************************************************
+ * CommBufferClass::Response_Jitter -- returns variation in response time  *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none.																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		average change from one delay value to the next							*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *                                                                         *
+ *=========================================================================*/
+unsigned int CommBufferClass::Response_Jitter(void)
+{
+    return ((DelayJitter + 8) >> 4);
+
+} /* end of Response_Jitter */
+
 /***************************************************************************
  * CommBufferClass::Configure_Debug -- sets up special debug values        *
  *                                                                         *
@@ -53,6 +53,11 @@
 /*
 ********************************** Defines **********************************
 */
+/*---------------------------------------------------------------------------
+Number of recent delay times kept for the response time percentiles
+---------------------------------------------------------------------------*/
+#define DELAY_HISTORY 32
+
 /*---------------------------------------------------------------------------
 This is one output queue entry
 ---------------------------------------------------------------------------*/
@@ -147,6 +152,8 @@ public:
     unsigned int Avg_Response_Time(void); // gets mean response time
     unsigned int Max_Response_Time(void); // gets max response time
     void Reset_Response_Time(void);       // resets computations
+    unsigned int Percentile_Response_Time(int percent); // gets recent response time percentile
+    unsigned int Response_Jitter(void);                 // gets variation in response time
 
     /*
     ........................ Debug output routines ........................
@@ -174,6 +181,10 @@ private:
     unsigned int NumDelay;  // current # delay times summed
     unsigned int MeanDelay; // current average delay time
     unsigned int MaxDelay;  // max delay ever for this queue
+    unsigned int DelayHistory[DELAY_HISTORY]; // most recent delay times
+    unsigned int DelayNext;                   // next DelayHistory entry to use
+    unsigned int LastDelay;                   // previous delay time
+    unsigned int DelayJitter;                 // average change between delays, * 16
 
     /*
     ........................ Send Queue variables .........................
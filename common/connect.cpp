@@ -55,6 +55,8 @@
 */
 const char* ConnectionClass::Commands[PACKET_COUNT] = {"ADATA", "NDATA", "ACK"};
 
+bool ConnectionClass::IsFineTime = false;
+
 /***************************************************************************
  * ConnectionClass::ConnectionClass -- class constructor                   *
  *                                                                         *
@@ -747,7 +749,7 @@ int ConnectionClass::Service_Receive_Queue(void)
  *=========================================================================*/
 unsigned int ConnectionClass::Time(void)
 {
-    unsigned int msec;
+    long long msec;
 
 #ifdef WWLIB32_H
 
@@ -773,9 +775,17 @@ unsigned int ConnectionClass::Time(void)
 
     static auto epoch = std::chrono::steady_clock::now().time_since_epoch();
     auto now = std::chrono::steady_clock::now().time_since_epoch();
-    msec = unsigned(std::chrono::duration_cast<std::chrono::milliseconds>(now - epoch).count());
+    msec = std::chrono::duration_cast<std::chrono::milliseconds>(now - epoch).count();
 
-    return ((msec / 100) * 6);
+    /*------------------------------------------------------------------------
+    Convert to 60ths of a second.  Rounding to whole tenths first makes every
+    response time on a fast connection come out as 0 or 6, so that is only
+    done when the finer count hasn't been asked for.
+    ------------------------------------------------------------------------*/
+    if (IsFineTime) {
+        return (unsigned int)((msec * 60) / 1000);
+    }
+    return (unsigned int)((msec / 100) * 6);
 } /* end of Time */
 
 /***************************************************************************
@@ -186,6 +186,13 @@ public:
     .....................................................................*/
     static unsigned int Time(void);
 
+    /*.....................................................................
+    If set, Time counts in whole 60ths of a second instead of stepping by 6
+    every tenth of a second.  The adaptive frame delay needs this to tell
+    apart response times below a tenth of a second.
+    .....................................................................*/
+    static bool IsFineTime;
+
     /*.....................................................................
     Utility routines.
     .....................................................................*/
@@ -122,6 +122,8 @@ public:
     .....................................................................*/
     virtual void Reset_Response_Time(void) = 0;
     virtual unsigned int Response_Time(void) = 0;
+    virtual unsigned int Percentile_Response_Time(int percent) = 0;
+    virtual unsigned int Response_Jitter(void) = 0;
     virtual void Set_Timing(unsigned int retrydelta, unsigned int maxretries, unsigned int timeout) = 0;
 
     /*.....................................................................
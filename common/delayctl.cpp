@@ -0,0 +1,91 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "delayctl.h"
+
+DelayControlClass::DelayControlClass(HookType hook)
+    : Hook(hook)
+    , MaxAhead(0)
+    , Surplus(0)
+{
+}
+
+/*
+** Forgets the previous decisions, the next one takes whatever the connections need straight away.
+*/
+void DelayControlClass::Reset(void)
+{
+    MaxAhead = 0;
+    Surplus = 0;
+}
+
+/*
+** Works out the new frame delay. The response time and jitter are in ticks (60ths of a second) and
+** cover the whole round trip. The result is a multiple of the send rate and is never below the
+** minimum given.
+*/
+int DelayControlClass::Compute(unsigned int response_time,
+                               unsigned int jitter,
+                               int frame_rate,
+                               int send_rate,
+                               int minimum)
+{
+    if (send_rate < 1) {
+        send_rate = 1;
+    }
+
+    /*
+    ** A packet only has to make it one way. It can also be held back for up to a whole send period
+    ** before it goes out, so that is added on as well.
+    */
+    unsigned int one_way = (response_time + jitter * 2 + 1) / 2;
+    int needed = (int)((one_way * frame_rate + 59) / 60) + send_rate;
+
+    needed = ((needed + send_rate - 1) / send_rate) * send_rate;
+    if (needed < minimum) {
+        needed = minimum;
+    }
+
+    int previous = MaxAhead;
+
+    if (MaxAhead == 0 || needed >= MaxAhead) {
+        MaxAhead = needed;
+        Surplus = 0;
+    } else if (++Surplus >= SETTLE_COUNT) {
+        MaxAhead -= send_rate;
+        if (MaxAhead < needed) {
+            MaxAhead = needed;
+        }
+        Surplus = 0;
+    }
+
+    /*
+    ** The send rate or minimum may have changed since the last decision.
+    */
+    MaxAhead = ((MaxAhead + send_rate - 1) / send_rate) * send_rate;
+    if (MaxAhead < minimum) {
+        MaxAhead = minimum;
+    }
+
+    if (Hook != NULL) {
+        DecisionType decision;
+        decision.ResponseTime = response_time;
+        decision.Jitter = jitter;
+        decision.FrameRate = frame_rate;
+        decision.SendRate = send_rate;
+        decision.Needed = needed;
+        decision.Previous = previous;
+        decision.MaxAhead = MaxAhead;
+        Hook(decision);
+    }
+
+    return (MaxAhead);
+}
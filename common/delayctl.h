@@ -0,0 +1,72 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef DELAYCTL_H
+#define DELAYCTL_H
+
+#include <stddef.h>
+
+/*
+** Picks the frame delay (MaxAhead) for a lockstep game from the measured response time of the
+** connections. The response time given should be a high percentile of the round trip time rather
+** than the average, and the jitter is added on top of that, so the delay covers nearly every packet
+** rather than the typical one.
+**
+** The delay goes up as soon as the connection needs it, since every late packet stalls the game. It
+** only comes down one send period at a time, and only once the connection has needed less for
+** several decisions in a row, so a short quiet spell doesn't cause a stall when the traffic comes
+** back.
+*/
+class DelayControlClass
+{
+public:
+    /*
+    **	Everything that went into a decision, passed to the hook each time one is made.
+    */
+    struct DecisionType
+    {
+        unsigned int ResponseTime; // Round trip time allowed for, in ticks.
+        unsigned int Jitter;       // Variation in the round trip time, in ticks.
+        int FrameRate;             // Game frames per second.
+        int SendRate;              // Frames between each send.
+        int Needed;                // Frames of delay the connections need.
+        int Previous;              // Frame delay before the decision.
+        int MaxAhead;              // Frame delay chosen.
+    };
+
+    typedef void (*HookType)(DecisionType const& decision);
+
+    enum
+    {
+        SETTLE_COUNT = 2 // Decisions in a row that must need less before the delay comes down.
+    };
+
+    DelayControlClass(HookType hook = NULL);
+
+    void Reset(void);
+    int Compute(unsigned int response_time, unsigned int jitter, int frame_rate, int send_rate, int minimum);
+
+    int Current(void) const
+    {
+        return (MaxAhead);
+    }
+
+    /*
+    **	Called with every decision made, may be NULL.
+    */
+    HookType Hook;
+
+private:
+    int MaxAhead; // Frame delay chosen last time, zero before the first decision.
+    int Surplus;  // Decisions in a row that needed less than the current delay.
+};
+
+#endif
@@ -252,6 +252,15 @@ GraphicBufferClass::~GraphicBufferClass()
 }
 
 bool GraphicBufferClass::Lock()
+{
+    return Lock(Rect(0, 0, Width, Height));
+}
+
+/*
+** The area given is what the caller may write to while it holds the lock. It is passed on to the video surface so
+** the next present knows what to update.
+*/
+bool GraphicBufferClass::Lock(const Rect& dirty)
 {
     //
     // If its not a direct draw surface then the lock is always sucessful.
@@ -279,6 +288,7 @@ bool GraphicBufferClass::Lock()
     //
     if (LockCount) {
         LockCount++;
+        VideoSurfacePtr->AddDirtyRect(dirty);
         return true;
     }
 
@@ -301,6 +311,7 @@ bool GraphicBufferClass::Lock()
         Pitch -= Width;
         LockCount++;  // increment count so we can track if
         TotalLocks++; // Total number of times we have locked (for debugging)
+        VideoSurfacePtr->AddDirtyRect(dirty);
         result = true;
     }
 
@@ -150,6 +150,7 @@ public:
     void Un_Init();
     void Attach_DD_Surface(GraphicBufferClass* attach_buffer);
     bool Lock();
+    bool Lock(const Rect& dirty);
     bool Unlock();
     bool IsAllocated() const;
 
@@ -343,7 +343,7 @@ bool GraphicViewPortClass::DD_Linear_Blit_To_Linear(GraphicViewPortClass& dest,
  *=============================================================================================*/
 bool GraphicViewPortClass::Lock()
 {
-    bool lock = GraphicBuff->Lock();
+    bool lock = GraphicBuff->Lock(Rect(XPos, YPos, Width, Height));
     if (!lock) {
         return false;
     }
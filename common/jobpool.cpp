@@ -0,0 +1,146 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "jobpool.h"
+
+JobPoolClass::JobPoolClass(void)
+    : WorkerCount(0)
+    , Generation(0)
+    , Quit(false)
+    , Job(nullptr)
+    , Data(nullptr)
+    , Count(0)
+    , ChunkCount(0)
+    , NextChunk(0)
+    , ChunksDone(0)
+{
+}
+
+JobPoolClass::~JobPoolClass(void)
+{
+    Stop();
+}
+
+/*
+** Starts the worker threads, one less than there are cores if no number is given.
+*/
+void JobPoolClass::Start(int workers)
+{
+    Stop();
+
+    if (workers < 0) {
+        workers = (int)std::thread::hardware_concurrency() - 1;
+    }
+    if (workers > MAX_WORKERS) {
+        workers = MAX_WORKERS;
+    }
+
+    Quit = false;
+    for (WorkerCount = 0; WorkerCount < workers; ++WorkerCount) {
+        Workers[WorkerCount] = std::thread(&JobPoolClass::Worker, this);
+    }
+}
+
+void JobPoolClass::Stop(void)
+{
+    if (WorkerCount == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(Lock);
+        Quit = true;
+    }
+    Wake.notify_all();
+
+    for (int index = 0; index < WorkerCount; ++index) {
+        Workers[index].join();
+    }
+    WorkerCount = 0;
+}
+
+/*
+** Runs the job over count items, split into chunks unless there are fewer than minimum. Returns the number of
+** chunks used; chunk numbers go from 0 to one less than that.
+*/
+int JobPoolClass::Run(int count, int minimum, JobType job, void* data)
+{
+    if (count <= 0) {
+        return 0;
+    }
+
+    if (WorkerCount == 0 || count < minimum || count < Chunks()) {
+        job(0, 0, count, data);
+        return 1;
+    }
+
+    unsigned generation;
+    {
+        std::lock_guard<std::mutex> lock(Lock);
+        Job = job;
+        Data = data;
+        Count = count;
+        ChunkCount = Chunks();
+        NextChunk = 0;
+        ChunksDone = 0;
+        generation = ++Generation;
+    }
+    Wake.notify_all();
+
+    Do_Chunks(generation);
+
+    std::unique_lock<std::mutex> lock(Lock);
+    Finished.wait(lock, [this] { return ChunksDone == ChunkCount; });
+    return ChunkCount;
+}
+
+/*
+** Takes chunks of the batch given until there are none left. The chunks are handed out under the lock, so a
+** worker that wakes late never takes a chunk of a later batch than the one it was woken for.
+*/
+void JobPoolClass::Do_Chunks(unsigned generation)
+{
+    std::unique_lock<std::mutex> lock(Lock);
+
+    while (Generation == generation && NextChunk < ChunkCount) {
+        int chunk = NextChunk++;
+        int first = (int)((long long)Count * chunk / ChunkCount);
+        int last = (int)((long long)Count * (chunk + 1) / ChunkCount);
+        JobType job = Job;
+        void* data = Data;
+
+        lock.unlock();
+        job(chunk, first, last, data);
+        lock.lock();
+
+        if (++ChunksDone == ChunkCount) {
+            Finished.notify_one();
+        }
+    }
+}
+
+void JobPoolClass::Worker(void)
+{
+    unsigned generation = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(Lock);
+            Wake.wait(lock, [&] { return Quit || Generation != generation; });
+            if (Quit) {
+                return;
+            }
+            generation = Generation;
+        }
+
+        Do_Chunks(generation);
+    }
+}
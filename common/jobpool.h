@@ -0,0 +1,80 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef JOBPOOL_H
+#define JOBPOOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/*
+** A few worker threads that share out the items of a loop. Run splits the items into contiguous chunks, one for
+** each worker and one for the calling thread, and returns once every chunk is done. Which thread runs a chunk
+** varies from call to call, so a job should only write results for its own chunk; the caller then combines them
+** in chunk order, which gives the same answer as running the loop in one thread.
+**
+** With no workers started, or fewer items than the minimum given, Run just calls the job for the whole range.
+*/
+class JobPoolClass
+{
+public:
+    enum
+    {
+        MAX_WORKERS = 15,
+        MAX_CHUNKS = MAX_WORKERS + 1
+    };
+
+    typedef void (*JobType)(int chunk, int first, int last, void* data);
+
+    JobPoolClass(void);
+    ~JobPoolClass(void);
+
+    void Start(int workers = -1);
+    void Stop(void);
+    int Chunks(void) const
+    {
+        return WorkerCount + 1;
+    }
+
+    int Run(int count, int minimum, JobType job, void* data);
+
+private:
+    void Worker(void);
+    void Do_Chunks(unsigned generation);
+
+    std::thread Workers[MAX_WORKERS];
+    int WorkerCount;
+
+    std::mutex Lock;
+    std::condition_variable Wake;
+    std::condition_variable Finished;
+    unsigned Generation; // Counts the calls to Run, so workers can tell a new batch from the last one.
+    bool Quit;
+
+    /*
+    ** The batch being run.
+    */
+    JobType Job;
+    void* Data;
+    int Count;
+    int ChunkCount;
+    int NextChunk;
+    int ChunksDone;
+
+    // The assignment operator is not supported.
+    JobPoolClass& operator=(JobPoolClass const&) = delete;
+
+    // The copy constructor is not supported.
+    JobPoolClass(JobPoolClass const&) = delete;
+};
+
+#endif
@@ -13,6 +13,7 @@
 #include "graphicsviewport.h"
 #include "keyframe.h"
 #include "shape.h"
+#include "simd.h"
 #include <string.h>
 #include <stdarg.h>
 #include <stdint.h>
@@ -85,18 +86,29 @@ void BF_Trans(int width,
               int count)
 {
     while (height--) {
-        for (int i = width; i > 0; --i) {
-            unsigned char sbyte = *src++;
+        int i = 0;
 
-            if (sbyte) {
-                *dst = sbyte;
+#ifdef SIMD_BYTES
+        // Whole vectors at a time, leaving the destination alone where they are all transparent.
+        for (; i + SIMD_BYTES <= width; i += SIMD_BYTES) {
+            SimdType pixels = Simd_Load(src + i);
+
+            if (!Simd_Is_Zero(pixels)) {
+                Simd_Store(dst + i, Simd_Select_Nonzero(pixels, Simd_Load(dst + i)));
             }
+        }
+#endif
 
-            ++dst;
+        for (; i < width; ++i) {
+            unsigned char sbyte = src[i];
+
+            if (sbyte) {
+                dst[i] = sbyte;
+            }
         }
 
-        src += src_pitch;
-        dst += dst_pitch;
+        src += width + src_pitch;
+        dst += width + dst_pitch;
     }
 }
 
@@ -1171,17 +1183,121 @@ static Single_Line_Function NewShapeJumpTable[32] = {Single_Line_Copy,
                                                      Single_Line_Skip,
                                                      Single_Line_Skip};
 
-// Definition copied from 2keyfram.cpp
-typedef struct tShapeHeaderType
-{
-    unsigned draw_flags;
-    char* shape_data;
-    int shape_buffer; // 1 if shape is in theater buffer
-} ShapeHeaderType;
-
 // Copied from conquer.cpp
 #define SHAPE_TRANS 0x40
 
+// Span versions, these draw one run of opaque pixels so there is no transparency to test.
+// The fade table has already been applied as many times as the fade count asks for.
+typedef void (*SF_Function)(int, unsigned char*, unsigned char const*, unsigned char*, unsigned char*, unsigned char*);
+
+void SF_Copy(int length,
+             unsigned char* dst,
+             unsigned char const* src,
+             unsigned char* ghost_lookup,
+             unsigned char* ghost_tab,
+             unsigned char* fade_tab)
+{
+    memcpy(dst, src, length);
+}
+
+void SF_Ghost(int length,
+              unsigned char* dst,
+              unsigned char const* src,
+              unsigned char* ghost_lookup,
+              unsigned char* ghost_tab,
+              unsigned char* fade_tab)
+{
+    for (int i = 0; i < length; ++i) {
+        unsigned char sbyte = src[i];
+        unsigned char fbyte = ghost_lookup[sbyte];
+
+        if (fbyte != 0xFF) {
+            sbyte = ghost_tab[dst[i] + fbyte * 256];
+        }
+
+        dst[i] = sbyte;
+    }
+}
+
+void SF_Fading(int length,
+               unsigned char* dst,
+               unsigned char const* src,
+               unsigned char* ghost_lookup,
+               unsigned char* ghost_tab,
+               unsigned char* fade_tab)
+{
+    for (int i = 0; i < length; ++i) {
+        dst[i] = fade_tab[src[i]];
+    }
+}
+
+void SF_Ghost_Fading(int length,
+                     unsigned char* dst,
+                     unsigned char const* src,
+                     unsigned char* ghost_lookup,
+                     unsigned char* ghost_tab,
+                     unsigned char* fade_tab)
+{
+    for (int i = 0; i < length; ++i) {
+        unsigned char sbyte = src[i];
+        unsigned char fbyte = ghost_lookup[sbyte];
+
+        if (fbyte != 0xFF) {
+            sbyte = ghost_tab[dst[i] + fbyte * 256];
+        }
+
+        dst[i] = fade_tab[sbyte];
+    }
+}
+
+// Jump table for SF_* functions, indexed by the ghost and fading bits of the blit style.
+static const SF_Function SpanJumpTable[4] = {SF_Copy, SF_Ghost, SF_Fading, SF_Ghost_Fading};
+
+// Draws the part of a frame from column x that is width wide, using the opaque spans of each
+// row. src is the start of the first row drawn, and first_row is its number in the frame.
+static void Span_Frame_To_Page(unsigned short const* spans,
+                               int first_row,
+                               int x,
+                               int width,
+                               int height,
+                               unsigned char* dst,
+                               unsigned char const* src,
+                               int dst_pitch,
+                               int src_pitch,
+                               SF_Function blit,
+                               unsigned char* ghost_lookup,
+                               unsigned char* ghost_tab,
+                               unsigned char* fade_tab)
+{
+    while (first_row--) {
+        spans += 1 + spans[0] * 2;
+    }
+
+    int right = x + width;
+
+    while (height--) {
+        for (int runs = *spans++; runs > 0; --runs, spans += 2) {
+            int start = spans[0];
+            int end = start + spans[1];
+
+            if (start < x) {
+                start = x;
+            }
+
+            if (end > right) {
+                end = right;
+            }
+
+            if (start < end) {
+                blit(end - start, dst + start - x, src + start, ghost_lookup, ghost_tab, fade_tab);
+            }
+        }
+
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
 // Used by Buffer_Frame_To_Page to flag which blit function to use for each line
 // Results are cached for subsequent draw calls.
 static void Setup_Shape_Header(int width,
@@ -1257,6 +1373,7 @@ void Buffer_Frame_To_Page(int x,
     unsigned char* fade_table = nullptr;
     unsigned char* ghost_table = nullptr;
     unsigned char* ghost_lookup = nullptr;
+    unsigned short const* spans = nullptr;
 
     if (!shape) {
         return;
@@ -1276,6 +1393,10 @@ void Buffer_Frame_To_Page(int x,
         }
 
         frame_data = shape_buff + (uintptr_t)draw_header->shape_data;
+
+        if (draw_header->span_data) {
+            spans = reinterpret_cast<unsigned short const*>(shape_buff + (uintptr_t)draw_header->span_data);
+        }
         // use_old_drawer = false;
     }
 
@@ -1366,6 +1487,7 @@ void Buffer_Frame_To_Page(int x,
     int yend = y + height - 1;
     int xend = x + width - 1;
     int ms_img_offset = 0;
+    int first_row = 0;
 
     // If we aren't drawing within the viewport, return.
     if (xstart >= viewport.Get_Width() || ystart >= viewport.Get_Height() || xend <= 0 || yend <= 0) {
@@ -1380,6 +1502,7 @@ void Buffer_Frame_To_Page(int x,
     }
 
     if (ystart < 0) {
+        first_row = -ystart;
         frame_data += width * (-ystart);
         ystart = 0;
         use_old_drawer = true;
@@ -1421,10 +1544,48 @@ void Buffer_Frame_To_Page(int x,
         return;
     }
 
+    if (blit_height <= 0 || blit_width <= 0) {
+        return;
+    }
+
+    // Frames kept in the shape buffers know where the opaque runs of each row are, so with
+    // transparency on only those need to be drawn. Predator still has to step over every pixel.
+    if (spans != nullptr && (blit_style & 9) == 1) {
+        unsigned char faded[256];
+
+        if (!(blit_style & 4) || fade_count == 0) {
+            blit_style &= ~4;
+        } else if (fade_count > 1) {
+            for (int i = 0; i < 256; ++i) {
+                unsigned char sbyte = i;
+
+                for (int j = 0; j < fade_count; ++j) {
+                    sbyte = fade_table[sbyte];
+                }
+
+                faded[i] = sbyte;
+            }
+            fade_table = faded;
+        }
+
+        Span_Frame_To_Page(spans,
+                           first_row,
+                           ms_img_offset,
+                           blit_width,
+                           blit_height,
+                           dst,
+                           frame_data,
+                           pitch,
+                           width,
+                           SpanJumpTable[(blit_style >> 1) & 3],
+                           ghost_lookup,
+                           ghost_table,
+                           fade_table);
+        return;
+    }
+
     // Here we just use the function that will blit the entire frame
     // using the appropriate effects.
-    if (blit_height > 0 && blit_width > 0) {
-        OldShapeJumpTable[blit_style & 0xF](
-            blit_width, blit_height, dst, src, dst_pitch, src_pitch, ghost_lookup, ghost_table, fade_table, fade_count);
-    }
+    OldShapeJumpTable[blit_style & 0xF](
+        blit_width, blit_height, dst, src, dst_pitch, src_pitch, ghost_lookup, ghost_table, fade_table, fade_count);
 }
@@ -96,13 +96,6 @@ char** KeyFrameSlots[MAX_SLOTS];
 int TotalSlotsUsed = 0;
 int TheaterSlotsUsed = THEATER_SLOT_START;
 
-typedef struct tShapeHeaderType
-{
-    unsigned draw_flags;
-    char* shape_data;
-    int shape_buffer; // 1 if shape is in theater buffer
-} ShapeHeaderType;
-
 static int Length;
 
 void* Get_Shape_Header_Data(void* ptr)
@@ -232,6 +225,80 @@ void Enable_Uncompressed_Shapes()
     UseBigShapeBuffer = OriginalUseBigShapeBuffer;
 }
 
+/*
+** Finds the runs of pixels in each row of a frame that are not colour 0, which is transparent.
+** For each row this writes the number of runs followed by the start and length of each run.
+** Returns the number of bytes written, or that would be written if spans is null.
+*/
+int Build_Shape_Spans(void const* frame, int width, int height, unsigned short* spans)
+{
+    unsigned char const* pixels = static_cast<unsigned char const*>(frame);
+    int size = 0;
+
+    for (int y = 0; y < height; ++y) {
+        unsigned short* count = spans;
+        int runs = 0;
+        int x = 0;
+
+        if (spans) {
+            ++spans;
+        }
+
+        while (x < width) {
+            while (x < width && pixels[x] == 0) {
+                ++x;
+            }
+            if (x == width) {
+                break;
+            }
+
+            int start = x;
+            while (x < width && pixels[x] != 0) {
+                ++x;
+            }
+
+            if (spans) {
+                *spans++ = start;
+                *spans++ = x - start;
+            }
+            ++runs;
+        }
+
+        if (count) {
+            *count = runs;
+        }
+        size += (1 + runs * 2) * sizeof(unsigned short);
+        pixels += width;
+    }
+
+    return size;
+}
+
+/*
+** Stores the spans of a frame that was just copied into a shape buffer, after its pixels. The
+** frame is left without spans if they don't fit. Returns the next free byte in the buffer.
+*/
+static char* Store_Shape_Spans(ShapeHeaderType* header,
+                               char* ptr,
+                               char const* buffer_start,
+                               char const* buffer_end,
+                               void const* frame,
+                               int width,
+                               int height)
+{
+    header->span_data = nullptr;
+
+    ptr = (char*)(((uintptr_t)ptr + 1) & ~1);
+    int size = Build_Shape_Spans(frame, width, height, nullptr);
+    if (buffer_end - ptr <= size) {
+        return ptr;
+    }
+
+    Build_Shape_Spans(frame, width, height, reinterpret_cast<unsigned short*>(ptr));
+    header->span_data = ptr - (uintptr_t)buffer_start;
+    return ptr + size;
+}
+
 #define FIXIT_SCORE_CRASH
 
 uintptr_t Build_Frame(void const* dataptr, unsigned short framenumber, void* buffptr)
@@ -477,7 +544,13 @@ uintptr_t Build_Frame(void const* dataptr, unsigned short framenumber, void* buf
                 temp_shape_ptr - (uintptr_t)TheaterShapeBufferStart;     // pointer to old raw shape data
             ((ShapeHeaderType*)TheaterShapeBufferPtr)->shape_buffer = 1; // Theater buffer
             *(KeyFrameSlots[keyfr.y] + framenumber) = TheaterShapeBufferPtr - (uintptr_t)TheaterShapeBufferStart;
-            TheaterShapeBufferPtr = (char*)(length + (uintptr_t)temp_shape_ptr);
+            TheaterShapeBufferPtr = Store_Shape_Spans((ShapeHeaderType*)TheaterShapeBufferPtr,
+                                                      temp_shape_ptr + length,
+                                                      TheaterShapeBufferStart,
+                                                      TheaterShapeBufferStart + TheaterShapeBufferLength,
+                                                      buffptr,
+                                                      keyfr.width,
+                                                      keyfr.height);
             /*
             ** Align the next shape
             */
@@ -512,7 +585,13 @@ uintptr_t Build_Frame(void const* dataptr, unsigned short framenumber, void* buf
                 temp_shape_ptr - (uintptr_t)BigShapeBufferStart;     // pointer to old raw shape data
             ((ShapeHeaderType*)BigShapeBufferPtr)->shape_buffer = 0; // Normal Big Shape Buffer
             *(KeyFrameSlots[keyfr.y] + framenumber) = BigShapeBufferPtr - (uintptr_t)BigShapeBufferStart;
-            BigShapeBufferPtr = (char*)(length + (uintptr_t)temp_shape_ptr);
+            BigShapeBufferPtr = Store_Shape_Spans((ShapeHeaderType*)BigShapeBufferPtr,
+                                                  temp_shape_ptr + length,
+                                                  BigShapeBufferStart,
+                                                  BigShapeBufferStart + BigShapeBufferLength,
+                                                  buffptr,
+                                                  keyfr.width,
+                                                  keyfr.height);
             // Align the next shape
             if (3 & (uintptr_t)BigShapeBufferPtr) {
                 BigShapeBufferPtr = (char*)((uintptr_t)(BigShapeBufferPtr + 3) & ~3);
@@ -13,6 +13,18 @@ typedef enum
     KF_MASK = 0xF0
 } KeyFrameType;
 
+/*
+**	Header kept in front of each frame stored in the big or theater shape buffer. The frame
+**	pixels and the opaque spans are stored as offsets from the start of that buffer.
+*/
+typedef struct tShapeHeaderType
+{
+    unsigned draw_flags;
+    char* shape_data;
+    int shape_buffer; // 1 if shape is in theater buffer
+    char* span_data;  // Opaque spans of each row (see Build_Shape_Spans), null if there are none.
+} ShapeHeaderType;
+
 extern unsigned int IsTheaterShape;
 extern unsigned int UseBigShapeBuffer;
 extern char* BigShapeBufferStart;
@@ -27,5 +39,6 @@ unsigned short Get_Build_Frame_Width(void const* dataptr);
 unsigned short Get_Build_Frame_Height(void const* dataptr);
 bool Get_Build_Frame_Palette(void const* dataptr, void* palette);
 int Get_Last_Frame_Length(void);
+int Build_Shape_Spans(void const* frame, int width, int height, unsigned short* spans);
 
 #endif // KEYFRAME_H
@@ -1,6 +1,10 @@
 #ifndef COMMON_MISCASM_H
 #define COMMON_MISCASM_H
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 int calcx(signed short param1, short distance);
 int calcy(signed short param1, short distance);
 unsigned int Cardinal_To_Fixed(unsigned base, unsigned cardinal);
@@ -14,4 +18,18 @@ int _Bound(int original, int min, int max);
 int Reverse_Long(int number);
 void strtrim(char* buffer);
 
+/*
+** Returns the number of the lowest set bit. The value must not be zero.
+*/
+inline int Lowest_Bit(unsigned value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (int)index;
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
 #endif
@@ -0,0 +1,194 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "palconv.h"
+#include "simd.h"
+#include <string.h>
+
+PaletteConvertClass::PaletteConvertClass(void)
+    : BytesPerPixel(0)
+{
+    memset(Masks, 0, sizeof(Masks));
+    memset(Colors, 0, sizeof(Colors));
+    memset(Table, 0, sizeof(Table));
+}
+
+/*
+** Sets the output format. Returns false, and converts nothing, if it isn't a 16 or 32 bit format with at most 8
+** bits for each colour.
+*/
+bool PaletteConvertClass::Set_Format(int bits, uint32_t rmask, uint32_t gmask, uint32_t bmask, uint32_t amask)
+{
+    BytesPerPixel = 0;
+    Masks[0] = rmask;
+    Masks[1] = gmask;
+    Masks[2] = bmask;
+    Masks[3] = amask;
+
+    if (bits != 16 && bits != 32) {
+        return false;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        uint32_t mask = Masks[i];
+        while (mask != 0 && (mask & 1) == 0) {
+            mask >>= 1;
+        }
+        if (mask > 0xFF) {
+            return false;
+        }
+    }
+
+    BytesPerPixel = bits / 8;
+    Build_Table();
+    return true;
+}
+
+/*
+** Sets the palette, 256 colours of red, green, blue and alpha bytes.
+*/
+void PaletteConvertClass::Set_Colors(unsigned char const* colors)
+{
+    memcpy(Colors, colors, sizeof(Colors));
+    Build_Table();
+}
+
+/*
+** Packs each colour the way SDL does, dropping the low bits of components that have fewer than 8 bits.
+*/
+void PaletteConvertClass::Build_Table(void)
+{
+    int shift[4];
+    int loss[4];
+
+    for (int i = 0; i < 4; i++) {
+        uint32_t mask = Masks[i];
+        shift[i] = 0;
+        loss[i] = 8;
+
+        if (mask != 0) {
+            while ((mask & 1) == 0) {
+                mask >>= 1;
+                shift[i]++;
+            }
+            while (mask & 1) {
+                mask >>= 1;
+                loss[i]--;
+            }
+        }
+    }
+
+    for (int color = 0; color < 256; color++) {
+        uint32_t pixel = 0;
+        for (int i = 0; i < 4; i++) {
+            pixel |= (uint32_t)(Colors[color][i] >> loss[i]) << shift[i];
+        }
+        Table[color] = pixel;
+    }
+}
+
+/*
+** The pixels are looked up one at a time as no SIMD instruction set we use has a fast 256 entry lookup, but
+** eight are looked up before any is stored and the results are stored 16 bytes at a time.
+*/
+void PaletteConvertClass::Convert_Row32(unsigned char const* src, uint32_t* dst, int width, uint32_t const* table)
+{
+    int x = 0;
+
+#ifdef SIMD_BYTES
+    for (; x + 8 <= width; x += 8) {
+        SimdType low = Simd_Make32(table[src[x]], table[src[x + 1]], table[src[x + 2]], table[src[x + 3]]);
+        SimdType high = Simd_Make32(table[src[x + 4]], table[src[x + 5]], table[src[x + 6]], table[src[x + 7]]);
+        Simd_Store(dst + x, low);
+        Simd_Store(dst + x + 4, high);
+    }
+#else
+    for (; x + 4 <= width; x += 4) {
+        uint32_t a = table[src[x]];
+        uint32_t b = table[src[x + 1]];
+        uint32_t c = table[src[x + 2]];
+        uint32_t d = table[src[x + 3]];
+        dst[x] = a;
+        dst[x + 1] = b;
+        dst[x + 2] = c;
+        dst[x + 3] = d;
+    }
+#endif
+
+    for (; x < width; x++) {
+        dst[x] = table[src[x]];
+    }
+}
+
+void PaletteConvertClass::Convert_Row16(unsigned char const* src, uint16_t* dst, int width, uint32_t const* table)
+{
+    int x = 0;
+
+    for (; x + 4 <= width; x += 4) {
+        uint16_t a = (uint16_t)table[src[x]];
+        uint16_t b = (uint16_t)table[src[x + 1]];
+        uint16_t c = (uint16_t)table[src[x + 2]];
+        uint16_t d = (uint16_t)table[src[x + 3]];
+        dst[x] = a;
+        dst[x + 1] = b;
+        dst[x + 2] = c;
+        dst[x + 3] = d;
+    }
+
+    for (; x < width; x++) {
+        dst[x] = (uint16_t)table[src[x]];
+    }
+}
+
+void PaletteConvertClass::Convert(void const* src, int src_pitch, void* dst, int dst_pitch, int width, int height) const
+{
+    unsigned char const* in = static_cast<unsigned char const*>(src);
+    unsigned char* out = static_cast<unsigned char*>(dst);
+
+    for (int y = 0; y < height; y++) {
+        if (BytesPerPixel == 4) {
+            Convert_Row32(in, reinterpret_cast<uint32_t*>(out), width, Table);
+        } else if (BytesPerPixel == 2) {
+            Convert_Row16(in, reinterpret_cast<uint16_t*>(out), width, Table);
+        }
+        in += src_pitch;
+        out += dst_pitch;
+    }
+}
+
+/*
+** As Convert, but leaves the output alone where the input is colour 0. Used to draw the mouse cursor.
+*/
+void PaletteConvertClass::Convert_Transparent(void const* src,
+                                              int src_pitch,
+                                              void* dst,
+                                              int dst_pitch,
+                                              int width,
+                                              int height) const
+{
+    unsigned char const* in = static_cast<unsigned char const*>(src);
+    unsigned char* out = static_cast<unsigned char*>(dst);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (in[x] == 0) {
+                continue;
+            }
+            if (BytesPerPixel == 4) {
+                reinterpret_cast<uint32_t*>(out)[x] = Table[in[x]];
+            } else if (BytesPerPixel == 2) {
+                reinterpret_cast<uint16_t*>(out)[x] = (uint16_t)Table[in[x]];
+            }
+        }
+        in += src_pitch;
+        out += dst_pitch;
+    }
+}
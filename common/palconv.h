@@ -0,0 +1,58 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef PALCONV_H
+#define PALCONV_H
+
+#include <stdint.h>
+
+/*
+** Expands 8 bit palettized pixels to 16 or 32 bit RGB pixels through a table of the 256 colours already in the
+** output format. The table is only rebuilt when the palette or the format changes, so converting a frame costs one
+** table lookup per pixel.
+**
+** The output format is given by its colour masks, as SDL_PixelFormatEnumToMasks returns them. Formats of other
+** sizes are not supported and must be converted some other way.
+*/
+class PaletteConvertClass
+{
+public:
+    PaletteConvertClass(void);
+
+    bool Set_Format(int bits, uint32_t rmask, uint32_t gmask, uint32_t bmask, uint32_t amask);
+    void Set_Colors(unsigned char const* colors);
+
+    bool Is_Supported(void) const
+    {
+        return BytesPerPixel != 0;
+    }
+
+    int Bytes_Per_Pixel(void) const
+    {
+        return BytesPerPixel;
+    }
+
+    void Convert(void const* src, int src_pitch, void* dst, int dst_pitch, int width, int height) const;
+    void Convert_Transparent(void const* src, int src_pitch, void* dst, int dst_pitch, int width, int height) const;
+
+private:
+    static void Convert_Row32(unsigned char const* src, uint32_t* dst, int width, uint32_t const* table);
+    static void Convert_Row16(unsigned char const* src, uint16_t* dst, int width, uint32_t const* table);
+
+    void Build_Table(void);
+
+    int BytesPerPixel;
+    uint32_t Masks[4];            // Red, green, blue and alpha.
+    unsigned char Colors[256][4]; // Palette as red, green, blue and alpha.
+    uint32_t Table[256];          // Palette in the output format.
+};
+
+#endif
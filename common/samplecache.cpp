@@ -0,0 +1,274 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "samplecache.h"
+#include "audio.h"
+#include "auduncmp.h"
+#include "crc.h"
+#include "endianness.h"
+#include "soscomp.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+** Compression types found in the .AUD header, and the header that starts each chunk of the data.
+*/
+enum
+{
+    AUD_COMPRESS_NONE = 0,
+    AUD_COMPRESS_WESTWOOD = 1,
+    AUD_COMPRESS_SOS = 99,
+    AUD_CHUNK_MAGIC = 0x0000DEAF,
+    AUD_CHUNK_HEADER = 8 // 16 bit compressed size, 16 bit decoded size, 32 bit magic number.
+};
+
+SampleCacheClass::SampleCacheClass(BusyType busy, unsigned budget)
+    : Is_Busy(busy)
+    , Hits(0)
+    , Misses(0)
+    , Bytes(0)
+    , Count(0)
+    , Budget(budget)
+    , Clock(0)
+{
+    memset(Entries, 0, sizeof(Entries));
+}
+
+SampleCacheClass::~SampleCacheClass(void)
+{
+    Clear();
+}
+
+/*
+** Returns a decoded copy of the sample, decoding it now if there isn't one already. The sample itself
+** is returned if it isn't compressed, or is too long to keep, or can't be decoded.
+*/
+void const* SampleCacheClass::Get(void const* sample)
+{
+    if (sample == NULL) {
+        return NULL;
+    }
+
+    AUDHeaderType header;
+    memcpy(&header, sample, sizeof(header));
+
+    if (header.Compression != AUD_COMPRESS_WESTWOOD && header.Compression != AUD_COMPRESS_SOS) {
+        return sample;
+    }
+
+    unsigned signature = Signature(sample);
+    int index = Find(sample);
+
+    if (index != -1) {
+        if (Entries[index].Signature == signature) {
+            Entries[index].LastUsed = ++Clock;
+            ++Hits;
+            return Entries[index].Data;
+        }
+
+        /*
+        **	The memory has been reused for a different sample since it was decoded.
+        */
+        if (Is_Busy != NULL && Is_Busy(Entries[index].Data)) {
+            return sample;
+        }
+        Discard(index);
+    }
+
+    ++Misses;
+
+    int decoded_size = (int)le32toh(header.UncompSize);
+    if (decoded_size <= 0 || decoded_size > MAX_SAMPLE_SIZE) {
+        return sample;
+    }
+
+    unsigned size = sizeof(AUDHeaderType) + decoded_size;
+    if (!Make_Room(size)) {
+        return sample;
+    }
+
+    char* data = static_cast<char*>(malloc(size));
+    if (data == NULL) {
+        return sample;
+    }
+
+    int actual = Decode(sample, data + sizeof(AUDHeaderType), decoded_size);
+    if (actual <= 0) {
+        free(data);
+        return sample;
+    }
+
+    header.Size = htole32(actual);
+    header.UncompSize = htole32(actual);
+    header.Compression = AUD_COMPRESS_NONE;
+    memcpy(data, &header, sizeof(header));
+
+    EntryType& entry = Entries[Count++];
+    entry.Sample = sample;
+    entry.Signature = signature;
+    entry.LastUsed = ++Clock;
+    entry.Size = size;
+    entry.Data = data;
+    Bytes += size;
+
+    return data;
+}
+
+/*
+** Throws away the copy of a sample, called when the sample's memory is freed.
+*/
+void SampleCacheClass::Remove(void const* sample)
+{
+    int index = Find(sample);
+
+    if (index != -1) {
+        Discard(index);
+    }
+}
+
+void SampleCacheClass::Clear(void)
+{
+    while (Count > 0) {
+        Discard(Count - 1);
+    }
+}
+
+void SampleCacheClass::Set_Budget(unsigned budget)
+{
+    Budget = budget;
+    Make_Room(0);
+}
+
+/*
+** Decodes a whole .AUD sample, the header is not copied. Returns the number of bytes written.
+*/
+int SampleCacheClass::Decode(void const* sample, void* dest, int size)
+{
+    AUDHeaderType header;
+    memcpy(&header, sample, sizeof(header));
+
+    unsigned char const* source = static_cast<unsigned char const*>(sample) + sizeof(AUDHeaderType);
+    int remaining = (int)le32toh(header.Size);
+    char* output = static_cast<char*>(dest);
+    int written = 0;
+
+    _SOS_COMPRESS_INFO sosinfo;
+    if (header.Compression == AUD_COMPRESS_SOS) {
+        sosinfo.wChannels = (header.Flags & AUD_FLAG_STEREO) + 1;
+        sosinfo.wBitSize = (header.Flags & AUD_FLAG_16BIT) ? 16 : 8;
+        sosinfo.dwCompSize = remaining;
+        sosinfo.dwUnCompSize = remaining * (sosinfo.wBitSize / 4);
+        sosCODECInitStream(&sosinfo);
+    }
+
+    while (remaining >= AUD_CHUNK_HEADER) {
+        uint16_t fsize;
+        uint16_t dsize;
+        uint32_t magic;
+
+        memcpy(&fsize, source, sizeof(fsize));
+        memcpy(&dsize, source + 2, sizeof(dsize));
+        memcpy(&magic, source + 4, sizeof(magic));
+        fsize = le16toh(fsize);
+        dsize = le16toh(dsize);
+        magic = le32toh(magic);
+
+        source += AUD_CHUNK_HEADER;
+        remaining -= AUD_CHUNK_HEADER;
+
+        if (magic != AUD_CHUNK_MAGIC || fsize > remaining || dsize > size - written) {
+            break;
+        }
+
+        if (fsize == dsize) {
+            memcpy(output, source, dsize);
+        } else if (header.Compression == AUD_COMPRESS_WESTWOOD) {
+            Audio_Unzap((void*)source, output, dsize);
+        } else {
+            sosinfo.lpSource = (char*)source;
+            sosinfo.lpDest = output;
+            sosCODECDecompressData(&sosinfo, dsize);
+        }
+
+        source += fsize;
+        remaining -= fsize;
+        output += dsize;
+        written += dsize;
+    }
+
+    return written;
+}
+
+/*
+** Check value for a sample, made from its header and the data at each end.
+*/
+unsigned SampleCacheClass::Signature(void const* sample)
+{
+    AUDHeaderType header;
+    memcpy(&header, sample, sizeof(header));
+
+    unsigned char const* data = static_cast<unsigned char const*>(sample) + sizeof(AUDHeaderType);
+    unsigned size = le32toh(header.Size);
+    unsigned ends = size < SIGNATURE_BYTES ? size : SIGNATURE_BYTES;
+
+    unsigned signature = Calculate_CRC(&header, sizeof(header));
+    signature ^= Calculate_CRC(data, ends) * 3;
+    signature ^= Calculate_CRC(data + size - ends, ends) * 7;
+    return signature;
+}
+
+int SampleCacheClass::Find(void const* sample) const
+{
+    for (int index = 0; index < Count; ++index) {
+        if (Entries[index].Sample == sample) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+/*
+** Throws away the copies used longest ago until there is room for one more of the size given.
+** Returns false if there isn't enough that can be thrown away.
+*/
+bool SampleCacheClass::Make_Room(unsigned size)
+{
+    if (size > Budget) {
+        return false;
+    }
+
+    while (Count > 0 && (Bytes + size > Budget || Count == MAX_ENTRIES)) {
+        int oldest = -1;
+
+        for (int index = 0; index < Count; ++index) {
+            if (Is_Busy != NULL && Is_Busy(Entries[index].Data)) {
+                continue;
+            }
+            if (oldest == -1 || Entries[index].LastUsed < Entries[oldest].LastUsed) {
+                oldest = index;
+            }
+        }
+
+        if (oldest == -1) {
+            return false;
+        }
+        Discard(oldest);
+    }
+
+    return true;
+}
+
+void SampleCacheClass::Discard(int index)
+{
+    Bytes -= Entries[index].Size;
+    free(Entries[index].Data);
+    Entries[index] = Entries[--Count];
+}
@@ -0,0 +1,90 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef SAMPLECACHE_H
+#define SAMPLECACHE_H
+
+#include <stddef.h>
+
+/*
+** Keeps decoded copies of compressed .AUD samples, so a sound effect that plays over and over is
+** only decoded the first time. Each copy is itself an uncompressed .AUD sample that can be played
+** in place of the original.
+**
+** Copies are found by the address of the original sample. Sample memory is often reused, so the
+** header and the start and end of the compressed data are also checked before a copy is used.
+** When the cache is full the copy that was used longest ago is thrown away, unless the busy hook
+** says it is still being played.
+*/
+class SampleCacheClass
+{
+public:
+    enum
+    {
+        MAX_ENTRIES = 64,                 // Most samples kept at once.
+        MAX_SAMPLE_SIZE = 1024 * 1024,    // Longer samples are decoded as they play instead.
+        DEFAULT_BUDGET = 8 * 1024 * 1024, // Bytes of decoded samples kept.
+        SIGNATURE_BYTES = 256             // Bytes at each end of the compressed data checked.
+    };
+
+    typedef bool (*BusyType)(void const* data);
+
+    SampleCacheClass(BusyType busy = NULL, unsigned budget = DEFAULT_BUDGET);
+    ~SampleCacheClass(void);
+
+    void const* Get(void const* sample);
+    void Remove(void const* sample);
+    void Clear(void);
+    void Set_Budget(unsigned budget);
+
+    static int Decode(void const* sample, void* dest, int size);
+
+    /*
+    **	Called before a copy is thrown away, returns true if it is still in use. May be NULL.
+    */
+    BusyType Is_Busy;
+
+    /*
+    **	Statistics for tuning.
+    */
+    unsigned Hits;
+    unsigned Misses;
+    unsigned Bytes; // Size of all the copies held.
+
+private:
+    struct EntryType
+    {
+        void const* Sample; // Original compressed sample.
+        unsigned Signature; // Check value of the original when it was decoded.
+        unsigned LastUsed;  // Value of Clock when the copy was last asked for.
+        unsigned Size;      // Size of the copy, header included.
+        void* Data;         // Decoded copy.
+    };
+
+    static unsigned Signature(void const* sample);
+
+    int Find(void const* sample) const;
+    bool Make_Room(unsigned size);
+    void Discard(int index);
+
+    EntryType Entries[MAX_ENTRIES];
+    int Count;
+    unsigned Budget;
+    unsigned Clock;
+
+    // The assignment operator is not supported.
+    SampleCacheClass& operator=(SampleCacheClass const&) = delete;
+
+    // The copy constructor is not supported.
+    SampleCacheClass(SampleCacheClass const&) = delete;
+};
+
+#endif
@@ -0,0 +1,63 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "savepipe.h"
+#include <stdio.h>
+
+/*
+** Data goes through the compressor, then the encryptor, then the digest on its way out.
+*/
+SavePipe::SavePipe(void const* key, int length, int blocksize)
+    : Blow(BlowPipe::ENCRYPT)
+    , LCW(LCWPipe::COMPRESS, blocksize)
+{
+    Blow.Key(key, length);
+    Blow.Put_To(SHA);
+    LCW.Put_To(Blow);
+}
+
+int SavePipe::Put(void const* source, int slen)
+{
+    return (LCW.Put(source, slen));
+}
+
+int SavePipe::Flush(void)
+{
+    return (LCW.Flush());
+}
+
+int SavePipe::End(void)
+{
+    return (LCW.End());
+}
+
+/*
+** The chain inside ends at the digest, so only that is linked to the pipe the body goes to.
+*/
+void SavePipe::Put_To(Pipe* pipe)
+{
+    SHA.Put_To(pipe);
+}
+
+/*
+** Sends any data still held in the chain out, then writes the message digest of the body as it is
+** in the file at 'digest_pos'. The file must be the one 'out' writes to, and it is left positioned
+** after the digest.
+*/
+void SavePipe::Put_Digest(FileClass& file, Pipe& out, int digest_pos)
+{
+    char digest[20];
+
+    Flush();
+    file.Seek(digest_pos, SEEK_SET);
+    SHA.Result(digest);
+    out.Put(digest, sizeof(digest));
+}
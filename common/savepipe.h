@@ -0,0 +1,53 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef SAVEPIPE_H
+#define SAVEPIPE_H
+
+#include "blowpipe.h"
+#include "lcwpipe.h"
+#include "shapipe.h"
+#include "wwfile.h"
+
+/*
+** The body of a save game file: compresses and encrypts the data that flows through it, and keeps
+** the message digest of the data as it goes out. The game data can be put straight through it, or
+** stored in a SnapshotPipe first and sent through later, and both give the same bytes.
+**
+** The file header is written before the body with space left for the digest, and Put_Digest fills
+** that in once all the data has been put.
+*/
+class SavePipe : public Pipe
+{
+public:
+    SavePipe(void const* key, int length, int blocksize);
+
+    virtual int Put(void const* source, int slen);
+    virtual int Flush(void);
+    virtual int End(void);
+    virtual void Put_To(Pipe* pipe);
+    void Put_To(Pipe& pipe)
+    {
+        Put_To(&pipe);
+    }
+
+    void Put_Digest(FileClass& file, Pipe& out, int digest_pos);
+
+private:
+    SHAPipe SHA;
+    BlowPipe Blow;
+    LCWPipe LCW;
+
+    SavePipe(SavePipe& rvalue) = delete;
+    SavePipe& operator=(SavePipe const& pipe) = delete;
+};
+
+#endif
@@ -0,0 +1,103 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef SIMD_H
+#define SIMD_H
+
+/*
+** A few 16 byte vector operations on top of SSE2 or NEON, for the inner loops of the software
+** blitters. SIMD_BYTES is only defined when one of them is available; code using these must
+** also have a plain loop for when it isn't.
+*/
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+#define SIMD_BYTES 16
+
+typedef __m128i SimdType;
+
+inline SimdType Simd_Load(void const* src)
+{
+    return _mm_loadu_si128(static_cast<__m128i const*>(src));
+}
+
+inline void Simd_Store(void* dst, SimdType value)
+{
+    _mm_storeu_si128(static_cast<__m128i*>(dst), value);
+}
+
+/*
+** Takes the bytes of src that are not zero and the bytes of dst where src is zero.
+*/
+inline SimdType Simd_Select_Nonzero(SimdType src, SimdType dst)
+{
+    __m128i zero = _mm_cmpeq_epi8(src, _mm_setzero_si128());
+    return _mm_or_si128(_mm_and_si128(zero, dst), src);
+}
+
+/*
+** Are all the bytes zero?
+*/
+inline bool Simd_Is_Zero(SimdType value)
+{
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0xFFFF;
+}
+
+/*
+** Makes a vector of four 32 bit values, the first one at the lowest address.
+*/
+inline SimdType Simd_Make32(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+    __m128i low = _mm_unpacklo_epi32(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b));
+    __m128i high = _mm_unpacklo_epi32(_mm_cvtsi32_si128(c), _mm_cvtsi32_si128(d));
+    return _mm_unpacklo_epi64(low, high);
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+
+#define SIMD_BYTES 16
+
+typedef uint8x16_t SimdType;
+
+inline SimdType Simd_Load(void const* src)
+{
+    return vld1q_u8(static_cast<uint8_t const*>(src));
+}
+
+inline void Simd_Store(void* dst, SimdType value)
+{
+    vst1q_u8(static_cast<uint8_t*>(dst), value);
+}
+
+inline SimdType Simd_Select_Nonzero(SimdType src, SimdType dst)
+{
+    return vbslq_u8(vceqq_u8(src, vdupq_n_u8(0)), dst, src);
+}
+
+inline bool Simd_Is_Zero(SimdType value)
+{
+    uint64x2_t halves = vreinterpretq_u64_u8(value);
+    return (vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1)) == 0;
+}
+
+inline SimdType Simd_Make32(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+    uint32x2_t low = vcreate_u32(a | (uint64_t)b << 32);
+    uint32x2_t high = vcreate_u32(c | (uint64_t)d << 32);
+    return vreinterpretq_u8_u32(vcombine_u32(low, high));
+}
+
+#endif
+
+#endif
@@ -45,6 +45,11 @@ void sosCODECInitStream(_SOS_COMPRESS_INFO* stream)
  */
 #define NUM_NYBBLES 16
 
+/* Number of possible code bytes.  Each byte holds two nybbles, the low one
+ * is decoded first.
+ */
+#define NUM_CODES 256
+
 /* Define a dynamic programming table mapping all possible indexes and nybbles
  * into their next value.  Pack things together into a struct so a cache miss
  * will retrieve both next index and diff value.
@@ -58,8 +63,15 @@ static struct
     short index;
 } SosDecompTable[NUM_INDEXES][NUM_NYBBLES];
 
-/* Flag if above table was initialized.  */
-static bool SosDecompTableGenerated = false;
+/* Index after both nybbles of a code byte have been decoded.  The decoder
+ * is limited by the chain of table reads that carries the index from one
+ * byte to the next, and this table makes that one read per byte rather than
+ * two.  The differences are still looked up a nybble at a time, but those
+ * reads are off the chain and can overlap with it.
+ *
+ * This table should consume ~22kb.
+ */
+static unsigned char SosByteIndexTable[NUM_INDEXES][NUM_CODES];
 
 /* Generate decompression table for samples.  Precompute every possible value
  * of dwDifference and Channels[0].wIndex based on every possible  combination
@@ -97,6 +109,35 @@ void sosCODECGenerateDecompressTable(void)
             SosDecompTable[index][nybble].index = next_index;
         }
     }
+
+    for (index = 0; index < NUM_INDEXES; index++) {
+        for (short code = 0; code < NUM_CODES; code++) {
+            short middle_index = SosDecompTable[index][code & 0xF].index;
+            SosByteIndexTable[index][code] = (unsigned char)SosDecompTable[middle_index][code >> 4].index;
+        }
+    }
+}
+
+/* Adds a difference to a sample and keeps it in range.  Written as two
+ * separate limits so the compiler uses conditional moves rather than
+ * branches that depend on the data.  */
+static inline int sosCODECStep(int sample, int diff)
+{
+    sample += diff;
+    sample = sample < -32768 ? -32768 : sample;
+    sample = sample > 32767 ? 32767 : sample;
+    return sample;
+}
+
+template <bool BITS_8> static inline void sosCODECStore(short*& dst, int sample, int stride)
+{
+    if (BITS_8) {
+        *dst = ((sample & 0xFF00) >> 8) ^ 0x80;
+        dst = (short*)((char*)(dst) + stride);
+    } else {
+        *dst = sample;
+        dst += stride;
+    }
 }
 
 /* Template version of sosCODECDecompressData which generates a single version
@@ -112,65 +153,71 @@ template <bool BITS_8> static unsigned sosCODECDecompressDataTemplate(_SOS_COMPR
         return full_length;
     }
 
-    int channel = 0;
-    int num_channels = stream->wChannels;
-
     unsigned char* src = (unsigned char*)stream->lpSource;
     short* dst = (short*)(stream->lpDest);
-    do {
-        short index = stream->Channels[channel].wIndex;
-        int sample = stream->Channels[channel].dwPredicted;
 
-        int j = 0;
-        do {
-            unsigned char codebuf = *src;
-            src += num_channels;
+    if (stream->wChannels == 2) {
+        /* The two channels are interleaved byte by byte.  Decode both in the
+           same loop, their chains don't depend on each other so the processor
+           can work on them at the same time.  */
+        short* dst_right = BITS_8 ? (short*)(stream->lpDest + 1) : (short*)(stream->lpDest) + 1;
+        int left_index = stream->Channels[0].wIndex;
+        int left = stream->Channels[0].dwPredicted;
+        int right_index = stream->Channels[1].wIndex;
+        int right = stream->Channels[1].dwPredicted;
+
+        for (unsigned j = 0; j < bytes; ++j) {
+            unsigned char left_code = src[0];
+            unsigned char right_code = src[1];
+            src += 2;
+
+            const auto& left_low = SosDecompTable[left_index][left_code & 0xF];
+            const auto& right_low = SosDecompTable[right_index][right_code & 0xF];
+            const auto& left_high = SosDecompTable[left_low.index][left_code >> 4];
+            const auto& right_high = SosDecompTable[right_low.index][right_code >> 4];
+
+            left = sosCODECStep(left, left_low.diff);
+            right = sosCODECStep(right, right_low.diff);
+            sosCODECStore<BITS_8>(dst, left, 2);
+            sosCODECStore<BITS_8>(dst_right, right, 2);
+
+            left = sosCODECStep(left, left_high.diff);
+            right = sosCODECStep(right, right_high.diff);
+            sosCODECStore<BITS_8>(dst, left, 2);
+            sosCODECStore<BITS_8>(dst_right, right, 2);
+
+            left_index = SosByteIndexTable[left_index][left_code];
+            right_index = SosByteIndexTable[right_index][right_code];
+        }
 
-            /* First step: case dwSampleIndex is even (unrolled).  */
-            char current_nybble = codebuf & 0xF;
+        /* Write back the important stuff from the loop back to the struct.  */
+        stream->Channels[0].dwPredicted = left;
+        stream->Channels[0].wIndex = left_index;
+        stream->Channels[1].dwPredicted = right;
+        stream->Channels[1].wIndex = right_index;
+    } else {
+        int index = stream->Channels[0].wIndex;
+        int sample = stream->Channels[0].dwPredicted;
 
-            sample += SosDecompTable[index][current_nybble].diff;
-            sample = clamp(sample, -32768, 32767);
+        for (unsigned j = 0; j < bytes; ++j) {
+            unsigned char code = *src++;
 
-            if (BITS_8) {
-                *dst = ((sample & 0xFF00) >> 8) ^ 0x80;
-                dst = (short*)((char*)(dst) + num_channels);
-            } else {
-                *dst = sample;
-                dst += num_channels;
-            }
+            const auto& low = SosDecompTable[index][code & 0xF];
+            const auto& high = SosDecompTable[low.index][code >> 4];
 
-            index = SosDecompTable[index][current_nybble].index;
+            sample = sosCODECStep(sample, low.diff);
+            sosCODECStore<BITS_8>(dst, sample, 1);
 
-            /* Second step: case dwSampleIndex is odd (unrolled).  */
-            current_nybble = codebuf >> 4;
-            sample += SosDecompTable[index][current_nybble].diff;
-            sample = clamp(sample, -32768, 32767);
+            sample = sosCODECStep(sample, high.diff);
+            sosCODECStore<BITS_8>(dst, sample, 1);
 
-            if (BITS_8) {
-                *dst = ((sample & 0xFF00) >> 8) ^ 0x80;
-                dst = (short*)((char*)(dst) + num_channels);
-            } else {
-                *dst = sample;
-                dst += num_channels;
-            }
-
-            index = SosDecompTable[index][current_nybble].index;
-        } while (++j < bytes);
+            index = SosByteIndexTable[index][code];
+        }
 
         /* Write back the important stuff from the loop back to the struct.  */
-        stream->Channels[channel].dwPredicted = sample;
-        stream->Channels[channel].wIndex = index;
-
-        /* In case of stereo we also need to update the src and dst pointers
-         before proceeding to the next iteration..  */
-        src = (unsigned char*)stream->lpSource + 1;
-        if (BITS_8) {
-            dst = (short*)(stream->lpDest + 1);
-        } else {
-            dst = (short*)(stream->lpDest) + 1;
-        }
-    } while (++channel < num_channels);
+        stream->Channels[0].dwPredicted = sample;
+        stream->Channels[0].wIndex = index;
+    }
 
     return full_length;
 }
@@ -182,10 +229,11 @@ template <bool BITS_8> static unsigned sosCODECDecompressDataTemplate(_SOS_COMPR
 //
 unsigned sosCODECDecompressData(_SOS_COMPRESS_INFO* stream, unsigned bytes)
 {
-    if (SosDecompTableGenerated == false) {
-        sosCODECGenerateDecompressTable();
-        SosDecompTableGenerated = true;
-    }
+    /* Generate the tables on first use.  Samples can be decoded by the audio
+       thread as well as the game, and a local static is only ever initialized
+       once however many threads get here.  */
+    static bool table_generated = (sosCODECGenerateDecompressTable(), true);
+    (void)table_generated;
 
     if (stream->wBitSize == 16) {
         return sosCODECDecompressDataTemplate<false>(stream, bytes);
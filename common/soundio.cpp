@@ -1009,6 +1009,14 @@ int Play_Sample(void const* sample, int priority, int volume, signed short panlo
     return Play_Sample_Handle(sample, priority, volume, panloc, Get_Free_Sample_Handle(priority));
 }
 
+/*
+**	DirectSound decodes straight into the secondary buffers as the sample plays, so there is nothing
+**	to do ahead of time.
+*/
+void Preload_Sample(void const* sample)
+{
+}
+
 static bool Attempt_Audio_Restore(LPDIRECTSOUNDBUFFER sound_buffer)
 {
     HRESULT return_code = 0;
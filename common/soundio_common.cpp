@@ -14,11 +14,17 @@
 #include "endianness.h"
 #include "file.h"
 #include "memflag.h"
+#include "samplecache.h"
 #include "soscomp.h"
 #include "sound.h"
 #include "soundio_imp.h"
+#include "spscqueue.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <stdlib.h>
+#include <thread>
 
 enum
 {
@@ -37,6 +43,23 @@ enum
     TIMER_TARGET_RESOLUTION = 10, // 10-millisecond target resolution
     INVALID_AUDIO_HANDLE = -1,
     INVALID_FILE_HANDLE = -1,
+    AUDIO_COMMAND_COUNT = 64, // Commands the game can post before the audio thread picks them up.
+    AUDIO_SERVICE_DELAY = 5,  // Milliseconds the audio thread sleeps between servicing the trackers.
+};
+
+/*
+**	Requests from the game that don't need an answer. These are posted to the audio thread rather
+**	than waiting for it to finish servicing the trackers.
+*/
+struct AudioCommandType
+{
+    enum
+    {
+        AUDIO_STOP,
+        AUDIO_FADE
+    } Command;
+    int Handle;
+    int Value;
 };
 
 /*
@@ -143,6 +166,7 @@ struct SampleTrackerType
     */
     int FileHandle; // Streaming file handle (INVALID_FILE_HANDLE = not in use).
     void* FileBuffer;
+    bool Reading; // The audio thread is reading from FileHandle without holding AudioLock.
 
     /*
     ** The following structure is used if the sample if compressed using
@@ -176,6 +200,12 @@ struct SampleTrackerType
     */
     int Remainder;
 
+    /*
+    **	Decoded copy of the sample being played, from the sample cache. It must not be thrown
+    **	away while the sample is still playing.
+    */
+    void const* Cached;
+
     struct SampleTrackerTypeImp* Imp;
 };
 
@@ -205,9 +235,32 @@ static bool volatile AudioDone = false;
 extern bool GameInFocus;
 static uint8_t ChunkBuffer[BUFFER_CHUNK_SIZE];
 
+/*
+**	The sample trackers are serviced by the audio thread, so that decoding and streaming from disk
+**	carry on while the game is busy with a long frame. Anything that reads or changes the trackers
+**	holds AudioLock. The command queue is filled by the game thread and emptied by whichever thread
+**	holds the lock, which is always done before the trackers are looked at.
+*/
+static std::recursive_mutex AudioLock;
+static SPSCQueueClass<AudioCommandType, AUDIO_COMMAND_COUNT> AudioCommands;
+static std::thread AudioThread;
+static std::atomic<bool> AudioThreadQuit(false);
+static bool AudioThreadRunning = false;
+static std::chrono::steady_clock::time_point LastFadeTime;
+
 bool Any_Locked(); // From each games winstub.cpp at the moment.
 static int Get_Free_Sample_Handle(int priority);
 static void Maintenance_Callback();
+static void Service_Trackers();
+static void Process_Audio_Commands();
+static void Stop_Sample_Now(int index);
+static bool Sample_Status_Now(int index);
+static bool Sample_Cache_Busy(void const* data);
+
+/*
+**	Effects are decoded once and then played from the copy held here.
+*/
+static SampleCacheClass SampleCache(Sample_Cache_Busy);
 static int Play_Sample_Handle(const void* sample, int priority, int volume, signed short panloc, int id);
 static int Sample_Read(int fh, void* buffer, int size);
 
@@ -352,6 +405,11 @@ static int Sample_Copy(SampleTrackerType* st,
     return datasize;
 }
 
+static bool On_Audio_Thread()
+{
+    return AudioThreadRunning && std::this_thread::get_id() == AudioThread.get_id();
+}
+
 static int
 Stream_Sample_Vol(void* buffer, int size, bool (*callback)(short, short*, void**, int*), int volume, int handle)
 {
@@ -359,6 +417,14 @@ Stream_Sample_Vol(void* buffer, int size, bool (*callback)(short, short*, void**
         return INVALID_AUDIO_HANDLE;
     }
 
+    /*
+    **	The lock counts belong to the game thread, so on the audio thread they were checked when the
+    **	stream was asked for instead.
+    */
+    if (!On_Audio_Thread() && Any_Locked()) {
+        return INVALID_AUDIO_HANDLE;
+    }
+
     AUDHeaderType header;
     memcpy(&header, buffer, sizeof(header));
     int oldsize = header.Size;
@@ -379,6 +445,50 @@ Stream_Sample_Vol(void* buffer, int size, bool (*callback)(short, short*, void**
     return playid;
 }
 
+/*
+**	Closes the file a tracker streams from. If the audio thread is in the middle of reading from
+**	it, the tracker just lets go of the handle and the read closes the file when it is done.
+*/
+static void Close_Stream_File(SampleTrackerType* st)
+{
+    if (st->FileHandle != INVALID_FILE_HANDLE) {
+        if (!st->Reading) {
+            Close_File(st->FileHandle);
+        }
+        st->FileHandle = INVALID_FILE_HANDLE;
+    }
+}
+
+/*
+**	Reads the next part of a streamed file. The audio thread only holds AudioLock once, in
+**	Audio_Thread_Loop, and lets go of it for the read, so that the game thread doesn't wait on the
+**	disk when it starts or stops a sample. The tracker may be stopped or given to another sample
+**	meanwhile, in which case the file is closed and -1 is returned; the caller must then leave the
+**	tracker alone.
+*/
+static int Stream_Read(SampleTrackerType* st, void* buffer, int size)
+{
+    if (!On_Audio_Thread()) {
+        return Read_File(st->FileHandle, buffer, size);
+    }
+
+    int fh = st->FileHandle;
+    st->Reading = true;
+    AudioLock.unlock();
+
+    int psize = Read_File(fh, buffer, size);
+
+    AudioLock.lock();
+    st->Reading = false;
+
+    if (st->FileHandle != fh) {
+        Close_File(fh);
+        return -1;
+    }
+
+    return psize;
+}
+
 static bool File_Callback(short id, short* odd, void** buffer, int* size)
 {
     if (id == INVALID_AUDIO_HANDLE) {
@@ -414,11 +524,14 @@ static bool File_Callback(short id, short* odd, void** buffer, int* size)
                     static_cast<char*>(st->FileBuffer)
                     + LockedData.StreamBufferSize * ((st->FilePending + *odd) % LockedData.StreamBufferCount);
 
-                int psize = Read_File(st->FileHandle, tofill, LockedData.StreamBufferSize);
+                int psize = Stream_Read(st, tofill, LockedData.StreamBufferSize);
+
+                if (psize < 0) {
+                    return false;
+                }
 
                 if (psize != LockedData.StreamBufferSize) {
-                    Close_File(st->FileHandle);
-                    st->FileHandle = INVALID_FILE_HANDLE;
+                    Close_Stream_File(st);
                 }
 
                 if (psize > 0) {
@@ -456,9 +569,12 @@ static void File_Stream_Preload(int index)
     int i = 0;
 
     for (i = st->FilePending; i < num; ++i) {
-        int size = Read_File(st->FileHandle,
-                             static_cast<char*>(st->FileBuffer) + i * LockedData.StreamBufferSize,
-                             LockedData.StreamBufferSize);
+        int size = Stream_Read(
+            st, static_cast<char*>(st->FileBuffer) + i * LockedData.StreamBufferSize, LockedData.StreamBufferSize);
+
+        if (size < 0) {
+            return;
+        }
 
         if (size > 0) {
             st->FilePendingSize = size;
@@ -493,14 +609,13 @@ static void File_Stream_Preload(int index)
             st->QueueSize = 0;
             st->FilePendingSize = 0;
             st->Callback = nullptr;
-            Close_File(st->FileHandle);
+            Close_Stream_File(st);
         } else {
             st->Odd = 2;
             --st->FilePending;
 
             if (st->FilePendingSize != LockedData.StreamBufferSize) {
-                Close_File(st->FileHandle);
-                st->FileHandle = INVALID_FILE_HANDLE;
+                Close_Stream_File(st);
             }
 
             st->QueueBuffer = static_cast<char*>(st->FileBuffer) + LockedData.StreamBufferSize;
@@ -515,6 +630,16 @@ int File_Stream_Sample_Vol(char const* filename, int volume, bool real_time_star
         return INVALID_AUDIO_HANDLE;
     }
 
+    /*
+    **	The audio thread starts the stream later on and can't look at the lock counts itself.
+    */
+    if (AudioThreadRunning && Any_Locked()) {
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+    Process_Audio_Commands();
+
     if (FileStreamBuffer == nullptr) {
         FileStreamBuffer = malloc((unsigned int)(LockedData.StreamBufferSize * LockedData.StreamBufferCount));
 
@@ -540,10 +665,17 @@ int File_Stream_Sample_Vol(char const* filename, int volume, bool real_time_star
         st->IsScore = true;
         st->FilePending = 0;
         st->FilePendingSize = 0;
-        st->Loading = real_time_start;
         st->Volume = volume;
         st->FileHandle = fh;
-        File_Stream_Preload(handle);
+
+        /*
+        **	The audio thread does the reading ahead, so the game doesn't have to wait for the disk
+        **	even when it didn't ask for a real time start.
+        */
+        st->Loading = real_time_start || AudioThreadRunning;
+        if (!AudioThreadRunning) {
+            File_Stream_Preload(handle);
+        }
         return handle;
     }
 
@@ -551,6 +683,77 @@ int File_Stream_Sample_Vol(char const* filename, int volume, bool real_time_star
 }
 
 void Sound_Callback()
+{
+    /*
+    **	The audio thread services the trackers on its own when it is running.
+    */
+    if (AudioThreadRunning) {
+        return;
+    }
+
+    Process_Audio_Commands();
+    Service_Trackers();
+}
+
+static void Do_Audio_Command(AudioCommandType const& command)
+{
+    switch (command.Command) {
+    case AudioCommandType::AUDIO_STOP:
+        Stop_Sample_Now(command.Handle);
+        break;
+
+    case AudioCommandType::AUDIO_FADE:
+        if (Sample_Status_Now(command.Handle)) {
+            SampleTrackerType* st = &LockedData.SampleTracker[command.Handle];
+
+            if (command.Value > 0 && !st->Loading) {
+                st->Reducer = ((st->Volume / command.Value) + 1);
+            } else {
+                Stop_Sample_Now(command.Handle);
+            }
+        }
+        break;
+    }
+}
+
+static void Process_Audio_Commands()
+{
+    AudioCommandType command;
+
+    while (AudioCommands.Get(command)) {
+        Do_Audio_Command(command);
+    }
+}
+
+/*
+**	Passes a command to the audio thread. If the thread isn't running, or has fallen so far behind
+**	that the queue is full, the command is carried out straight away instead.
+*/
+static void Post_Audio_Command(AudioCommandType const& command)
+{
+    if (AudioThreadRunning && AudioCommands.Put(command)) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+    Process_Audio_Commands();
+    Do_Audio_Command(command);
+}
+
+static void Audio_Thread_Loop()
+{
+    while (!AudioThreadQuit.load()) {
+        {
+            std::lock_guard<std::recursive_mutex> lock(AudioLock);
+            Process_Audio_Commands();
+            Service_Trackers();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_SERVICE_DELAY));
+    }
+}
+
+static void Service_Trackers()
 {
     if (!AudioDone && LockedData.DigiHandle != INVALID_AUDIO_HANDLE) {
         Maintenance_Callback();
@@ -568,10 +771,7 @@ void Sound_Callback()
             // Is this sample inactive?
             if (!st->Active) {
                 // If so, we close the handle.
-                if (st->FileHandle != INVALID_FILE_HANDLE) {
-                    Close_File(st->FileHandle);
-                    st->FileHandle = INVALID_FILE_HANDLE;
-                }
+                Close_Stream_File(st);
                 // We are done with this sample.
                 continue;
             }
@@ -579,7 +779,7 @@ void Sound_Callback()
             // Has it been faded Is the volume 0?
             if (st->Reducer && !st->Volume) {
                 // If so stop it.
-                Stop_Sample(i);
+                Stop_Sample_Now(i);
 
                 // We are done with this sample.
                 continue;
@@ -644,7 +844,7 @@ static void Maintenance_Callback()
                 } else {
                     if (!SoundImp_Sample_Status(st->Imp)) {
                         st->Service = 0;
-                        Stop_Sample(i);
+                        Stop_Sample_Now(i);
                     }
                 }
             }
@@ -666,7 +866,16 @@ static void Maintenance_Callback()
         ++st;
     }
 
-    // Perform any volume modifications that need to be made.
+    // Perform any volume modifications that need to be made. Fades are in game ticks, so this is
+    // only done once a tick however often the trackers are serviced.
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (now - LastFadeTime < std::chrono::milliseconds(1000 / 60)) {
+        return;
+    }
+
+    LastFadeTime = now;
+
     if (LockedData.VolumeLock == 0) {
         ++LockedData.VolumeLock;
         st = LockedData.SampleTracker;
@@ -699,6 +908,11 @@ void* Load_Sample(char const* filename)
         return nullptr;
     }
 
+    /*
+    **	The file handles are shared with the streams the audio thread is reading.
+    */
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+
     void* data = nullptr;
     int handle = Open_File(filename, 1);
 
@@ -737,6 +951,8 @@ static int Sample_Read(int fh, void* buffer, int size)
 void Free_Sample(const void* sample)
 {
     if (sample != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(AudioLock);
+        SampleCache.Remove(sample);
         free((void*)sample);
     }
 }
@@ -765,6 +981,7 @@ bool Audio_Init(int bits_per_sample, bool stereo, int rate, bool reverse_channel
         st->BitsPerSample = bits_per_sample;
         st->Stereo = stereo;
         st->Frequency = rate;
+        st->FileHandle = INVALID_FILE_HANDLE;
 
         if (!(st->Imp = SoundImp_Init_Sample(bits_per_sample, stereo, rate))) {
             return false;
@@ -775,6 +992,12 @@ bool Audio_Init(int bits_per_sample, bool stereo, int rate, bool reverse_channel
     SampleType = SAMPLE_SB;
     AudioDone = false;
 
+    if (!AudioThreadRunning) {
+        AudioThreadQuit = false;
+        AudioThread = std::thread(Audio_Thread_Loop);
+        AudioThreadRunning = true;
+    }
+
     return true;
 }
 
@@ -784,8 +1007,16 @@ void Sound_End()
         return;
     }
 
+    if (AudioThreadRunning) {
+        AudioThreadQuit = true;
+        AudioThread.join();
+        AudioThreadRunning = false;
+    }
+
+    Process_Audio_Commands();
+
     for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
-        Stop_Sample(i);
+        Stop_Sample_Now(i);
         SoundImp_Shutdown_Sample(LockedData.SampleTracker[i].Imp);
     }
 
@@ -801,12 +1032,23 @@ void Sound_End()
         LockedData.UncompBuffer = nullptr;
     }
 
+    SampleCache.Clear();
+
     AudioDone = true;
 }
 
 void Stop_Sample(int index)
 {
-    if (LockedData.DigiHandle != INVALID_AUDIO_HANDLE && index < MAX_SAMPLE_TRACKERS && !AudioDone) {
+    AudioCommandType command;
+    command.Command = AudioCommandType::AUDIO_STOP;
+    command.Handle = index;
+    command.Value = 0;
+    Post_Audio_Command(command);
+}
+
+static void Stop_Sample_Now(int index)
+{
+    if (LockedData.DigiHandle != INVALID_AUDIO_HANDLE && index >= 0 && index < MAX_SAMPLE_TRACKERS && !AudioDone) {
         SampleTrackerType* st = &LockedData.SampleTracker[index];
 
         if (st->Active || st->Loading) {
@@ -823,11 +1065,7 @@ void Stop_Sample(int index)
             }
 
             st->Loading = false;
-
-            if (st->FileHandle != INVALID_FILE_HANDLE) {
-                Close_File(st->FileHandle);
-                st->FileHandle = INVALID_FILE_HANDLE;
-            }
+            Close_Stream_File(st);
 
             st->QueueBuffer = nullptr;
         }
@@ -835,6 +1073,14 @@ void Stop_Sample(int index)
 }
 
 bool Sample_Status(int index)
+{
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+    Process_Audio_Commands();
+
+    return Sample_Status_Now(index);
+}
+
+static bool Sample_Status_Now(int index)
 {
     if (index < 0) {
         return false;
@@ -867,8 +1113,11 @@ bool Is_Sample_Playing(const void* sample)
         return false;
     }
 
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+    Process_Audio_Commands();
+
     for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
-        if (sample == LockedData.SampleTracker[i].Original && Sample_Status(i)) {
+        if (sample == LockedData.SampleTracker[i].Original && Sample_Status_Now(i)) {
             return true;
         }
     }
@@ -879,17 +1128,51 @@ bool Is_Sample_Playing(const void* sample)
 void Stop_Sample_Playing(const void* sample)
 {
     if (sample != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(AudioLock);
+        Process_Audio_Commands();
+
         for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
             if (LockedData.SampleTracker[i].Original == sample) {
-                Stop_Sample(i);
+                Stop_Sample_Now(i);
                 break;
             }
         }
     }
 }
 
+/*
+**	Decodes a sample ahead of time, so that it costs no more than a copy the first time it is played.
+*/
+void Preload_Sample(const void* sample)
+{
+    if (AudioDone || sample == nullptr || LockedData.DigiHandle == INVALID_AUDIO_HANDLE) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+    SampleCache.Get(sample);
+}
+
+static bool Sample_Cache_Busy(void const* data)
+{
+    for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
+        if (LockedData.SampleTracker[i].Cached == data && LockedData.SampleTracker[i].Active) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 int Play_Sample(const void* sample, int priority, int volume, signed short panloc)
 {
+    if (Any_Locked()) {
+        return INVALID_AUDIO_HANDLE;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+    Process_Audio_Commands();
+
     return Play_Sample_Handle(sample, priority, volume, panloc, Get_Free_Sample_Handle(priority));
 }
 
@@ -907,10 +1190,6 @@ static int Attempt_To_Play_Buffer(int id)
 
 static int Play_Sample_Handle(const void* sample, int priority, int volume, signed short panloc, int id)
 {
-    if (Any_Locked()) {
-        return INVALID_AUDIO_HANDLE;
-    }
-
     if (!AudioDone) {
         if (sample == nullptr || LockedData.DigiHandle == INVALID_AUDIO_HANDLE) {
             return INVALID_AUDIO_HANDLE;
@@ -922,9 +1201,14 @@ static int Play_Sample_Handle(const void* sample, int priority, int volume, sign
 
         SampleTrackerType* st = &LockedData.SampleTracker[id];
 
+        // Effects play from a decoded copy, so refilling the buffers is only a copy. Scores arrive a
+        // buffer at a time and are decoded as they play.
+        void const* data = st->IsScore ? sample : SampleCache.Get(sample);
+        st->Cached = data != sample ? data : nullptr;
+
         // Read in the sample's header.
         AUDHeaderType raw_header;
-        memcpy(&raw_header, sample, sizeof(raw_header));
+        memcpy(&raw_header, data, sizeof(raw_header));
         raw_header.Rate = le16toh(raw_header.Rate);
         raw_header.Size = le32toh(raw_header.Size);
         raw_header.UncompSize = le32toh(raw_header.UncompSize);
@@ -946,7 +1230,7 @@ static int Play_Sample_Handle(const void* sample, int priority, int volume, sign
         st->Priority = priority;
         st->Service = 0;
         st->Remainder = raw_header.Size;
-        st->Source = Add_Long_To_Pointer(sample, sizeof(AUDHeaderType));
+        st->Source = Add_Long_To_Pointer(data, sizeof(AUDHeaderType));
 
         // Compression is ADPCM so we need to init it's stream info.
         if (st->Compression == SCOMP_SOS) {
@@ -1027,6 +1311,8 @@ static int Play_Sample_Handle(const void* sample, int priority, int volume, sign
 
 int Set_Score_Vol(int volume)
 {
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+
     int old = LockedData.ScoreVolume;
     LockedData.ScoreVolume = volume;
 
@@ -1043,15 +1329,11 @@ int Set_Score_Vol(int volume)
 
 void Fade_Sample(int index, int ticks)
 {
-    if (Sample_Status(index)) {
-        SampleTrackerType* st = &LockedData.SampleTracker[index];
-
-        if (ticks > 0 && !st->Loading) {
-            st->Reducer = ((st->Volume / ticks) + 1);
-        } else {
-            Stop_Sample(index);
-        }
-    }
+    AudioCommandType command;
+    command.Command = AudioCommandType::AUDIO_FADE;
+    command.Handle = index;
+    command.Value = ticks;
+    Post_Audio_Command(command);
 }
 
 static int Get_Free_Sample_Handle(int priority)
@@ -1077,17 +1359,14 @@ static int Get_Free_Sample_Handle(int priority)
             return INVALID_AUDIO_HANDLE;
         }
 
-        Stop_Sample(index);
+        Stop_Sample_Now(index);
     }
 
     if (index == INVALID_AUDIO_HANDLE) {
         return INVALID_AUDIO_HANDLE;
     }
 
-    if (LockedData.SampleTracker[index].FileHandle != INVALID_FILE_HANDLE) {
-        Close_File(LockedData.SampleTracker[index].FileHandle);
-        LockedData.SampleTracker[index].FileHandle = INVALID_FILE_HANDLE;
-    }
+    Close_Stream_File(&LockedData.SampleTracker[index]);
 
     if (LockedData.SampleTracker[index].Original) {
         if (!LockedData.SampleTracker[index].IsScore) {
@@ -1124,8 +1403,11 @@ bool Start_Primary_Sound_Buffer(bool forced)
 
 void Stop_Primary_Sound_Buffer()
 {
+    std::lock_guard<std::recursive_mutex> lock(AudioLock);
+    Process_Audio_Commands();
+
     for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
-        Stop_Sample(i);
+        Stop_Sample_Now(i);
     }
 
     SoundImp_PauseSound();
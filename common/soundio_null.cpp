@@ -45,6 +45,9 @@ int Play_Sample(void const* sample, int priority, int volume, signed short panlo
 {
     return 1;
 }
+void Preload_Sample(void const* sample)
+{
+}
 int Set_Score_Vol(int volume)
 {
     return 0;
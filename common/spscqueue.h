@@ -0,0 +1,83 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+
+/*
+** Fixed size queue that one thread puts items into while another takes them out, without either
+** of them taking a lock. Only one thread may call Put and only one thread may call Get. SIZE must
+** be a power of two, and the queue holds at most SIZE - 1 items.
+*/
+template <class T, int SIZE> class SPSCQueueClass
+{
+    static_assert(SIZE > 1 && (SIZE & (SIZE - 1)) == 0, "SPSCQueueClass size must be a power of two.");
+
+public:
+    SPSCQueueClass(void)
+        : Head(0)
+        , Tail(0)
+    {
+    }
+
+    /*
+    ** Adds an item to the queue, returns false if the queue is full.
+    */
+    bool Put(T const& item)
+    {
+        unsigned tail = Tail.load(std::memory_order_relaxed);
+        unsigned next = (tail + 1) & (SIZE - 1);
+
+        if (next == Head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        Items[tail] = item;
+        Tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /*
+    ** Takes the oldest item off the queue, returns false if the queue is empty.
+    */
+    bool Get(T& item)
+    {
+        unsigned head = Head.load(std::memory_order_relaxed);
+
+        if (head == Tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = Items[head];
+        Head.store((head + 1) & (SIZE - 1), std::memory_order_release);
+        return true;
+    }
+
+    bool Is_Empty(void) const
+    {
+        return Head.load(std::memory_order_acquire) == Tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T Items[SIZE];
+    std::atomic<unsigned> Head; // Next item to take, only written by the consumer.
+    std::atomic<unsigned> Tail; // Next slot to fill, only written by the producer.
+
+    // The assignment operator is not supported.
+    SPSCQueueClass& operator=(SPSCQueueClass const&) = delete;
+
+    // The copy constructor is not supported.
+    SPSCQueueClass(SPSCQueueClass const&) = delete;
+};
+
+#endif
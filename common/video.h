@@ -41,6 +41,14 @@ public:
     virtual bool Unlock() = 0;
     virtual void Blt(const Rect& destRect, VideoSurface* src, const Rect& srcRect, bool mask) = 0;
     virtual void FillRect(const Rect& rect, unsigned char color) = 0;
+
+    /*
+    ** Called when an area of the surface may have been written to through a lock. Backends that only present the
+    ** parts of the screen that changed use it, the others can ignore it.
+    */
+    virtual void AddDirtyRect(const Rect& rect)
+    {
+    }
 };
 
 class SurfaceMonitorClass
@@ -44,8 +44,10 @@
 #include "wwmouse.h"
 #include "settings.h"
 #include "debugstring.h"
+#include "palconv.h"
 
 #include <SDL.h>
+#include <string.h>
 
 extern WWKeyboardClass* Keyboard;
 static SDL_Window* window;
@@ -53,6 +55,7 @@ static SDL_Renderer* renderer;
 static SDL_Palette* palette;
 static Uint32 pixel_format;
 static SDL_Rect render_dst;
+static PaletteConvertClass converter;
 
 static struct
 {
@@ -118,6 +121,18 @@ Uint32 SettingsPixelFormat()
 }
 
 static void Update_HWCursor();
+static void Invalidate_Front_Surface();
+
+/*
+** The texture can lose its contents when the renderer is reset, so upload all of it again.
+*/
+static int Watch_Render_Events(void* data, SDL_Event* event)
+{
+    if (event->type == SDL_RENDER_TARGETS_RESET || event->type == SDL_RENDER_DEVICE_RESET) {
+        Invalidate_Front_Surface();
+    }
+    return 0;
+}
 
 static void Update_HWCursor_Settings()
 {
@@ -330,6 +345,16 @@ bool Set_Video_Mode(int w, int h, int bits_per_pixel)
                  (pixel_format == info.texture_formats[i] ? " (selected)" : ""));
     }
 
+    /*
+    ** 16 and 32 bit formats are expanded from the palette straight into the texture, others go through SDL.
+    */
+    int bpp;
+    Uint32 rmask, gmask, bmask, amask;
+    SDL_PixelFormatEnumToMasks(pixel_format, &bpp, &rmask, &gmask, &bmask, &amask);
+    if (converter.Set_Format(SDL_BYTESPERPIXEL(pixel_format) * 8, rmask, gmask, bmask, amask)) {
+        DBG_INFO("  palette converted directly into the texture");
+    }
+
     /*
     ** Set requested scaling algorithm.
     */
@@ -343,6 +368,9 @@ bool Set_Video_Mode(int w, int h, int bits_per_pixel)
         palette = SDL_AllocPalette(256);
     }
 
+    SDL_DelEventWatch(Watch_Render_Events, nullptr);
+    SDL_AddEventWatch(Watch_Render_Events, nullptr);
+
     /*
     ** Set mouse scaling options.
     */
@@ -488,6 +516,8 @@ void Reset_Video_Mode(void)
         hwcursor.Surface = nullptr;
     }
 
+    SDL_DelEventWatch(Watch_Render_Events, nullptr);
+
     SDL_DestroyRenderer(renderer);
     renderer = nullptr;
 
@@ -663,6 +693,12 @@ void Set_DD_Palette(void* rpalette)
     colors[0].a = 0;
 
     SDL_SetPaletteColors(palette, colors, 0, 256);
+    converter.Set_Colors((unsigned char*)colors);
+
+    /*
+    ** Every pixel changes colour, so the whole frame has to be converted again.
+    */
+    Invalidate_Front_Surface();
 
     /*
     ** Cursor needs to be updated when palette changes.
@@ -709,6 +745,46 @@ SurfaceMonitorClass::SurfaceMonitorClass()
     SurfacesRestored = false;
 }
 
+/*
+** Finds the first and last bytes that differ between two rows of pixels. Returns false if the rows are the same.
+*/
+static bool Row_Difference(const unsigned char* a, const unsigned char* b, int width, int& left, int& right)
+{
+    if (memcmp(a, b, width) == 0) {
+        return false;
+    }
+
+    left = 0;
+    while (left + 8 <= width) {
+        uint64_t x, y;
+        memcpy(&x, a + left, 8);
+        memcpy(&y, b + left, 8);
+        if (x != y) {
+            break;
+        }
+        left += 8;
+    }
+    while (a[left] == b[left]) {
+        left++;
+    }
+
+    right = width - 1;
+    while (right - 8 >= left) {
+        uint64_t x, y;
+        memcpy(&x, a + right - 7, 8);
+        memcpy(&y, b + right - 7, 8);
+        if (x != y) {
+            break;
+        }
+        right -= 8;
+    }
+    while (a[right] == b[right]) {
+        right--;
+    }
+
+    return true;
+}
+
 /*
 ** VideoSurfaceDDraw
 */
@@ -722,13 +798,16 @@ public:
         : flags(flags)
         , windowSurface(nullptr)
         , texture(nullptr)
+        , dirty(0, 0, w, h)
     {
         surface = SDL_CreateRGBSurface(0, w, h, 8, 0, 0, 0, 0);
         SDL_SetSurfacePalette(surface, palette);
 
         if (flags & GBC_VISIBLE) {
-            windowSurface = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(pixel_format), pixel_format);
-            texture = SDL_CreateTexture(renderer, windowSurface->format->format, SDL_TEXTUREACCESS_STREAMING, w, h);
+            if (!converter.Is_Supported()) {
+                windowSurface = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(pixel_format), pixel_format);
+            }
+            texture = SDL_CreateTexture(renderer, pixel_format, SDL_TEXTUREACCESS_STREAMING, w, h);
             frontSurface = this;
         }
     }
@@ -785,21 +864,66 @@ public:
 
     virtual void Blt(const Rect& destRect, VideoSurface* src, const Rect& srcRect, bool mask)
     {
-        SDL_BlitSurface(((VideoSurfaceSDL2*)src)->surface, (SDL_Rect*)(&srcRect), surface, (SDL_Rect*)&destRect);
+        SDL_Surface* source = ((VideoSurfaceSDL2*)src)->surface;
+
+        /*
+        ** Most frames copy the whole hidden page to the screen although little of it changed. Only copy the rows
+        ** that differ so that present only has to convert and upload those.
+        */
+        if (texture != nullptr && !mask && src != this && destRect.Width == srcRect.Width
+            && destRect.Height == srcRect.Height && Rect(0, 0, surface->w, surface->h).Intersect(destRect) == destRect
+            && Rect(0, 0, source->w, source->h).Intersect(srcRect) == srcRect) {
+            Copy_Changed(destRect, source, srcRect);
+            return;
+        }
+
+        SDL_BlitSurface(source, (SDL_Rect*)(&srcRect), surface, (SDL_Rect*)&destRect);
+        AddDirtyRect(destRect);
     }
 
     virtual void FillRect(const Rect& rect, unsigned char color)
     {
         SDL_Rect rectSDL = {rect.X, rect.Y, rect.Width + 1, rect.Height + 1};
         SDL_FillRect(surface, &rectSDL, color);
+        AddDirtyRect(Rect(rect.X, rect.Y, rect.Width + 1, rect.Height + 1));
+    }
+
+    virtual void AddDirtyRect(const Rect& rect)
+    {
+        if (texture != nullptr) {
+            dirty = Union(dirty, Rect(0, 0, surface->w, surface->h).Intersect(rect));
+        }
+    }
+
+    void Invalidate()
+    {
+        dirty = Rect(0, 0, surface->w, surface->h);
     }
 
     void RenderSurface()
     {
-        void* pixels;
-        int pitch;
+        /*
+        ** Convert and upload only what changed since the last frame. The software cursor is drawn onto the
+        ** converted frame, so where it was last time has to be converted again to remove it.
+        */
+        Rect cursor;
+
+        if (!Settings.Video.HardwareCursor && !Get_Mouse_State() && hwcursor.Surface != nullptr) {
+            int x, y;
+
+            Get_Video_Mouse(x, y);
+            cursor = Rect(x - hwcursor.HotX, y - hwcursor.HotY, hwcursor.Surface->w, hwcursor.Surface->h);
+        }
+
+        Rect update = Rect(0, 0, surface->w, surface->h).Intersect(Union(Union(dirty, lastCursor), cursor));
 
-        SDL_BlitSurface(surface, NULL, windowSurface, NULL);
+        if (update.Is_Valid()) {
+            if (windowSurface == nullptr) {
+                Convert_To_Texture(update, cursor);
+            } else {
+                Blit_To_Texture(update, cursor);
+            }
+        }
 
         if (Settings.Video.HardwareCursor) {
             /*
@@ -820,36 +944,110 @@ public:
             ** Update hardware cursor visibility.
             */
             SDL_ShowCursor(!Get_Mouse_State());
-        } else if (!Get_Mouse_State() && hwcursor.Surface != nullptr) {
-            /*
-            ** Draw software emulated cursor.
-            */
-            int x, y;
-            SDL_Rect dst;
-
-            Get_Video_Mouse(x, y);
+        }
 
-            dst.x = x - hwcursor.HotX;
-            dst.y = y - hwcursor.HotY;
-            dst.w = hwcursor.Surface->w;
-            dst.h = hwcursor.Surface->h;
+        lastCursor = cursor;
 
-            SDL_BlitSurface(hwcursor.Surface, nullptr, windowSurface, &dst);
+        /*
+        ** Whoever holds a lock may still be drawing, so keep what it marked for the next frame.
+        */
+        if (!surface->locked) {
+            dirty = Rect();
         }
 
-        SDL_UpdateTexture(texture, NULL, windowSurface->pixels, windowSurface->pitch);
         SDL_RenderClear(renderer);
         SDL_RenderCopy(renderer, texture, NULL, &render_dst);
         SDL_RenderPresent(renderer);
     }
 
 private:
+    /*
+    ** Expands the palettized pixels straight into the texture through the palette table.
+    */
+    void Convert_To_Texture(const Rect& update, const Rect& cursor)
+    {
+        SDL_Rect area = {update.X, update.Y, update.Width, update.Height};
+        unsigned char* pixels;
+        int pitch;
+
+        if (SDL_LockTexture(texture, &area, (void**)&pixels, &pitch) != 0) {
+            return;
+        }
+
+        int bytes = converter.Bytes_Per_Pixel();
+        unsigned char* src = (unsigned char*)surface->pixels + area.y * surface->pitch + area.x;
+        converter.Convert(src, surface->pitch, pixels, pitch, area.w, area.h);
+
+        /*
+        ** Draw software emulated cursor. It is always inside the area updated.
+        */
+        Rect shown = update.Intersect(cursor);
+        if (shown.Is_Valid()) {
+            unsigned char* image = (unsigned char*)hwcursor.Surface->pixels
+                                   + (shown.Y - cursor.Y) * hwcursor.Surface->pitch + (shown.X - cursor.X);
+            unsigned char* dst = pixels + (shown.Y - area.y) * pitch + (shown.X - area.x) * bytes;
+            converter.Convert_Transparent(image, hwcursor.Surface->pitch, dst, pitch, shown.Width, shown.Height);
+        }
+
+        SDL_UnlockTexture(texture);
+    }
+
+    /*
+    ** Formats the palette table can't make are converted by SDL into a surface, and uploaded from there.
+    */
+    void Blit_To_Texture(const Rect& update, const Rect& cursor)
+    {
+        SDL_Rect area = {update.X, update.Y, update.Width, update.Height};
+        SDL_Rect dst = area;
+
+        SDL_BlitSurface(surface, &area, windowSurface, &dst);
+
+        /*
+        ** Draw software emulated cursor.
+        */
+        if (cursor.Is_Valid()) {
+            dst = {cursor.X, cursor.Y, cursor.Width, cursor.Height};
+            SDL_BlitSurface(hwcursor.Surface, nullptr, windowSurface, &dst);
+        }
+
+        unsigned char* pixels = (unsigned char*)windowSurface->pixels + area.y * windowSurface->pitch
+                                + area.x * windowSurface->format->BytesPerPixel;
+        SDL_UpdateTexture(texture, &area, pixels, windowSurface->pitch);
+    }
+
+    void Copy_Changed(const Rect& destRect, SDL_Surface* source, const Rect& srcRect)
+    {
+        Rect changed;
+
+        for (int y = 0; y < destRect.Height; y++) {
+            unsigned char* dst = (unsigned char*)surface->pixels + (destRect.Y + y) * surface->pitch + destRect.X;
+            unsigned char* src = (unsigned char*)source->pixels + (srcRect.Y + y) * source->pitch + srcRect.X;
+            int left, right;
+
+            if (Row_Difference(dst, src, destRect.Width, left, right)) {
+                memcpy(dst + left, src + left, right - left + 1);
+                changed = Union(changed, Rect(destRect.X + left, destRect.Y + y, right - left + 1, 1));
+            }
+        }
+
+        AddDirtyRect(changed);
+    }
+
     SDL_Surface* surface;
     SDL_Surface* windowSurface;
     SDL_Texture* texture;
     GBC_Enum flags;
+    Rect dirty;      // Area of the surface changed since the last frame.
+    Rect lastCursor; // Where the software cursor was drawn last frame.
 };
 
+static void Invalidate_Front_Surface()
+{
+    if (frontSurface) {
+        frontSurface->Invalidate();
+    }
+}
+
 void Video_Render_Frame()
 {
     if (frontSurface) {
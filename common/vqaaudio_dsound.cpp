@@ -70,7 +70,7 @@ bool Move_HMI_Audio_Block_To_Direct_Sound_Buffer()
         }
 
         ++audio->NumSkipped;
-        config->DrawFlags &= 0xFB;
+        VQAAudioStarved = true;
 
         return false;
     }
@@ -117,7 +117,7 @@ bool Queue_Audio(ALuint buffer)
         }
 
         ++audio->NumSkipped;
-        config->DrawFlags &= 0xFB;
+        VQAAudioStarved = true;
 
         return false;
     }
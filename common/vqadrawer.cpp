@@ -17,6 +17,7 @@
 #include "vqafile.h"
 #include "vqaloader.h"
 #include "vqapalette.h"
+#include "vqatask.h"
 #include <string.h>
 
 int VQA_DrawFrame_Buffer(VQAHandle* handle)
@@ -33,7 +34,11 @@ int VQA_DrawFrame_Buffer(VQAHandle* handle)
             return result;
         }
 
-        VQA_PrepareFrame(vqabuf);
+        // The loader thread unpacks pipelined frames before handing them over, and is the only thread
+        // that touches codebook flags, since it sets them on the next codebook while this one draws.
+        if (vqabuf->Pipeline == nullptr) {
+            VQA_PrepareFrame(vqabuf);
+        }
     }
 
     if (vqabuf->Flags & 1) {
@@ -250,7 +255,7 @@ int VQA_SelectFrame(VQAHandle* handle)
     VQAData* vqabuf = handle->VQABuf;
     VQAFrameNode* curframe = vqabuf->Drawer.CurFrame;
 
-    if (!(curframe->Flags & 1)) {
+    if (!VQA_FrameLoaded(handle, curframe)) {
         ++vqabuf->Drawer.WaitsOnLoader;
         return VQAERR_NOBUFFER;
     }
@@ -272,6 +277,10 @@ int VQA_SelectFrame(VQAHandle* handle)
         return VQAERR_NOT_TIME;
     }
 
+    if (VQAAudioStarved.exchange(false)) {
+        handle->Config.DrawFlags &= ~VQACFGF_NOSKIP;
+    }
+
     if (handle->Config.FrameRate / 5 > curframe->FrameNum - vqabuf->Drawer.LastFrame) {
         if (handle->Config.DrawFlags & 4) {
             vqabuf->Drawer.LastFrame = curframe->FrameNum;
@@ -279,7 +288,7 @@ int VQA_SelectFrame(VQAHandle* handle)
 
         } else {
             while (true) {
-                if (!(curframe->Flags & 1)) {
+                if (!VQA_FrameLoaded(handle, curframe)) {
                     return VQAERR_NOBUFFER;
                 }
 
@@ -304,7 +313,7 @@ int VQA_SelectFrame(VQAHandle* handle)
                     config->DrawerCallback(nullptr, curframe->FrameNum);
                 }
 
-                curframe->Flags = 0;
+                VQA_ReleaseFrame(handle, curframe);
                 curframe = curframe->Next;
                 vqabuf->Drawer.CurFrame = curframe;
                 ++vqabuf->Drawer.NumSkipped;
@@ -324,7 +333,13 @@ int VQA_SelectFrame(VQAHandle* handle)
 
 void VQA_PrepareFrame(VQAData* vqabuf)
 {
-    VQAFrameNode* curframe = vqabuf->Drawer.CurFrame;
+    VQA_UnpackFrame(vqabuf, vqabuf->Drawer.CurFrame);
+}
+
+// Uncompresses whatever parts of a loaded frame are still compressed, the loader thread does this
+// ahead of time when playing with VQAOPTF_PIPELINE.
+void VQA_UnpackFrame(VQAData* vqabuf, VQAFrameNode* curframe)
+{
     VQACBNode* codebook = curframe->Codebook;
 
     if (codebook->Flags & 0x02) {
@@ -64,5 +64,6 @@ void VQA_SetDrawBuffer(VQAHandle* handle, uint8_t* buffer, unsigned width, unsig
 void VQA_ConfigureDrawer(VQAHandle* handle);
 int VQA_SelectFrame(VQAHandle* handle);
 void VQA_PrepareFrame(VQAData* data);
+void VQA_UnpackFrame(VQAData* data, VQAFrameNode* frame);
 
 #endif
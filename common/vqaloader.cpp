@@ -725,7 +725,7 @@ int VQA_Open(VQAHandle* handle, const char* filename, VQAConfig* config)
     if (frame_info_found) {
 
         if (!(header->Flags & 1)) {
-            handle->Config.OptionFlags &= VQAOPTF_AUDIO;
+            handle->Config.OptionFlags &= ~VQAOPTF_AUDIO;
         }
 
         if (handle->Config.OptionFlags & VQAOPTF_AUDIO) {
@@ -806,14 +806,14 @@ int VQA_LoadFrame(VQAHandle* handle)
         return VQAERR_NOBUFFER;
     }
 
-    if (!(data->Flags & 4)) {
+    if (!loader->ResumeChunk) {
         frame_loaded = false;
         data->Loader.FrameSize = 0;
         curframe->Codebook = loader->FullCB;
     }
 
     while (!frame_loaded) {
-        if (!(data->Flags & 4)) {
+        if (!loader->ResumeChunk) {
             if (handle->StreamHandler(handle, VQACMD_READ, chunk, sizeof(*chunk))) {
                 return VQAERR_ERROR;
             }
@@ -994,11 +994,11 @@ int VQA_LoadFrame(VQAHandle* handle)
 
             } else {
                 if (VQA_CopyAudio(handle) == VQAERR_SLEEPING) {
-                    handle->VQABuf->Flags |= 4;
+                    loader->ResumeChunk = true;
                     return VQAERR_SLEEPING;
                 }
 
-                handle->VQABuf->Flags &= 0xFB;
+                loader->ResumeChunk = false;
                 if (VQA_Load_SND0(handle, iffsize)) {
                     return VQAERR_READ;
                 }
@@ -1010,11 +1010,11 @@ int VQA_LoadFrame(VQAHandle* handle)
 
             if (handle->Config.OptionFlags & 0x40) {
                 if (VQA_CopyAudio(handle) == VQAERR_SLEEPING) {
-                    handle->VQABuf->Flags |= 4;
+                    loader->ResumeChunk = true;
                     return VQAERR_SLEEPING;
                 }
 
-                handle->VQABuf->Flags &= 0xFB;
+                loader->ResumeChunk = false;
 
                 if (VQA_Load_SND0(handle, iffsize)) {
                     return VQAERR_READ;
@@ -1036,11 +1036,11 @@ int VQA_LoadFrame(VQAHandle* handle)
                 }
             } else {
                 if (VQA_CopyAudio(handle) == VQAERR_SLEEPING) {
-                    handle->VQABuf->Flags |= 4;
+                    loader->ResumeChunk = true;
                     return VQAERR_SLEEPING;
                 }
 
-                handle->VQABuf->Flags &= 0xFB;
+                loader->ResumeChunk = false;
 
                 if (VQA_Load_SND1(handle, iffsize)) {
                     return VQAERR_READ;
@@ -1053,11 +1053,11 @@ int VQA_LoadFrame(VQAHandle* handle)
 
             if (handle->Config.OptionFlags & 0x40) {
                 if (VQA_CopyAudio(handle) == VQAERR_SLEEPING) {
-                    handle->VQABuf->Flags |= 4;
+                    loader->ResumeChunk = true;
                     return VQAERR_SLEEPING;
                 }
 
-                handle->VQABuf->Flags &= 0xFB;
+                loader->ResumeChunk = false;
 
                 if (VQA_Load_SND1(handle, iffsize)) {
                     return VQAERR_READ;
@@ -1078,11 +1078,11 @@ int VQA_LoadFrame(VQAHandle* handle)
                 }
             } else {
                 if (VQA_CopyAudio(handle) == VQAERR_SLEEPING) {
-                    handle->VQABuf->Flags |= 4;
+                    loader->ResumeChunk = true;
                     return VQAERR_SLEEPING;
                 }
 
-                handle->VQABuf->Flags &= 0xFB;
+                loader->ResumeChunk = false;
 
                 if (VQA_Load_SND2(handle, iffsize)) {
                     return VQAERR_READ;
@@ -1095,11 +1095,11 @@ int VQA_LoadFrame(VQAHandle* handle)
 
             if (handle->Config.OptionFlags & 0x40) {
                 if (VQA_CopyAudio(handle) == VQAERR_SLEEPING) {
-                    handle->VQABuf->Flags |= 4;
+                    loader->ResumeChunk = true;
                     return VQAERR_SLEEPING;
                 }
 
-                handle->VQABuf->Flags &= 0xFB;
+                loader->ResumeChunk = false;
 
                 if (VQA_Load_SND2(handle, iffsize)) {
                     return VQAERR_READ;
@@ -24,6 +24,7 @@ typedef struct _VQAHandle VQAHandle;
 typedef struct _VQAConfig VQAConfig;
 typedef struct _VQACBNode VQACBNode;
 typedef struct _VQAFrameNode VQAFrameNode;
+typedef struct _VQAPipeline VQAPipeline;
 
 typedef int (*DrawFrameFuncPtr)(VQAHandle*);
 typedef int (*PageFlipFuncPtr)(VQAHandle*);
@@ -165,6 +166,7 @@ typedef struct _VQALoader
     int WaitsOnAudio;
     int FrameSize;
     int MaxFrameSize;
+    bool ResumeChunk; // Chunk header has been read, its data waits for room in the audio buffer.
 } VQALoader;
 
 typedef struct _VQAData
@@ -190,6 +192,10 @@ typedef struct _VQAData
     int StartTime;
     int EndTime;
     int MemUsed;
+    unsigned LoadTime;     // Microseconds spent loading frames while playing.
+    unsigned DrawTime;     // Microseconds spent drawing and flipping frames.
+    int LateFrames;        // Frames drawn after the following frame was already due.
+    VQAPipeline* Pipeline; // Loader thread state, only set while playing with VQAOPTF_PIPELINE.
 } VQAData;
 
 #pragma pack(push, 1)
@@ -15,9 +15,186 @@
 #include "vqadrawer.h"
 #include "vqafile.h"
 #include "vqaloader.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string.h>
+#include <thread>
 
 bool VQAMovieDone = false;
+std::atomic<bool> VQAAudioStarved(false);
+
+/*
+** With VQAOPTF_PIPELINE a loader thread reads frames into the frame ring ahead of the player, so the
+** player only selects, draws and flips frames and a slow disk read doesn't hold up the next frame.
+**
+** Frames go round the ring in order: the loader thread fills the frame after the last one it loaded,
+** and the player releases each frame once it has been skipped or flipped. Pending counts the frames
+** between the two, and Loading is the frame being filled, so neither thread looks at the flags of a
+** frame the other one is still using.
+**
+** Codebooks are shared by runs of frames, and the loader thread updates the flags of the codebook
+** being filled while the player draws with an earlier one. So only the loader thread uncompresses
+** codebooks or touches their flags, and the player only sees a codebook through a frame handed over
+** under Lock.
+*/
+struct _VQAPipeline
+{
+    std::thread Thread;
+    std::mutex Lock;
+    std::condition_variable Wake;
+    VQAFrameNode* Loading; // Frame the loader thread is filling, NULL between frames.
+    int Pending;           // Frames loaded and not yet released.
+    bool Done;             // The last frame has been loaded, or loading failed.
+    bool Quit;             // Tells the loader thread to stop.
+};
+
+enum
+{
+    VQA_LOADER_SLEEP = 2 // Milliseconds the loader thread waits for room in the audio buffer.
+};
+
+static unsigned VQA_Microseconds(void)
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return unsigned(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+static void VQA_LoaderThread(VQAHandle* handle)
+{
+    VQAData* data = handle->VQABuf;
+    VQAPipeline* pipe = data->Pipeline;
+    std::unique_lock<std::mutex> lock(pipe->Lock);
+
+    while (!pipe->Quit) {
+        if (pipe->Pending >= handle->Config.NumFrameBufs) {
+            pipe->Wake.wait(lock);
+            continue;
+        }
+
+        VQAFrameNode* frame = data->Loader.CurFrame;
+        pipe->Loading = frame;
+        lock.unlock();
+
+        unsigned start = VQA_Microseconds();
+        VQAErrorType rc = (VQAErrorType)VQA_LoadFrame(handle);
+
+        if (rc == VQAERR_NONE) {
+            VQA_UnpackFrame(data, frame);
+        }
+
+        unsigned elapsed = VQA_Microseconds() - start;
+
+        lock.lock();
+        pipe->Loading = nullptr;
+        data->LoadTime += elapsed;
+
+        if (rc == VQAERR_NONE) {
+            ++pipe->Pending;
+            ++data->LoadedFrames;
+        } else if (rc == VQAERR_SLEEPING || rc == VQAERR_NOBUFFER) {
+            pipe->Wake.wait_for(lock, std::chrono::milliseconds(VQA_LOADER_SLEEP));
+        } else {
+            pipe->Done = true;
+            break;
+        }
+    }
+}
+
+/*
+** Starts the loader thread. Frames already loaded by VQA_Open count as pending, and are unpacked
+** here so that only one thread ever uncompresses a codebook they share with later frames.
+*/
+static void VQA_StartLoader(VQAHandle* handle)
+{
+    VQAData* data = handle->VQABuf;
+    VQAPipeline* pipe = new VQAPipeline;
+
+    pipe->Loading = nullptr;
+    pipe->Pending = 0;
+    pipe->Done = false;
+    pipe->Quit = false;
+
+    VQAFrameNode* frame = data->FrameData;
+    for (int index = 0; index < handle->Config.NumFrameBufs; ++index) {
+        if (frame->Flags & 1) {
+            VQA_UnpackFrame(data, frame);
+            ++pipe->Pending;
+        }
+        frame = frame->Next;
+    }
+
+    data->Pipeline = pipe;
+    pipe->Thread = std::thread(VQA_LoaderThread, handle);
+}
+
+static void VQA_StopLoader(VQAHandle* handle)
+{
+    VQAData* data = handle->VQABuf;
+    VQAPipeline* pipe = data->Pipeline;
+
+    if (pipe == nullptr) {
+        return;
+    }
+
+    pipe->Lock.lock();
+    pipe->Quit = true;
+    pipe->Lock.unlock();
+    pipe->Wake.notify_all();
+    pipe->Thread.join();
+
+    data->Pipeline = nullptr;
+    delete pipe;
+}
+
+static bool VQA_LoaderDone(VQAHandle* handle)
+{
+    VQAPipeline* pipe = handle->VQABuf->Pipeline;
+    std::lock_guard<std::mutex> lock(pipe->Lock);
+    return pipe->Done;
+}
+
+/*
+** Returns true if the frame has been loaded and is ready to draw.
+*/
+bool VQA_FrameLoaded(VQAHandle* handle, VQAFrameNode* frame)
+{
+    VQAPipeline* pipe = handle->VQABuf->Pipeline;
+
+    if (pipe == nullptr) {
+        return (frame->Flags & 1) != 0;
+    }
+
+    std::lock_guard<std::mutex> lock(pipe->Lock);
+    return frame != pipe->Loading && (frame->Flags & 1) != 0;
+}
+
+/*
+** Hands a frame the player has finished with back to the loader.
+*/
+void VQA_ReleaseFrame(VQAHandle* handle, VQAFrameNode* frame)
+{
+    VQAPipeline* pipe = handle->VQABuf->Pipeline;
+
+    if (pipe == nullptr) {
+        frame->Flags = 0;
+        return;
+    }
+
+    pipe->Lock.lock();
+    bool loaded = frame != pipe->Loading && (frame->Flags & 1) != 0;
+
+    if (loaded) {
+        frame->Flags = 0;
+        --pipe->Pending;
+    }
+
+    pipe->Lock.unlock();
+
+    if (loaded) {
+        pipe->Wake.notify_one();
+    }
+}
 
 VQAHandle* VQA_Alloc(void)
 {
@@ -57,6 +234,10 @@ void VQA_Reset(VQAHandle* handle)
     data->DrawnFrames = 0;
     data->StartTime = 0;
     data->EndTime = 0;
+    data->LoadTime = 0;
+    data->DrawTime = 0;
+    data->LateFrames = 0;
+    data->Loader.ResumeChunk = false;
 }
 
 // VQAPlayMode
@@ -78,6 +259,7 @@ VQAErrorType VQA_Play(VQAHandle* handle, VQAPlayMode mode)
     VQADrawer* drawer = &data->Drawer;
 
     if (!(data->Flags & VQA_DATA_FLAG_32)) {
+        VQAAudioStarved = false;
         VQA_ConfigureDrawer(handle);
 
         // RA code
@@ -111,6 +293,11 @@ VQAErrorType VQA_Play(VQAHandle* handle, VQAPlayMode mode)
             VQA_SetTimer(handle, data->EndTime, config->TimerMethod);
         }
 
+        if (mode == VQAMODE_RUN && (config->OptionFlags & VQAOPTF_PIPELINE)
+            && !(config->OptionFlags & VQAOPTF_SINGLESTEP)) {
+            VQA_StartLoader(handle);
+        }
+
         while (mode != 1) {
             if (data->Flags & (VQA_DATA_FLAG_VIDEO_MEMORY_SET | VQA_DATA_FLAG_8)) {
                 break;
@@ -118,9 +305,18 @@ VQAErrorType VQA_Play(VQAHandle* handle, VQAPlayMode mode)
 
             if (data->Flags & VQA_DATA_FLAG_VIDEO_MEMORY_SET) {
                 VQAMovieDone = true;
+            } else if (data->Pipeline != nullptr) {
+                if (VQA_LoaderDone(handle)) {
+                    data->Flags |= VQA_DATA_FLAG_VIDEO_MEMORY_SET;
+                }
             } else {
+                unsigned start = VQA_Microseconds();
                 rc = (VQAErrorType)VQA_LoadFrame(handle);
 
+                if (rc != VQAERR_NOBUFFER) {
+                    data->LoadTime += VQA_Microseconds() - start;
+                }
+
                 if (rc != VQAERR_NONE) {
                     if (rc != VQAERR_NOBUFFER && rc != VQAERR_SLEEPING) {
                         data->Flags |= VQA_DATA_FLAG_VIDEO_MEMORY_SET;
@@ -134,10 +330,11 @@ VQAErrorType VQA_Play(VQAHandle* handle, VQAPlayMode mode)
 
             if (config->DrawFlags & 2) {
                 data->Flags |= VQA_DATA_FLAG_8;
-                drawer->CurFrame->Flags = 0;
+                VQA_ReleaseFrame(handle, drawer->CurFrame);
                 drawer->CurFrame = drawer->CurFrame->Next;
 
             } else {
+                unsigned start = VQA_Microseconds();
                 rc = (VQAErrorType)data->Draw_Frame(handle);
 
                 if (rc != VQAERR_NONE) {
@@ -148,14 +345,25 @@ VQAErrorType VQA_Play(VQAHandle* handle, VQAPlayMode mode)
                     if (data->Flags & VQA_DATA_FLAG_VIDEO_MEMORY_SET && rc == VQAERR_NOBUFFER) {
                         data->Flags |= VQA_DATA_FLAG_8;
                     }
+
+                    // Give the loader thread the processor while waiting for a frame or for its time.
+                    if ((rc == VQAERR_NOBUFFER || rc == VQAERR_NOT_TIME) && data->Pipeline != nullptr) {
+                        std::this_thread::yield();
+                    }
                 } else {
                     ++data->DrawnFrames;
 
+                    if (!(config->OptionFlags & VQAOPTF_SINGLESTEP) && drawer->LastFrameNum < drawer->DesiredFrame) {
+                        ++data->LateFrames;
+                    }
+
                     VQA_UserUpdate(handle);
 
                     if ((data->Page_Flip)(handle) != 0) {
                         data->Flags |= (VQA_DATA_FLAG_VIDEO_MEMORY_SET | VQA_DATA_FLAG_8);
                     }
+
+                    data->DrawTime += VQA_Microseconds() - start;
                 }
             }
 
@@ -163,6 +371,8 @@ VQAErrorType VQA_Play(VQAHandle* handle, VQAPlayMode mode)
                 // VQA_UpdateMono(handle);
             }
         }
+
+        VQA_StopLoader(handle);
     } else {
         if (!(data->Flags & VQA_DATA_FLAG_64)) {
             data->Flags |= VQA_DATA_FLAG_64;
@@ -243,6 +453,9 @@ void VQA_GetStats(VQAHandle* handle, VQAStatistics* stats)
     stats->FramesSkipped = data->Drawer.NumSkipped;
     stats->MaxFrameSize = data->Loader.MaxFrameSize;
     stats->SamplesPlayed = data->Audio.SamplesPlayed;
+    stats->LoadTime = data->LoadTime;
+    stats->DrawTime = data->DrawTime;
+    stats->FramesLate = data->LateFrames;
 }
 
 // Function found in BR, appears its only use there is to force BH,BW and CM to 0;
@@ -273,7 +486,7 @@ VQAErrorType VQA_UserUpdate(VQAHandle* handle)
     if (data->Flags & VQA_DATA_FLAG_REPEAT_SAME_TAG) {
         rc = (VQAErrorType)data->Page_Flip(handle);
         data->Flipper.LastFrameNum = data->Flipper.CurFrame->FrameNum;
-        data->Flipper.CurFrame->Flags = 0;
+        VQA_ReleaseFrame(handle, data->Flipper.CurFrame);
         data->Flags &= ~VQA_DATA_FLAG_REPEAT_SAME_TAG;
     }
 
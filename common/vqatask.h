@@ -13,6 +13,7 @@
 #define VQATASK_H
 
 #include "vqafile.h"
+#include <atomic>
 
 typedef struct _VQAInfo
 {
@@ -32,6 +33,9 @@ typedef struct _VQAStatistics
     int MaxFrameSize;
     unsigned SamplesPlayed;
     unsigned MemUsed;
+    unsigned LoadTime; // Microseconds spent loading frames, on the loader thread with VQAOPTF_PIPELINE.
+    unsigned DrawTime; // Microseconds spent drawing and flipping frames.
+    int FramesLate;    // Frames drawn after the following frame was already due, each one shows as a hitch.
 } VQAStatistics;
 
 typedef enum
@@ -41,6 +45,12 @@ typedef enum
 
 extern bool VQAMovieDone;
 
+/*
+** Set by the audio callback when the audio runs out, which may be on another thread. The drawer
+** clears VQACFGF_NOSKIP when it sees it, so the video can drop frames to catch up.
+*/
+extern std::atomic<bool> VQAAudioStarved;
+
 VQAHandle* VQA_Alloc();
 void VQA_Free(void* block);
 void VQA_Init(VQAHandle* vqa, StreamHandlerFuncPtr streamhandler);
@@ -55,5 +65,7 @@ void VQA_GetStats(VQAHandle* vqa, VQAStatistics* stats);
 VQAErrorType VQA_GetBlockWH_ColorMode(VQAHandle* vqa, unsigned* blockwidth, unsigned* blockheight, int* colormode);
 VQAErrorType VQA_GetXYPos(VQAHandle* vqa, uint16_t* xpos, uint16_t* ypos);
 VQAErrorType VQA_UserUpdate(VQAHandle* vqa);
+bool VQA_FrameLoaded(VQAHandle* vqa, VQAFrameNode* frame);
+void VQA_ReleaseFrame(VQAHandle* vqa, VQAFrameNode* frame);
 
 #endif
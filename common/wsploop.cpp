@@ -0,0 +1,344 @@
+//
+// Copyright 2020 Electronic Arts Inc.
+//
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "wsploop.h"
+#include "debugstring.h"
+
+#include <chrono>
+#include <string.h>
+
+#ifdef NETWORKING
+
+/*
+** Broadcast packets are sent to this address and copied to every other interface.
+*/
+#define LOOPBACK_BROADCAST 0xFFFFFFFF
+
+LoopbackNetworkClass::LoopbackNetworkClass(void)
+    : PacketsSent(0)
+    , PacketsLost(0)
+    , BytesSent(0)
+    , Latency(0)
+    , Jitter(0)
+    , Loss(0)
+    , Reorder(0)
+    , Random(0)
+    , Sequence(0)
+    , NextAddress(1)
+{
+    memset(Packets, 0, sizeof(Packets));
+    memset(Ports, 0, sizeof(Ports));
+}
+
+void LoopbackNetworkClass::Set_Latency(int latency, int jitter)
+{
+    Latency = latency;
+    Jitter = jitter;
+}
+
+void LoopbackNetworkClass::Set_Loss(int percent)
+{
+    Loss = percent;
+}
+
+void LoopbackNetworkClass::Set_Reorder(int percent)
+{
+    Reorder = percent;
+}
+
+void LoopbackNetworkClass::Set_Seed(unsigned seed)
+{
+    Random = RandomClass(seed);
+}
+
+/*
+** Current time in milliseconds, used for the arrival time of packets.
+*/
+unsigned LoopbackNetworkClass::Time(void)
+{
+    static auto epoch = std::chrono::steady_clock::now();
+    return unsigned(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+/*
+** Connects an interface to the network and gives it an address of the form 10.0.0.x.
+*/
+bool LoopbackNetworkClass::Attach(LoopbackInterfaceClass* port)
+{
+    for (int index = 0; index < MAX_PORTS; index++) {
+        if (Ports[index] == NULL) {
+            unsigned char address[4] = {10, 0, 0, (unsigned char)NextAddress++};
+            memcpy(&port->Address, address, sizeof(address));
+            Ports[index] = port;
+            return (true);
+        }
+    }
+    return (false);
+}
+
+/*
+** Disconnects an interface. Any packets still on their way to it are lost.
+*/
+void LoopbackNetworkClass::Detach(LoopbackInterfaceClass* port)
+{
+    for (int index = 0; index < MAX_PORTS; index++) {
+        if (Ports[index] == port) {
+            Ports[index] = NULL;
+        }
+    }
+
+    for (int index = 0; index < MAX_PACKETS; index++) {
+        if (Packets[index].IsActive && Packets[index].To == port->Address) {
+            Packets[index].IsActive = false;
+        }
+    }
+    port->Address = 0;
+}
+
+/*
+** Puts a packet on the network. Broadcasts are copied to every other interface and each copy has
+** its own chance of being lost or delayed.
+*/
+void LoopbackNetworkClass::Send(LoopbackInterfaceClass* from, unsigned to, void const* buffer, int buffer_len)
+{
+    if (to != LOOPBACK_BROADCAST) {
+        Queue(from->Address, to, buffer, buffer_len);
+        return;
+    }
+
+    for (int index = 0; index < MAX_PORTS; index++) {
+        if (Ports[index] != NULL && Ports[index] != from) {
+            Queue(from->Address, Ports[index]->Address, buffer, buffer_len);
+        }
+    }
+}
+
+void LoopbackNetworkClass::Queue(unsigned from, unsigned to, void const* buffer, int buffer_len)
+{
+    PacketsSent++;
+    BytesSent += buffer_len;
+
+    if (Loss > 0 && Random(0, 99) < Loss) {
+        PacketsLost++;
+        return;
+    }
+
+    PacketType* packet = NULL;
+    for (int index = 0; index < MAX_PACKETS; index++) {
+        if (!Packets[index].IsActive) {
+            packet = &Packets[index];
+            break;
+        }
+    }
+
+    /*
+    ** The network is full, it's the same as losing the packet.
+    */
+    if (packet == NULL || buffer_len > (int)sizeof(packet->Buffer)) {
+        PacketsLost++;
+        return;
+    }
+
+    int delay = Latency;
+    if (Jitter > 0) {
+        delay += Random(0, Jitter);
+    }
+    if (Reorder > 0 && Random(0, 99) < Reorder) {
+        delay += Latency + Jitter + 1;
+    }
+
+    packet->IsActive = true;
+    packet->Time = Time() + delay;
+    packet->Sequence = Sequence++;
+    packet->From = from;
+    packet->To = to;
+    packet->Length = buffer_len;
+    memcpy(packet->Buffer, buffer, buffer_len);
+}
+
+/*
+** Hands every packet that has arrived for the interface over to it, oldest first.
+*/
+void LoopbackNetworkClass::Deliver(LoopbackInterfaceClass* port)
+{
+    unsigned now = Time();
+
+    for (;;) {
+        PacketType* next = NULL;
+        for (int index = 0; index < MAX_PACKETS; index++) {
+            PacketType* packet = &Packets[index];
+            if (!packet->IsActive || packet->To != port->Address || (int)(now - packet->Time) < 0) {
+                continue;
+            }
+            if (next == NULL || (int)(packet->Time - next->Time) < 0
+                || (packet->Time == next->Time && (int)(packet->Sequence - next->Sequence) < 0)) {
+                next = packet;
+            }
+        }
+
+        if (next == NULL) {
+            break;
+        }
+
+        next->IsActive = false;
+        port->Receive(next->Buffer, next->Length, next->From);
+    }
+}
+
+LoopbackInterfaceClass::LoopbackInterfaceClass(LoopbackNetworkClass& network)
+    : WinsockInterfaceClass()
+    , Address(0)
+    , PacketsSent(0)
+    , PacketsReceived(0)
+    , BytesSent(0)
+    , BytesReceived(0)
+    , Network(network)
+    , IsListening(false)
+{
+}
+
+LoopbackInterfaceClass::~LoopbackInterfaceClass(void)
+{
+    Close_Socket();
+}
+
+/*
+** Joins the loopback network. There is no real socket, so Winsock doesn't need to be started.
+*/
+bool LoopbackInterfaceClass::Open_Socket(SOCKET)
+{
+    if (Address == 0 && !Network.Attach(this)) {
+        return (false);
+    }
+    return (true);
+}
+
+void LoopbackInterfaceClass::Close_Socket(void)
+{
+    if (Address != 0) {
+        Network.Detach(this);
+    }
+    IsListening = false;
+}
+
+bool LoopbackInterfaceClass::Start_Listening(void)
+{
+    IsListening = (Address != 0);
+    return (IsListening);
+}
+
+void LoopbackInterfaceClass::Stop_Listening(void)
+{
+    IsListening = false;
+}
+
+/*
+** Picks up any packets that have arrived. Called from the message loop, just like the UDP version.
+*/
+#if defined _WIN32 && !defined SDL_BUILD
+int LoopbackInterfaceClass::Message_Handler(HWND, UINT, UINT, LONG)
+#else
+int LoopbackInterfaceClass::Message_Handler()
+#endif
+{
+    if (IsListening) {
+        Network.Deliver(this);
+    }
+    return (0);
+}
+
+/*
+** Called by the network to store a packet that has arrived for this interface.
+*/
+void LoopbackInterfaceClass::Receive(void const* buffer, int buffer_len, unsigned from)
+{
+    WinsockBufferType* packet = Get_Buffer();
+    if (packet == NULL) {
+        DBG_LOG("Loopback: Out of packet buffers, packet discarded.\n");
+        return;
+    }
+
+    PacketsReceived++;
+    BytesReceived += buffer_len;
+
+    memcpy(packet->Buffer, buffer, buffer_len);
+    packet->BufferLen = buffer_len;
+    packet->IsBroadcast = false;
+    memset(packet->Address, 0, sizeof(packet->Address));
+    memcpy(packet->Address + 4, &from, 4);
+    InBuffers.Add(packet);
+}
+
+/*
+** Same as the Winsock version, but services the network directly rather than the message loop.
+*/
+int LoopbackInterfaceClass::Read(void* buffer, int& buffer_len, void* address, int& address_len)
+{
+#if defined _WIN32 && !defined SDL_BUILD
+    Message_Handler(NULL, 0, 0, 0);
+#else
+    Message_Handler();
+#endif
+
+    if (InBuffers.Count == 0) {
+        return (0);
+    }
+
+    /*
+    ** A packet that doesn't fit is discarded, otherwise it would block every later read.
+    */
+    WinsockBufferType* packet = InBuffers.First();
+    if (buffer_len < packet->BufferLen || address_len < (int)sizeof(packet->Address)) {
+        DBG_LOG("Loopback: Packet of %d bytes too big for the read buffer, packet discarded.\n", packet->BufferLen);
+        InBuffers.Next();
+        Free_Buffer(packet);
+        return (0);
+    }
+
+    memcpy(buffer, packet->Buffer, packet->BufferLen);
+    memcpy(address, packet->Address, sizeof(packet->Address));
+    buffer_len = packet->BufferLen;
+
+    InBuffers.Next();
+    Free_Buffer(packet);
+
+    return (buffer_len);
+}
+
+/*
+** The address is in the same format as for the UDP interface, the IP address is at offset 4.
+*/
+void LoopbackInterfaceClass::WriteTo(void* buffer, int buffer_len, void* address)
+{
+    unsigned to;
+    memcpy(&to, (unsigned char*)address + 4, 4);
+
+    if (Address != 0) {
+        PacketsSent++;
+        BytesSent += buffer_len;
+        Network.Send(this, to, buffer, buffer_len);
+    }
+}
+
+void LoopbackInterfaceClass::Broadcast(void* buffer, int buffer_len)
+{
+    if (Address != 0) {
+        PacketsSent++;
+        BytesSent += buffer_len;
+        Network.Send(this, LOOPBACK_BROADCAST, buffer, buffer_len);
+    }
+}
+
+#endif // NETWORKING
@@ -0,0 +1,141 @@
+//
+// Copyright 2020 Electronic Arts Inc.
+//
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef WSPLOOP_H
+#define WSPLOOP_H
+
+#include "wsproto.h"
+#include "random.h"
+
+class LoopbackInterfaceClass;
+
+/*
+** Simulated network that joins any number of loopback interfaces within one process. Packets are
+** held back for the configured latency plus a random amount of jitter. A percentage of them can be
+** thrown away, or held back for longer so that they arrive after packets sent later. The random
+** numbers come from a fixed seed so that a run can be repeated exactly.
+**
+** The network and its interfaces are not thread safe, everything must be serviced from one thread.
+*/
+class LoopbackNetworkClass
+{
+public:
+    enum
+    {
+        MAX_PORTS = 16,    // Most interfaces that can be attached at once.
+        MAX_PACKETS = 1024 // Most packets that can be on their way at once.
+    };
+
+    LoopbackNetworkClass(void);
+
+    void Set_Latency(int latency, int jitter);
+    void Set_Loss(int percent);
+    void Set_Reorder(int percent);
+    void Set_Seed(unsigned seed);
+
+    bool Attach(LoopbackInterfaceClass* port);
+    void Detach(LoopbackInterfaceClass* port);
+    void Send(LoopbackInterfaceClass* from, unsigned to, void const* buffer, int buffer_len);
+    void Deliver(LoopbackInterfaceClass* port);
+
+    static unsigned Time(void);
+
+    /*
+    **	Statistics for the whole network.
+    */
+    unsigned PacketsSent;
+    unsigned PacketsLost;
+    unsigned BytesSent;
+
+private:
+    void Queue(unsigned from, unsigned to, void const* buffer, int buffer_len);
+
+    struct PacketType
+    {
+        bool IsActive;
+        unsigned Time;     // Time the packet arrives, in milliseconds.
+        unsigned Sequence; // Keeps packets that arrive at the same time in the order sent.
+        unsigned From;     // Address of the sender.
+        unsigned To;       // Address of the receiver.
+        int Length;
+        unsigned char Buffer[WS_RECEIVE_BUFFER_LEN];
+    };
+
+    PacketType Packets[MAX_PACKETS];
+    LoopbackInterfaceClass* Ports[MAX_PORTS];
+
+    int Latency;  // Milliseconds every packet takes to arrive.
+    int Jitter;   // Most extra milliseconds that a packet can take at random.
+    int Loss;     // Percentage of packets thrown away.
+    int Reorder;  // Percentage of packets held back for an extra latency period.
+    RandomClass Random;
+    unsigned Sequence;
+    unsigned NextAddress;
+};
+
+/*
+** Stand in for the UDP interface that sends its packets over a LoopbackNetworkClass instead of a
+** socket. Addresses are handled the same way as UDP so that the rest of the game can't tell the
+** difference.
+*/
+class LoopbackInterfaceClass : public WinsockInterfaceClass
+{
+public:
+    LoopbackInterfaceClass(LoopbackNetworkClass& network);
+    virtual ~LoopbackInterfaceClass(void);
+
+#if defined _WIN32 && !defined SDL_BUILD
+    virtual int Message_Handler(HWND window, UINT message, UINT wParam, LONG lParam);
+#else
+    virtual int Message_Handler();
+#endif
+    virtual bool Open_Socket(SOCKET socketnum);
+    virtual void Close_Socket(void);
+    virtual bool Start_Listening(void);
+    virtual void Stop_Listening(void);
+    virtual int Read(void* buffer, int& buffer_len, void* address, int& address_len);
+    virtual void WriteTo(void* buffer, int buffer_len, void* address);
+    virtual void Broadcast(void* buffer, int buffer_len);
+
+    virtual ProtocolEnum Get_Protocol(void)
+    {
+        return (PROTOCOL_UDP);
+    };
+
+    virtual int Protocol_Event_Message(void)
+    {
+        return (WM_UDPASYNCEVENT);
+    };
+
+    void Receive(void const* buffer, int buffer_len, unsigned from);
+
+    /*
+    **	Address of this interface on the loopback network, zero when not open.
+    */
+    unsigned Address;
+
+    /*
+    **	Statistics for this interface.
+    */
+    unsigned PacketsSent;
+    unsigned PacketsReceived;
+    unsigned BytesSent;
+    unsigned BytesReceived;
+
+private:
+    LoopbackNetworkClass& Network;
+    bool IsListening;
+};
+
+#endif
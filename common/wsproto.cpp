@@ -44,6 +44,8 @@
  * WIC::Stop_Listening -- Disable the winsock event callback                                   *
  * WIC::Discard_In_Buffers -- Discard any packets in our incoming packet holding buffers       *
  * WIC::Discard_In_Buffers -- Discard any packets in our outgoing packet holding buffers       *
+ * WIC::Get_Buffer -- Fetch an unused packet buffer                                            *
+ * WIC::Free_Buffer -- Return a packet buffer to the free queue                                *
  * WIC::Init -- Initialised Winsock and this class for use.                                    *
  * WIC::Read -- read any pending input from the communications socket                          *
  * WIC::WriteTo -- Send data via the Winsock socket                                            *
@@ -98,6 +100,10 @@ WinsockInterfaceClass::WinsockInterfaceClass(void)
     FD_ZERO(&WriteSockets);
 #endif
     Socket = INVALID_SOCKET;
+
+    for (int i = 0; i < WS_MAX_BUFFERS; i++) {
+        FreeBuffers.Add(&Buffers[i]);
+    }
 }
 
 /***********************************************************************************************
@@ -267,12 +273,9 @@ void WinsockInterfaceClass::Stop_Listening(void)
  *=============================================================================================*/
 void WinsockInterfaceClass::Discard_In_Buffers(void)
 {
-    WinsockBufferType* packet;
-
-    while (InBuffers.Count()) {
-        packet = InBuffers[0];
-        delete packet;
-        InBuffers.Delete(0);
+    while (InBuffers.Count) {
+        Free_Buffer(InBuffers.First());
+        InBuffers.Next();
     }
 }
 
@@ -292,15 +295,49 @@ void WinsockInterfaceClass::Discard_In_Buffers(void)
  *=============================================================================================*/
 void WinsockInterfaceClass::Discard_Out_Buffers(void)
 {
-    WinsockBufferType* packet;
-
-    while (OutBuffers.Count()) {
-        packet = OutBuffers[0];
-        delete packet;
-        OutBuffers.Delete(0);
+    while (OutBuffers.Count) {
+        Free_Buffer(OutBuffers.First());
+        OutBuffers.Next();
     }
 }
 
+/***********************************************************************************************
+ * WIC::Get_Buffer -- Fetch an unused packet buffer                                            *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   ptr to buffer, or NULL if all the buffers are in use                              *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *=============================================================================================*/
+WinsockInterfaceClass::WinsockBufferType* WinsockInterfaceClass::Get_Buffer(void)
+{
+    if (FreeBuffers.Count == 0)
+        return (NULL);
+
+    WinsockBufferType* packet = FreeBuffers.First();
+    FreeBuffers.Next();
+    return (packet);
+}
+
+/***********************************************************************************************
+ * WIC::Free_Buffer -- Return a packet buffer to the free queue                                *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    ptr to buffer                                                                     *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: The buffer must not be in the in or out queue.                                    *
+ *=============================================================================================*/
+void WinsockInterfaceClass::Free_Buffer(WinsockBufferType* packet)
+{
+    FreeBuffers.Add(packet);
+}
+
 /***********************************************************************************************
  * WIC::Init -- Initialised Winsock and this class for use.                                    *
  *                                                                                             *
@@ -388,14 +425,13 @@ int WinsockInterfaceClass::Read(void* buffer, int& buffer_len, void* address, in
     /*
     ** If there are no available packets then return 0
     */
-    if (InBuffers.Count() == 0)
+    if (InBuffers.Count == 0)
         return (0);
 
     /*
     ** Get the oldest packet for reading
     */
-    int packetnum = 0;
-    WinsockBufferType* packet = InBuffers[packetnum];
+    WinsockBufferType* packet = InBuffers.First();
 
     assert(buffer_len >= packet->BufferLen);
     assert(address_len >= sizeof(packet->Address));
@@ -412,10 +448,10 @@ int WinsockInterfaceClass::Read(void* buffer, int& buffer_len, void* address, in
     buffer_len = packet->BufferLen;
 
     /*
-    ** Delete the temporary storage for the packet now that it is being passed to the game.
+    ** Release the temporary storage for the packet now that it is being passed to the game.
     */
-    InBuffers.Delete(packetnum);
-    delete packet;
+    InBuffers.Next();
+    Free_Buffer(packet);
 
     return (buffer_len);
 }
@@ -439,9 +475,14 @@ int WinsockInterfaceClass::Read(void* buffer, int& buffer_len, void* address, in
 void WinsockInterfaceClass::WriteTo(void* buffer, int buffer_len, void* address)
 {
     /*
-    ** Create a temporary holding area for the packet.
+    ** Get a temporary holding area for the packet. If they are all in use then the packet is
+    ** lost, the same as if the network had dropped it.
     */
-    WinsockBufferType* packet = new WinsockBufferType;
+    WinsockBufferType* packet = Get_Buffer();
+    if (packet == NULL) {
+        DBG_LOG("TS: Out of packet buffers, packet discarded.\n");
+        return;
+    }
 
     /*
     ** Copy the packet into the holding buffer.
@@ -489,9 +530,14 @@ void WinsockInterfaceClass::Broadcast(void* buffer, int buffer_len)
 {
 
     /*
-    ** Create a temporary holding area for the packet.
+    ** Get a temporary holding area for the packet. If they are all in use then the packet is
+    ** lost, the same as if the network had dropped it.
     */
-    WinsockBufferType* packet = new WinsockBufferType;
+    WinsockBufferType* packet = Get_Buffer();
+    if (packet == NULL) {
+        DBG_LOG("TS: Out of packet buffers, packet discarded.\n");
+        return;
+    }
 
     /*
     ** Copy the packet into the holding buffer.
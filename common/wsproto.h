@@ -44,6 +44,7 @@ extern WinsockInterfaceClass* PacketTransport; // The object for interfacing wit
 ** Include compatability sockets header file.
 */
 #include "sockets.h"
+#include "queue.h"
 
 #include <string.h>
 
@@ -60,6 +61,7 @@ extern WinsockInterfaceClass* PacketTransport; // The object for interfacing wit
 //buffer.
 #define WS_RECEIVE_BUFFER_LEN 1024       // Length of our temporary receive buffer.
 #define SOCKET_BUFFER_SIZE    1024 * 128 // Length of winsocks internal buffer.
+#define WS_MAX_BUFFERS        256        // Number of packets that can be held at once (power of two).
 
 #define PLANET_WESTWOOD_HANDLE_MAX 20 // Max length of a WChat handle
 
@@ -186,11 +188,18 @@ protected:
         unsigned char Buffer[1024]; // Buffer to store packet in.
     } WinsockBufferType;
 
+    WinsockBufferType* Get_Buffer(void);
+    void Free_Buffer(WinsockBufferType* packet);
+
     /*
-    ** Array of buffers to temporarily store incoming and outgoing packets.
+    ** Queues of buffers to temporarily store incoming and outgoing packets. The buffers are
+    ** allocated along with the class and handed out from the free queue, so no memory is
+    ** allocated or moved around for each packet.
     */
-    DynamicVectorClass<WinsockBufferType*> InBuffers;
-    DynamicVectorClass<WinsockBufferType*> OutBuffers;
+    QueueClass<WinsockBufferType*, WS_MAX_BUFFERS> InBuffers;
+    QueueClass<WinsockBufferType*, WS_MAX_BUFFERS> OutBuffers;
+    QueueClass<WinsockBufferType*, WS_MAX_BUFFERS> FreeBuffers;
+    WinsockBufferType Buffers[WS_MAX_BUFFERS];
 
     /*
     ** Is Winsock present and initialised?
@@ -217,11 +226,6 @@ protected:
     fd_set ReadyWriteSockets;
 #endif
 
-    /*
-    ** Temporary receive buffer to use when querying Winsock for incoming packets.
-    */
-    unsigned char ReceiveBuffer[WS_RECEIVE_BUFFER_LEN];
-
     /*
     ** Current connection status.
     */
@@ -38,7 +38,10 @@
  * UDPInterfaceClass::UDPInterfaceClass -- Class constructor.                                  *
  * UDPInterfaceClass::Set_Broadcast_Address -- Sets the address to send broadcast packets to   *
  * UDPInterfaceClass::Open_Socket -- Opens a socket for communications via the UDP protocol    *
+ * UDPIC::Queue_Packet -- Add a received packet to the incoming packet queue                   *
  * TMC::Message_Handler -- Message handler function for Winsock related messages               *
+ * UDPIC::Receive_Packets -- Read all the packets waiting on the socket                        *
+ * UDPIC::Send_Packets -- Send as many of the outgoing packets as the socket will take         *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "internet.h"
@@ -51,7 +54,6 @@ extern WWKeyboardClass* Keyboard;
 
 #include <assert.h>
 #include <stdio.h>
-#include <assert.h>
 
 #ifndef _WIN32
 #include <ifaddrs.h>
@@ -59,6 +61,11 @@ extern WWKeyboardClass* Keyboard;
 
 #ifdef NETWORKING
 
+/*
+** Number of packets passed to the system in one go by recvmmsg and sendmmsg.
+*/
+#define UDP_BATCH_SIZE 32
+
 /***********************************************************************************************
  * UDPInterfaceClass::UDPInterfaceClass -- Class constructor.                                  *
  *                                                                                             *
@@ -312,9 +319,13 @@ void UDPInterfaceClass::Broadcast(void* buffer, int buffer_len)
     for (int i = 0; i < BroadcastAddresses.Count(); i++) {
 
         /*
-        ** Create a temporary holding area for the packet.
+        ** Get a temporary holding area for the packet.
         */
-        WinsockBufferType* packet = new WinsockBufferType;
+        WinsockBufferType* packet = Get_Buffer();
+        if (packet == NULL) {
+            DBG_LOG("TS: Out of packet buffers, packet discarded.\n");
+            return;
+        }
 
         /*
         ** Copy the packet into the holding buffer.
@@ -351,6 +362,42 @@ void UDPInterfaceClass::Broadcast(void* buffer, int buffer_len)
     }
 }
 
+/***********************************************************************************************
+ * UDPIC::Queue_Packet -- Add a received packet to the incoming packet queue                   *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    ptr to buffer holding the packet                                                  *
+ *           length of packet                                                                  *
+ *           address packet was sent from                                                      *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: The buffer is released if the packet is not wanted.                               *
+ *=============================================================================================*/
+void UDPInterfaceClass::Queue_Packet(WinsockBufferType* packet, int length, struct sockaddr_in const& addr)
+{
+    /*
+    ** Make sure this packet didn't come from us. If it did then throw it away.
+    */
+    bool remote = (length > 0);
+    for (int i = 0; remote && i < LocalAddresses.Count(); i++) {
+        if (!memcmp(LocalAddresses[i], &addr.sin_addr.s_addr, 4)) {
+            remote = false;
+        }
+    }
+
+    if (!remote) {
+        Free_Buffer(packet);
+        return;
+    }
+
+    packet->BufferLen = length;
+    memset(packet->Address, 0, sizeof(packet->Address));
+    memcpy(packet->Address + 4, &addr.sin_addr.s_addr, 4);
+    InBuffers.Add(packet);
+}
+
 /***********************************************************************************************
  * TMC::Message_Handler -- Message handler function for Winsock related messages               *
  *                                                                                             *
@@ -399,11 +446,17 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
         }
 
         /*
-        ** Call the Winsock recvfrom function to get the outstanding packet.
+        ** Call the Winsock recvfrom function to get the outstanding packet. It is read straight
+        ** into a free packet buffer. If there are none then leave it with Winsock for now.
         */
+        packet = Get_Buffer();
+        if (packet == NULL) {
+            return (0);
+        }
         addr_len = sizeof(addr);
-        rc = recvfrom(Socket, (char*)ReceiveBuffer, sizeof(ReceiveBuffer), 0, (sockaddr*)&addr, &addr_len);
+        rc = recvfrom(Socket, (char*)packet->Buffer, sizeof(packet->Buffer), 0, (sockaddr*)&addr, &addr_len);
         if (rc == SOCKET_ERROR) {
+            Free_Buffer(packet);
             Clear_Socket_Error(Socket);
             return (0);
             ;
@@ -412,26 +465,7 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
         /*
         ** rc is the number of bytes received from Winsock
         */
-        if (rc) {
-
-            /*
-            ** Make sure this packet didn't come from us. If it did then throw it away.
-            */
-            for (int i = 0; i < LocalAddresses.Count(); i++) {
-                if (!memcmp(LocalAddresses[i], &addr.sin_addr.s_addr, 4))
-                    return (0);
-            }
-
-            /*
-            ** Create a new buffer and store this packet in it.
-            */
-            packet = new WinsockBufferType;
-            packet->BufferLen = rc;
-            memcpy(packet->Buffer, ReceiveBuffer, rc);
-            memset(packet->Address, 0, sizeof(packet->Address));
-            memcpy(packet->Address + 4, &addr.sin_addr.s_addr, 4);
-            InBuffers.Add(packet);
-        }
+        Queue_Packet(packet, rc, addr);
         return (0);
 
     /*
@@ -452,14 +486,13 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
         /*
         ** If there are no packets waiting to be sent then bail.
         */
-        if (OutBuffers.Count() == 0)
+        if (OutBuffers.Count == 0)
             return (0);
-        int packetnum = 0;
 
         /*
         ** Get a pointer to the packet.
         */
-        packet = OutBuffers[packetnum];
+        packet = OutBuffers.First();
 
         /*
         ** Set up the address structure of the outgoing packet
@@ -484,10 +517,10 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
         }
 
         /*
-        ** Delete the sent packet.
+        ** Release the sent packet.
         */
-        OutBuffers.Delete(packetnum);
-        delete packet;
+        OutBuffers.Next();
+        Free_Buffer(packet);
         return (0);
     }
 
@@ -496,106 +529,30 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
 #else
 int UDPInterfaceClass::Message_Handler()
 {
-    struct sockaddr_in addr;
     int rc;
-    socklen_t addr_len;
-    WinsockBufferType* packet;
     struct timeval tv;
 
     tv.tv_sec = 0;
     tv.tv_usec = 0;
 
     /*
-    ** Check if socket has data it would like to give us or can accept any data
+    ** Check if socket has data it would like to give us or can accept any data. Only ask about
+    ** writing if there is something to write.
     */
     fd_set* read_set = Get_Readset();
     fd_set* write_set = Get_Writeset();
+    if (OutBuffers.Count == 0) {
+        FD_ZERO(write_set);
+    }
     rc = select(Socket + 1, read_set, write_set, nullptr, &tv);
 
     if (rc >= 0) {
         if (FD_ISSET(Socket, read_set)) {
-            while (true) {
-                addr_len = sizeof(addr);
-                rc = recvfrom(Socket, (char*)ReceiveBuffer, sizeof(ReceiveBuffer), 0, (sockaddr*)&addr, &addr_len);
-
-                /*
-                ** rc is the number of bytes received.
-                */
-                if (rc <= 0) {
-                    if (rc < 0 && LastSocketError != WSAEWOULDBLOCK) {
-                        Clear_Socket_Error(Socket);
-                    }
-
-                    break;
-                } else {
-                    bool remote = true;
-
-                    /*
-                    ** Make sure this packet didn't come from us. If it did then throw it away.
-                    */
-                    for (int i = 0; i < LocalAddresses.Count(); i++) {
-                        if (!memcmp(LocalAddresses[i], &addr.sin_addr.s_addr, 4)) {
-                            remote = false;
-                            break;
-                        }
-                    }
-
-                    if (remote) {
-                        /*
-                        ** Create a new buffer and store this packet in it.
-                        */
-                        packet = new WinsockBufferType;
-                        packet->BufferLen = rc;
-                        memcpy(packet->Buffer, ReceiveBuffer, rc);
-                        memset(packet->Address, 0, sizeof(packet->Address));
-                        memcpy(packet->Address + 4, &addr.sin_addr.s_addr, 4);
-                        InBuffers.Add(packet);
-                    }
-                }
-            }
+            Receive_Packets();
         }
 
         if (FD_ISSET(Socket, write_set)) {
-            /*
-            ** If there are no packets waiting to be sent then bail.
-            */
-            while (OutBuffers.Count() != 0) {
-                int packetnum = 0;
-
-                /*
-                ** Get a pointer to the packet.
-                */
-                packet = OutBuffers[packetnum];
-
-                /*
-                ** Set up the address structure of the outgoing packet
-                */
-                memset(&addr, 0, sizeof(addr));
-                addr.sin_family = AF_INET;
-                addr.sin_port = hton16(PlanetWestwoodPortNumber);
-                memcpy(&addr.sin_addr.s_addr, packet->Address + 4, 4);
-
-                /*
-                ** Send it.
-                ** If we get a WSAWOULDBLOCK error it means that Winsock is unable to accept the packet
-                ** at this time. In this case, we clear the socket error and just exit. 
-                */
-                rc = sendto(Socket, (const char*)packet->Buffer, packet->BufferLen, 0, (sockaddr*)&addr, sizeof(addr));
-
-                if (rc == SOCKET_ERROR) {
-                    if (LastSocketError != WSAEWOULDBLOCK) {
-                        Clear_Socket_Error(Socket);
-                    }
-
-                    break;
-                } else {
-                    /*
-                    ** Delete the sent packet.
-                    */
-                    OutBuffers.Delete(packetnum);
-                    delete packet;
-                }
-            }
+            Send_Packets();
         }
     } else {
         Clear_Socket_Error(Socket);
@@ -603,6 +560,205 @@ int UDPInterfaceClass::Message_Handler()
 
     return 0;
 }
+
+/***********************************************************************************************
+ * UDPIC::Receive_Packets -- Read all the packets waiting on the socket                        *
+ *                                                                                             *
+ *    Packets are read straight into free packet buffers, a batch at a time where the system   *
+ *    supports it. Reading stops once half the buffers are waiting to be read by the game so   *
+ *    that there is always room left for outgoing packets.                                     *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *=============================================================================================*/
+void UDPInterfaceClass::Receive_Packets(void)
+{
+#ifdef __linux__
+    struct mmsghdr messages[UDP_BATCH_SIZE];
+    struct iovec vectors[UDP_BATCH_SIZE];
+    struct sockaddr_in addresses[UDP_BATCH_SIZE];
+    WinsockBufferType* packets[UDP_BATCH_SIZE];
+
+    for (;;) {
+        /*
+        ** Set up a batch of empty buffers to receive into.
+        */
+        int count = 0;
+        while (count < UDP_BATCH_SIZE && InBuffers.Count + count < WS_MAX_BUFFERS / 2) {
+            packets[count] = Get_Buffer();
+            if (packets[count] == NULL) {
+                break;
+            }
+
+            vectors[count].iov_base = packets[count]->Buffer;
+            vectors[count].iov_len = sizeof(packets[count]->Buffer);
+            memset(&messages[count], 0, sizeof(messages[count]));
+            messages[count].msg_hdr.msg_name = &addresses[count];
+            messages[count].msg_hdr.msg_namelen = sizeof(addresses[count]);
+            messages[count].msg_hdr.msg_iov = &vectors[count];
+            messages[count].msg_hdr.msg_iovlen = 1;
+            count++;
+        }
+
+        if (count == 0) {
+            break;
+        }
+
+        int rc = recvmmsg(Socket, messages, count, MSG_DONTWAIT, nullptr);
+        if (rc < 0) {
+            if (LastSocketError != WSAEWOULDBLOCK) {
+                Clear_Socket_Error(Socket);
+            }
+            rc = 0;
+        }
+
+        /*
+        ** Queue up what was received and give back the buffers that weren't used.
+        */
+        for (int i = 0; i < count; i++) {
+            if (i < rc) {
+                Queue_Packet(packets[i], messages[i].msg_len, addresses[i]);
+            } else {
+                Free_Buffer(packets[i]);
+            }
+        }
+
+        if (rc < count) {
+            break;
+        }
+    }
+#else
+    struct sockaddr_in addr;
+    socklen_t addr_len;
+
+    while (InBuffers.Count < WS_MAX_BUFFERS / 2) {
+        WinsockBufferType* packet = Get_Buffer();
+        if (packet == NULL) {
+            break;
+        }
+
+        addr_len = sizeof(addr);
+        int rc = recvfrom(Socket, (char*)packet->Buffer, sizeof(packet->Buffer), 0, (sockaddr*)&addr, &addr_len);
+
+        /*
+        ** rc is the number of bytes received.
+        */
+        if (rc <= 0) {
+            Free_Buffer(packet);
+            if (rc < 0 && LastSocketError != WSAEWOULDBLOCK) {
+                Clear_Socket_Error(Socket);
+            }
+            break;
+        }
+
+        Queue_Packet(packet, rc, addr);
+    }
+#endif
+}
+
+/***********************************************************************************************
+ * UDPIC::Send_Packets -- Send as many of the outgoing packets as the socket will take         *
+ *                                                                                             *
+ *    Packets are sent in order straight from their buffers, a batch at a time where the       *
+ *    system supports it. Anything the socket will not take right now is left queued for the   *
+ *    next call.                                                                               *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *=============================================================================================*/
+void UDPInterfaceClass::Send_Packets(void)
+{
+#ifdef __linux__
+    struct mmsghdr messages[UDP_BATCH_SIZE];
+    struct iovec vectors[UDP_BATCH_SIZE];
+    struct sockaddr_in addresses[UDP_BATCH_SIZE];
+
+    while (OutBuffers.Count != 0) {
+        int count = OutBuffers.Count < UDP_BATCH_SIZE ? OutBuffers.Count : UDP_BATCH_SIZE;
+
+        for (int i = 0; i < count; i++) {
+            WinsockBufferType* packet = OutBuffers[i];
+
+            memset(&addresses[i], 0, sizeof(addresses[i]));
+            addresses[i].sin_family = AF_INET;
+            addresses[i].sin_port = hton16(PlanetWestwoodPortNumber);
+            memcpy(&addresses[i].sin_addr.s_addr, packet->Address + 4, 4);
+
+            vectors[i].iov_base = packet->Buffer;
+            vectors[i].iov_len = packet->BufferLen;
+            memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_name = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        /*
+        ** If we get a WSAWOULDBLOCK error it means that the socket is unable to accept the packets
+        ** at this time. In this case, we clear the socket error and just exit.
+        */
+        int rc = sendmmsg(Socket, messages, count, 0);
+        if (rc < 0) {
+            if (LastSocketError != WSAEWOULDBLOCK) {
+                Clear_Socket_Error(Socket);
+            }
+            break;
+        }
+
+        /*
+        ** Release the sent packets.
+        */
+        for (int i = 0; i < rc; i++) {
+            Free_Buffer(OutBuffers.First());
+            OutBuffers.Next();
+        }
+
+        if (rc < count) {
+            break;
+        }
+    }
+#else
+    struct sockaddr_in addr;
+
+    while (OutBuffers.Count != 0) {
+        WinsockBufferType* packet = OutBuffers.First();
+
+        /*
+        ** Set up the address structure of the outgoing packet
+        */
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = hton16(PlanetWestwoodPortNumber);
+        memcpy(&addr.sin_addr.s_addr, packet->Address + 4, 4);
+
+        /*
+        ** Send it.
+        ** If we get a WSAWOULDBLOCK error it means that Winsock is unable to accept the packet
+        ** at this time. In this case, we clear the socket error and just exit.
+        */
+        int rc = sendto(Socket, (const char*)packet->Buffer, packet->BufferLen, 0, (sockaddr*)&addr, sizeof(addr));
+
+        if (rc == SOCKET_ERROR) {
+            if (LastSocketError != WSAEWOULDBLOCK) {
+                Clear_Socket_Error(Socket);
+            }
+            break;
+        }
+
+        /*
+        ** Release the sent packet.
+        */
+        OutBuffers.Next();
+        Free_Buffer(packet);
+    }
+#endif
+}
 #endif
 
 #endif // NETWORKING
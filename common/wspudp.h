@@ -68,6 +68,12 @@ public:
     };
 
 private:
+    void Queue_Packet(WinsockBufferType* packet, int length, struct sockaddr_in const& addr);
+#if !defined _WIN32 || defined SDL_BUILD
+    void Receive_Packets(void);
+    void Send_Packets(void);
+#endif
+
     /*
     ** Address to use when broadcasting a packet.
     */
@@ -0,0 +1,22 @@
+#include "wwkeyboard_null.h"
+
+WWKeyboardClassNull::~WWKeyboardClassNull()
+{
+}
+
+/*
+** There is no window system behind the null video backend, so there is never any input to collect.
+*/
+void WWKeyboardClassNull::Fill_Buffer_From_System(void)
+{
+}
+
+KeyASCIIType WWKeyboardClassNull::To_ASCII(unsigned short key)
+{
+    return KA_NONE;
+}
+
+WWKeyboardClass* CreateWWKeyboardClass(void)
+{
+    return new WWKeyboardClassNull;
+}
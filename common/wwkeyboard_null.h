@@ -0,0 +1,11 @@
+#pragma once
+#include "wwkeyboard.h"
+
+class WWKeyboardClassNull : public WWKeyboardClass
+{
+public:
+    virtual ~WWKeyboardClassNull();
+
+    virtual void Fill_Buffer_From_System(void);
+    virtual KeyASCIIType To_ASCII(unsigned short key);
+};
@@ -33,6 +33,9 @@
  *   BufferPipe::Put -- Submit data to the buffered pipe segment.                              *
  *   FilePipe::Put -- Submit a block of data to the pipe.                                      *
  *   FilePipe::End -- End the file pipe handler.                                               *
+ *   SnapshotPipe::Clear -- Discards the stored data.                                          *
+ *   SnapshotPipe::Put -- Stores a block of data in memory.                                    *
+ *   SnapshotPipe::Write_To -- Sends the stored data on to another pipe.                       *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "wwfile.h"
@@ -156,3 +159,92 @@ int FilePipe::Put(void const* source, int slen)
     }
     return (0);
 }
+
+//---------------------------------------------------------------------------------------------------------
+// SnapshotPipe
+//---------------------------------------------------------------------------------------------------------
+
+/***********************************************************************************************
+ * SnapshotPipe::Put -- Stores a block of data in memory.                                      *
+ *                                                                                             *
+ *    The data is copied into the last memory block, and new blocks are added as they fill     *
+ *    up. Nothing flows on to the next pipe until Write_To is called.                          *
+ *                                                                                             *
+ * INPUT:   source   -- Pointer to the data to store.                                          *
+ *                                                                                             *
+ *          length   -- The number of bytes to store.                                          *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of bytes stored.                                           *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int SnapshotPipe::Put(void const* source, int slen)
+{
+    char const* from = (char const*)source;
+    int left = slen;
+
+    while (left > 0) {
+        if (Last == NULL || Last->Used == BLOCK_SIZE) {
+            BlockType* block = new BlockType;
+            block->Next = NULL;
+            block->Used = 0;
+            if (Last != NULL) {
+                Last->Next = block;
+            } else {
+                First = block;
+            }
+            Last = block;
+        }
+
+        int size = BLOCK_SIZE - Last->Used;
+        if (size > left) {
+            size = left;
+        }
+        memcpy(&Last->Data[Last->Used], from, size);
+        Last->Used += size;
+        from += size;
+        left -= size;
+    }
+    return (slen);
+}
+
+/***********************************************************************************************
+ * SnapshotPipe::Write_To -- Sends the stored data on to another pipe.                         *
+ *                                                                                             *
+ * INPUT:   pipe  -- The pipe to receive the data, in the order it was stored.                 *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The stored data is kept, call Clear to release it.                              *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void SnapshotPipe::Write_To(Pipe& pipe) const
+{
+    for (BlockType const* block = First; block != NULL; block = block->Next) {
+        pipe.Put(block->Data, block->Used);
+    }
+}
+
+/***********************************************************************************************
+ * SnapshotPipe::Clear -- Discards the stored data.                                            *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void SnapshotPipe::Clear(void)
+{
+    while (First != NULL) {
+        BlockType* next = First->Next;
+        delete First;
+        First = next;
+    }
+    Last = NULL;
+}
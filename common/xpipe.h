@@ -109,4 +109,46 @@ private:
     FilePipe& operator=(FilePipe const& pipe) = delete;
 };
 
+/*
+**	This is a store-into-memory pipe terminator that grows as needed. The data can be sent on
+**	to another pipe later, for example from another thread, exactly as it was submitted.
+*/
+class SnapshotPipe : public Pipe
+{
+public:
+    SnapshotPipe(void)
+        : First(NULL)
+        , Last(NULL)
+    {
+    }
+    virtual ~SnapshotPipe(void)
+    {
+        Clear();
+    }
+
+    virtual int Put(void const* source, int slen);
+
+    void Write_To(Pipe& pipe) const;
+    void Clear(void);
+
+private:
+    enum
+    {
+        BLOCK_SIZE = 256 * 1024
+    };
+
+    struct BlockType
+    {
+        BlockType* Next;
+        int Used;
+        char Data[BLOCK_SIZE];
+    };
+
+    BlockType* First;
+    BlockType* Last;
+
+    SnapshotPipe(SnapshotPipe& rvalue) = delete;
+    SnapshotPipe& operator=(SnapshotPipe const& pipe) = delete;
+};
+
 #endif
@@ -211,6 +211,8 @@ void AircraftClass::operator delete(void* ptr)
     if (ptr) {
         ((AircraftClass*)ptr)->IsActive = false;
     }
+    TechnoState.Remove(RTTI_AIRCRAFT, Aircraft.ID((AircraftClass*)ptr));
+    StateHash.Remove(RTTI_AIRCRAFT, Aircraft.ID((AircraftClass*)ptr));
     Aircraft.Free((AircraftClass*)ptr);
 }
 
@@ -263,6 +265,8 @@ AircraftClass::AircraftClass(AircraftType classid, HousesType house)
     //	if (/*classid != AIRCRAFT_CARGO && */ Session.Type == GAME_INTERNET) {
     //		House->AircraftTotals->Increment_Unit_Total((int)classid);
     //	}
+
+    TechnoState.Update(this);
 }
 
 /***********************************************************************************************
@@ -4319,6 +4323,7 @@ bool AircraftClass::Edge_Of_World_AI(void)
         }
     } else {
         IsLocked = true;
+        TechnoState.Update(this);
     }
     return (false);
 }
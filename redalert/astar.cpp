@@ -0,0 +1,314 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "function.h"
+
+/*
+** A* path engine.
+**
+** This is an alternative to the line of sight and edge following search in FINDPATH.CPP. It is
+** selected with "AStarPath=yes" in the [General] section of the rules. The search is a plain
+** 8-connected A* over map cells using the same Passable_Cell() costs as the original engine and
+** it produces the same FacingType move list, so Optimize_Moves() and the callers are unchanged.
+**
+** The movement zones maintained by MapClass::Zone_Reset() form the upper level of the search.
+** Zones are connected regions, so when the destination lies in a different zone to the unit
+** there is no point in searching for it. The destination is moved to the closest cell in the
+** unit's own zone instead, which stops the search from flooding the whole zone every time a
+** unit is ordered somewhere it can never reach.
+**
+** All the search state lives in pools sized to the map, in the PathScratchType of the current
+** simulation context. Each search stamps the nodes it touches with a generation number, so
+** nothing needs to be cleared between searches.
+*/
+
+/*
+**	The maximum number of cells that a single search will expand before giving up and using
+**	the closest approach found so far.
+*/
+#define ASTAR_MAX_EXPANDED 4096
+
+/*
+**	Estimated remaining cost. Every move costs at least one and diagonal moves cost the same as
+**	straight moves, so the larger of the two axis distances never overestimates.
+*/
+static inline int AStar_Estimate(CELL cell, CELL dest)
+{
+    int dx = ABS(Cell_X(cell) - Cell_X(dest));
+    int dy = ABS(Cell_Y(cell) - Cell_Y(dest));
+    return (max(dx, dy));
+}
+
+/*
+**	Heap ordering. Lower total score wins, ties go to the cell that is further along its
+**	route since it is more likely to be close to the goal.
+*/
+static inline bool AStar_Before(PathScratchType const& scratch, int a, int b)
+{
+    if (scratch.OpenScore[a] != scratch.OpenScore[b]) {
+        return (scratch.OpenScore[a] < scratch.OpenScore[b]);
+    }
+    return (scratch.Nodes[scratch.OpenHeap[a]].Cost > scratch.Nodes[scratch.OpenHeap[b]].Cost);
+}
+
+static inline void AStar_Swap(PathScratchType& scratch, int a, int b)
+{
+    CELL cell = scratch.OpenHeap[a];
+    unsigned short score = scratch.OpenScore[a];
+    scratch.OpenHeap[a] = scratch.OpenHeap[b];
+    scratch.OpenScore[a] = scratch.OpenScore[b];
+    scratch.OpenHeap[b] = cell;
+    scratch.OpenScore[b] = score;
+    scratch.Nodes[scratch.OpenHeap[a]].HeapIndex = a;
+    scratch.Nodes[scratch.OpenHeap[b]].HeapIndex = b;
+}
+
+static void AStar_Up(PathScratchType& scratch, int index)
+{
+    while (index > 0) {
+        int parent = (index - 1) >> 1;
+        if (!AStar_Before(scratch, index, parent)) {
+            break;
+        }
+        AStar_Swap(scratch, index, parent);
+        index = parent;
+    }
+}
+
+static void AStar_Down(PathScratchType& scratch, int index)
+{
+    for (;;) {
+        int child = (index << 1) + 1;
+        if (child >= scratch.OpenCount) {
+            break;
+        }
+        if (child + 1 < scratch.OpenCount && AStar_Before(scratch, child + 1, child)) {
+            child++;
+        }
+        if (!AStar_Before(scratch, child, index)) {
+            break;
+        }
+        AStar_Swap(scratch, index, child);
+        index = child;
+    }
+}
+
+static CELL AStar_Pop(PathScratchType& scratch)
+{
+    CELL cell = scratch.OpenHeap[0];
+    scratch.Nodes[cell].HeapIndex = -1;
+    scratch.OpenCount--;
+    if (scratch.OpenCount > 0) {
+        scratch.OpenHeap[0] = scratch.OpenHeap[scratch.OpenCount];
+        scratch.OpenScore[0] = scratch.OpenScore[scratch.OpenCount];
+        scratch.Nodes[scratch.OpenHeap[0]].HeapIndex = 0;
+        AStar_Down(scratch, 0);
+    }
+    return (cell);
+}
+
+static void AStar_Push(PathScratchType& scratch, CELL cell, int score)
+{
+    AStarNodeType& node = scratch.Nodes[cell];
+    if (node.HeapIndex < 0) {
+        node.HeapIndex = scratch.OpenCount;
+        scratch.OpenHeap[scratch.OpenCount] = cell;
+        scratch.OpenScore[scratch.OpenCount] = score;
+        scratch.OpenCount++;
+        AStar_Up(scratch, node.HeapIndex);
+    } else {
+        scratch.OpenScore[node.HeapIndex] = score;
+        AStar_Up(scratch, node.HeapIndex);
+    }
+}
+
+/*
+**	Starts a new search. The node pool is only cleared when the generation counter wraps.
+*/
+static void AStar_Begin(PathScratchType& scratch)
+{
+    scratch.OpenCount = 0;
+    if (++scratch.Generation == 0) {
+        memset(scratch.Nodes, 0, sizeof(scratch.Nodes));
+        scratch.Generation = 1;
+    }
+}
+
+/***********************************************************************************************
+ * FootClass::Find_Path_AStar -- Find a path to the destination using an A* search.            *
+ *                                                                                             *
+ *    This is the A* counterpart of Find_Path(). It takes the same parameters and fills in     *
+ *    the same path structure so the two can be used interchangeably.                          *
+ *                                                                                             *
+ * INPUT:   dest        -- The cell to find a path to.                                         *
+ *                                                                                             *
+ *          final_moves -- The buffer to hold the resulting move list.                         *
+ *                                                                                             *
+ *          maxlen      -- The size of the move list buffer.                                   *
+ *                                                                                             *
+ *          threshhold  -- The most difficult movement restriction that is allowed.            *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the path found. If the destination could not be reached  *
+ *          then the path leads to the closest point that could be reached.                    *
+ *                                                                                             *
+ * WARNINGS:   The path structure returned belongs to the current simulation context and is  *
+ *             only valid until the next search in it.                                         *
+ *=============================================================================================*/
+PathType* FootClass::Find_Path_AStar(CELL dest, FacingType* final_moves, int maxlen, MoveType threshhold)
+{
+    PathScratchType& scratch = SimContextClass::Current()->Path;
+    PathType& path = scratch.Path;
+    CELL source = Coord_Cell(Coord);
+
+    path.Start = source;
+    path.Cost = 0;
+    path.Length = 0;
+    path.Command = final_moves;
+    path.Command[0] = FACING_NONE;
+    path.Overlap = NULL;
+    path.LastOverlap = -1;
+    path.LastFixup = -1;
+
+    /*
+    **	Leave room for the end of list marker as well as the one that Optimize_Moves() adds.
+    */
+    maxlen -= 2;
+    if (maxlen <= 0 || source == dest || !Map.In_Radar(dest)) {
+        return (&path);
+    }
+
+    /*
+    **	When the destination is in a movement zone that the unit can never reach, head for the
+    **	closest cell in the unit's own zone instead.
+    */
+    MZoneType mzone = Techno_Type_Class()->MZone;
+    int zone = Map[source].Zones[mzone];
+    if (zone != 0 && Map[dest].Zones[mzone] != 0 && Map[dest].Zones[mzone] != zone) {
+        CELL nearby = Map.Nearby_Location(dest, Techno_Type_Class()->Speed, zone, mzone);
+        if (nearby != 0 && nearby != source) {
+            dest = nearby;
+        }
+    }
+
+    BStart(BENCH_FINDPATH);
+
+    PathCount++;
+
+    int threat = -1;
+    if (Team && Team->Class->IsRoundAbout) {
+        threat = Team->Risk;
+    }
+
+    /*
+    **	An impassable destination (such as a building being attacked) is reached by moving
+    **	next to it, just like the original path finder.
+    */
+    bool dest_blocked = (Passable_Cell(dest, FACING_NONE, -1, threshhold) == 0);
+
+    CELL best = source;
+    for (;;) {
+        AStar_Begin(scratch);
+
+        AStarNodeType& start = scratch.Nodes[source];
+        start.Generation = scratch.Generation;
+        start.Cost = 0;
+        start.HeapIndex = -1;
+        start.From = FACING_NONE;
+        AStar_Push(scratch, source, AStar_Estimate(source, dest));
+
+        best = source;
+        int best_estimate = AStar_Estimate(source, dest);
+        bool found = false;
+
+        for (int expanded = 0; scratch.OpenCount > 0 && expanded < ASTAR_MAX_EXPANDED; expanded++) {
+            CELL cell = AStar_Pop(scratch);
+            int estimate = AStar_Estimate(cell, dest);
+
+            if (cell == dest || (dest_blocked && estimate == 1)) {
+                best = cell;
+                found = true;
+                break;
+            }
+
+            if (estimate < best_estimate
+                || (estimate == best_estimate && scratch.Nodes[cell].Cost < scratch.Nodes[best].Cost)) {
+                best = cell;
+                best_estimate = estimate;
+            }
+
+            int cost = scratch.Nodes[cell].Cost;
+            for (int index = FACING_N; index < FACING_COUNT; index++) {
+                FacingType face = FacingType(index);
+                CELL next = Adjacent_Cell(cell, face);
+                if (!Map.In_Radar(next)) {
+                    continue;
+                }
+
+                AStarNodeType& node = scratch.Nodes[next];
+                bool fresh = (node.Generation != scratch.Generation);
+                if (!fresh && node.HeapIndex < 0) {
+                    continue;
+                }
+
+                int step = Passable_Cell(next, face, threat, threshhold);
+                if (step == 0) {
+                    continue;
+                }
+
+                int newcost = cost + step;
+                if (fresh) {
+                    node.Generation = scratch.Generation;
+                    node.HeapIndex = -1;
+                } else if (newcost >= node.Cost) {
+                    continue;
+                }
+                node.Cost = newcost;
+                node.From = face;
+                AStar_Push(scratch, next, newcost + AStar_Estimate(next, dest));
+            }
+        }
+
+        /*
+        **	Teams that avoid threats accept whatever risk is necessary rather than not
+        **	reaching the destination at all.
+        */
+        if (found || threat == -1) {
+            break;
+        }
+        threat = -1;
+    }
+
+    /*
+    **	Walk back from the end point to build the move list, then copy as much of
+    **	it as will fit into the caller's buffer.
+    */
+    int count = 0;
+    for (CELL cell = best; cell != source; count++) {
+        FacingType face = scratch.Nodes[cell].From;
+        scratch.MoveList[count] = face;
+        cell = Adjacent_Cell(cell, FacingType(face ^ 4));
+    }
+
+    CELL cell = source;
+    while (count > 0 && path.Length < maxlen) {
+        FacingType face = scratch.MoveList[--count];
+        cell = Adjacent_Cell(cell, face);
+        path.Command[path.Length++] = face;
+        path.Cost += Passable_Cell(cell, face, -1, threshhold);
+    }
+    path.Command[path.Length++] = FACING_NONE;
+
+    Optimize_Moves(&path, threshhold);
+
+    BEnd(BENCH_FINDPATH);
+
+    return (&path);
+}
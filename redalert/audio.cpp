@@ -31,6 +31,7 @@
  *---------------------------------------------------------------------------------------------*
  * Functions:                                                                                  *
  *   Is_Speaking -- Checks to see if the eva voice is still playing.                           *
+ *   Preload_Sound_Effects -- Decodes the common sound effects ahead of time.                  *
  *   Sound_Effect -- General purpose sound player.                                             *
  *   Sound_Effect -- Plays a sound effect in the tactical map.                                 *
  *   Speak -- Computer speaks to the player.                                                   *
@@ -42,6 +43,7 @@
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
+#include "samplecache.h"
 
 /***************************************************************************
 **	Controls what special effects may occur on the sound effect.
@@ -494,6 +496,78 @@ int Sound_Effect(VocType voc, fixed volume, int variation, signed short pan_valu
     return (-1);
 }
 
+#ifndef REMASTER_BUILD
+/*
+**	Keeps the effect just put at the end of the hot list if it is one that can be preloaded and
+**	isn't already in the list, and returns the new length of the list. The list is full at half
+**	the size of the sample cache.
+*/
+static int Add_Hot_Sound(VocType* hot, int count)
+{
+    VocType voc = hot[count];
+    if (count >= SampleCacheClass::MAX_ENTRIES / 2 || voc < VOC_FIRST || voc >= VOC_COUNT
+        || SoundEffectName[voc].Where != IN_NOVAR) {
+        return (count);
+    }
+    for (int index = 0; index < count; index++) {
+        if (hot[index] == voc) {
+            return (count);
+        }
+    }
+    return (count + 1);
+}
+#endif
+
+/***********************************************************************************************
+ * Preload_Sound_Effects -- Decodes the common sound effects ahead of time.                    *
+ *                                                                                             *
+ *    The sounds that the weapons make when they fire and that the explosions and other        *
+ *    animations make when they start are decoded and held by the sample cache, so the first   *
+ *    time each of them plays in a battle costs no more than the later ones. These are the     *
+ *    effects that play over and over in a battle. Only half of the cache is filled this way,  *
+ *    leaving room for the voices and other effects as they come up. Effects that are not in   *
+ *    a cached mixfile are skipped and will be decoded the first time they play.               *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Call this after the rules have been read, since they set the weapon sounds.     *
+ *=============================================================================================*/
+void Preload_Sound_Effects(void)
+{
+#ifndef REMASTER_BUILD
+    if (Debug_Quiet || !SoundOn || SampleType == SAMPLE_NONE) {
+        return;
+    }
+
+    /*
+    **	Gather the hot list, weapons first since they are heard the most.
+    */
+    VocType hot[SampleCacheClass::MAX_ENTRIES / 2 + 1];
+    int count = 0;
+
+    for (int index = 0; index < Weapons.Count(); index++) {
+        hot[count] = Weapons.Ptr(index)->Sound;
+        count = Add_Hot_Sound(hot, count);
+    }
+    for (int anim = ANIM_FIRST; anim < ANIM_COUNT; anim++) {
+        hot[count] = AnimTypeClass::As_Reference((AnimType)anim).Sound;
+        count = Add_Hot_Sound(hot, count);
+    }
+
+    char name[_MAX_FNAME + _MAX_EXT];
+
+    for (int index = 0; index < count; index++) {
+        _makepath(name, NULL, NULL, SoundEffectName[hot[index]].Name, ".AUD");
+        void const* ptr = MFCD::Retrieve(name);
+        if (ptr != NULL) {
+            Preload_Sample(ptr);
+        }
+    }
+#endif
+}
+
 /*
 **	This elaborates all the EVA speech voices.
 */
@@ -30,16 +30,73 @@
  *                                                                                             *
  *---------------------------------------------------------------------------------------------*
  * Functions:                                                                                  *
- *   Benchmark::Begin -- Start the benchmark operation.                                        *
+ *   Bench_Clock -- Fetch a nanosecond time stamp for benchmarking.                            *
  *   Benchmark::Benchmark -- Constructor for the benchmark object.                             *
- *   Benchmark::End -- Mark the end of a benchmarked operation                                 *
+ *   Benchmark::Count -- Fetch the average number of events per frame.                         *
+ *   Benchmark::Frame_Done -- Fold the current frame into the running average.                 *
  *   Benchmark::Reset -- Clear out the benchmark statistics.                                   *
  *   Benchmark::Value -- Fetch the current average benchmark time.                             *
+ *   ProfilerClass::Begin -- Start a benchmarked operation.                                    *
+ *   ProfilerClass::Draw_Overlay -- Draw the per frame timings over the tactical map.          *
+ *   ProfilerClass::End -- Mark the end of a benchmarked operation.                            *
+ *   ProfilerClass::Frame_Done -- Finish off the statistics for a game frame.                  *
+ *   ProfilerClass::Name -- Fetch the display name of a benchmark.                             *
+ *   ProfilerClass::ProfilerClass -- Constructor for the profiler object.                      *
+ *   ProfilerClass::Reset -- Clear out all benchmark statistics.                               *
+ *   ProfilerClass::Start_Trace -- Begin capturing a Chrome trace of the next frames.          *
+ *   ProfilerClass::Write_Trace -- Write the captured trace events to disk.                    *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
-#if (0)
-#include "bench.h"
-#include "mpu.h"
+#include "function.h"
+#include "common/paths.h"
+#include <chrono>
+
+/*
+**	Display names for each of the benchmark types, used by the overlay and trace output.
+*/
+static char const* const BenchNames[BENCH_COUNT] = {
+    "Game Frame",
+    "Find Path",
+    "Greatest Threat",
+    "Object AI",
+    "Cell Draw",
+    "Sidebar",
+    "Radar",
+    "Tactical",
+    "Per Cell Process",
+    "Evaluate Object",
+    "Evaluate Cell",
+    "Evaluate Wall",
+    "Power Bar",
+    "Tabs",
+    "Shroud",
+    "Anims",
+    "Objects",
+    "Palette",
+    "GScreen Render",
+    "Blit Display",
+    "Mission",
+    "Rules",
+    "Scenario",
+};
+
+/***********************************************************************************************
+ * Bench_Clock -- Fetch a nanosecond time stamp for benchmarking.                              *
+ *                                                                                             *
+ *    This is the time source for all benchmarks. The value is only meaningful when compared   *
+ *    to another value returned by this routine.                                               *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns with a monotonic time stamp in nanoseconds.                                *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int64_t Bench_Clock(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
 
 /***********************************************************************************************
  * Benchmark::Benchmark -- Constructor for the benchmark object.                               *
@@ -56,9 +113,16 @@
  *   07/18/1996 JLB : Created.                                                                 *
  *=============================================================================================*/
 Benchmark::Benchmark(void)
-    : Average(0)
+    : FrameTime(0)
+    , FrameCalls(0)
+    , Average(0)
+    , CallAverage(0)
     , Counter(0)
     , TotalCount(0)
+    , PeakTime(0)
+    , Parent(BENCH_COUNT)
+    , Nesting(0)
+    , StartTime(0)
 {
 }
 
@@ -72,90 +136,419 @@ Benchmark::Benchmark(void)
  *                                                                                             *
  * OUTPUT:  none                                                                               *
  *                                                                                             *
- * WARNINGS:   none                                                                            *
+ * WARNINGS:   Any operation that is currently open is unaffected.                             *
  *                                                                                             *
  * HISTORY:                                                                                    *
  *   07/18/1996 JLB : Created.                                                                 *
  *=============================================================================================*/
 void Benchmark::Reset(void)
 {
+    FrameTime = 0;
+    FrameCalls = 0;
     Average = 0;
+    CallAverage = 0;
     Counter = 0;
     TotalCount = 0;
+    PeakTime = 0;
 }
 
 /***********************************************************************************************
- * Benchmark::Begin -- Start the benchmark operation.                                          *
+ * Benchmark::Frame_Done -- Fold the current frame into the running average.                   *
  *                                                                                             *
- *    Call this routine before the operation to be benchmarked is begun. The corresponding     *
- *    End() function must be called after the operation has completed.                         *
+ *    Once a game frame has been completed, the time and number of events accumulated during   *
+ *    that frame are added to the running average. Once the maximum number of frames are       *
+ *    being tracked, the oldest frames gradually drop off.                                     *
  *                                                                                             *
- * INPUT:   reset -- Should the entire benchmark object be reset at this time as well?         *
+ * INPUT:   none                                                                               *
  *                                                                                             *
  * OUTPUT:  none                                                                               *
  *                                                                                             *
- * WARNINGS:   The Begin() and End() functions are NOT nestable.                               *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void Benchmark::Frame_Done(void)
+{
+    if (Counter == MAXIMUM_EVENT_COUNT) {
+        Average -= Average / MAXIMUM_EVENT_COUNT;
+        CallAverage -= CallAverage / MAXIMUM_EVENT_COUNT;
+    } else {
+        Counter++;
+    }
+
+    /*
+    **	Calls are kept in 8.8 fixed point so that infrequent events still decay properly.
+    */
+    Average += FrameTime;
+    CallAverage += FrameCalls << 8;
+
+    if (FrameTime > PeakTime) {
+        PeakTime = FrameTime;
+    }
+
+    FrameTime = 0;
+    FrameCalls = 0;
+}
+
+/***********************************************************************************************
+ * Benchmark::Value -- Fetch the current average benchmark time.                               *
+ *                                                                                             *
+ *    This routine will take the data accumulated and return the average time spent in the     *
+ *    benchmarked operation per game frame.                                                    *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns with the average microseconds per frame.                                   *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
  *                                                                                             *
  * HISTORY:                                                                                    *
  *   07/18/1996 JLB : Created.                                                                 *
  *=============================================================================================*/
-void Benchmark::Begin(bool reset)
+unsigned int Benchmark::Value(void) const
 {
-    if (reset)
-        Reset();
-    Clock = 0;
+    if (Counter) {
+        return (unsigned int)(Average / Counter / 1000);
+    }
+    return (0);
 }
 
 /***********************************************************************************************
- * Benchmark::End -- Mark the end of a benchmarked operation                                   *
+ * Benchmark::Count -- Fetch the average number of events per frame.                           *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
  *                                                                                             *
- *    This routine is called at the end of the operation that is being benchmarked. It is      *
- *    important to call this routine as soon as possible after the event being benchmarked     *
- *    has completed.                                                                           *
+ * OUTPUT:  Returns with the average number of times the benchmarked operation was started in  *
+ *          each game frame.                                                                   *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+unsigned int Benchmark::Count(void) const
+{
+    if (Counter) {
+        return ((CallAverage / Counter + 0x80) >> 8);
+    }
+    return (0);
+}
+
+/***********************************************************************************************
+ * ProfilerClass::ProfilerClass -- Constructor for the profiler object.                        *
  *                                                                                             *
  * INPUT:   none                                                                               *
  *                                                                                             *
  * OUTPUT:  none                                                                               *
  *                                                                                             *
- * WARNINGS:   The Being() and End() functions are NOT nestable.                               *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+ProfilerClass::ProfilerClass(void)
+    : Depth(0)
+    , FrameCount(0)
+    , IsOverlay(false)
+    , TraceFrames(0)
+    , TraceOrigin(0)
+{
+    TraceName[0] = '\0';
+}
+
+/***********************************************************************************************
+ * ProfilerClass::Reset -- Clear out all benchmark statistics.                                 *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
  *                                                                                             *
- * HISTORY:                                                                                    *
- *   07/18/1996 JLB : Created.                                                                 *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
  *=============================================================================================*/
-void Benchmark::End(void)
+void ProfilerClass::Reset(void)
 {
-    unsigned int value = Clock;
+    for (int index = BENCH_FIRST; index < BENCH_COUNT; index++) {
+        Marks[index].Reset();
+    }
+    FrameCount = 0;
+}
 
-    if (Counter == MAXIMUM_EVENT_COUNT) {
-        Average -= Average / MAXIMUM_EVENT_COUNT;
-        Average += value;
-    } else {
-        Average += value;
-        Counter++;
+/***********************************************************************************************
+ * ProfilerClass::Name -- Fetch the display name of a benchmark.                               *
+ *                                                                                             *
+ * INPUT:   bench -- The benchmark to fetch the name of.                                       *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the name of the benchmark.                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+char const* ProfilerClass::Name(BenchType bench)
+{
+    if (bench < BENCH_COUNT) {
+        return (BenchNames[bench]);
     }
-    TotalCount++;
+    return ("");
 }
 
 /***********************************************************************************************
- * Benchmark::Value -- Fetch the current average benchmark time.                               *
+ * ProfilerClass::Begin -- Start a benchmarked operation.                                      *
+ *                                                                                             *
+ *    Call this routine before the operation to be benchmarked is begun. The corresponding     *
+ *    End() function must be called after the operation has completed. The benchmark that is   *
+ *    currently open becomes the parent of this one, which is what gives the hierarchy shown   *
+ *    in the overlay.                                                                          *
+ *                                                                                             *
+ * INPUT:   bench -- The benchmark that is starting.                                           *
  *                                                                                             *
- *    This routine will take the statistics already accumulated and determine the average      *
- *    time recorded. This value will be returned.                                              *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void ProfilerClass::Begin(BenchType bench)
+{
+    int64_t now = Bench_Clock();
+    Benchmark& b = Marks[bench];
+
+    if (Depth == 0) {
+        b.Parent = BENCH_COUNT;
+    } else if (Depth <= MAXIMUM_DEPTH && Stack[Depth - 1] != bench) {
+        b.Parent = Stack[Depth - 1];
+    }
+
+    /*
+    **	Recursive calls only count as events, the time is taken from the outermost call.
+    */
+    if (b.Nesting++ == 0) {
+        b.StartTime = now;
+    }
+    b.FrameCalls++;
+    b.TotalCount++;
+
+    if (Depth < MAXIMUM_DEPTH) {
+        Stack[Depth] = bench;
+        StackStart[Depth] = now;
+    }
+    Depth++;
+}
+
+/***********************************************************************************************
+ * ProfilerClass::End -- Mark the end of a benchmarked operation.                              *
+ *                                                                                             *
+ *    Call this routine when the operation being benchmarked has completed. Any operation      *
+ *    that was started after this one and never ended (such as a function that returned        *
+ *    early) is closed off at the same time. When the whole game frame benchmark ends, the     *
+ *    frame statistics are finalised.                                                          *
+ *                                                                                             *
+ * INPUT:   bench -- The benchmark that has completed.                                         *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   If there is no matching Begin() then this routine does nothing.                 *
+ *=============================================================================================*/
+void ProfilerClass::End(BenchType bench)
+{
+    int64_t now = Bench_Clock();
+
+    int level = Depth - 1;
+    while (level >= 0 && (level >= MAXIMUM_DEPTH || Stack[level] != bench)) {
+        level--;
+    }
+    if (level < 0) {
+        return;
+    }
+
+    while (Depth > level) {
+        Depth--;
+        if (Depth >= MAXIMUM_DEPTH) {
+            continue;
+        }
+
+        BenchType closing = Stack[Depth];
+        Benchmark& b = Marks[closing];
+        if (b.Nesting > 0 && --b.Nesting == 0) {
+            b.FrameTime += now - b.StartTime;
+        }
+
+        if (TraceFrames > 0 && TraceEvents.size() < MAXIMUM_TRACE_EVENTS) {
+            TraceEventType event;
+            event.Start = StackStart[Depth] - TraceOrigin;
+            event.Duration = now - StackStart[Depth];
+            event.Bench = closing;
+            TraceEvents.push_back(event);
+        }
+    }
+
+    if (bench == BENCH_GAME_FRAME) {
+        Frame_Done();
+    }
+}
+
+/***********************************************************************************************
+ * ProfilerClass::Frame_Done -- Finish off the statistics for a game frame.                    *
+ *                                                                                             *
+ *    Folds the per frame accumulators into the running averages and handles the end of a      *
+ *    trace capture.                                                                           *
  *                                                                                             *
  * INPUT:   none                                                                               *
  *                                                                                             *
- * OUTPUT:  Returns with the average time that all events tracked by this object.              *
+ * OUTPUT:  none                                                                               *
  *                                                                                             *
  * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void ProfilerClass::Frame_Done(void)
+{
+    for (int index = BENCH_FIRST; index < BENCH_COUNT; index++) {
+        Marks[index].Frame_Done();
+    }
+    FrameCount++;
+
+    if (TraceFrames > 0 && --TraceFrames == 0) {
+        Write_Trace();
+    }
+}
+
+/***********************************************************************************************
+ * ProfilerClass::Start_Trace -- Begin capturing a Chrome trace of the next frames.            *
  *                                                                                             *
- * HISTORY:                                                                                    *
- *   07/18/1996 JLB : Created.                                                                 *
+ *    Every benchmarked operation that completes during the next number of game frames is      *
+ *    recorded. When the last frame is done, the events are written out in the Chrome trace    *
+ *    event format so they can be inspected with chrome://tracing or Perfetto.                 *
+ *                                                                                             *
+ * INPUT:   frames   -- The number of game frames to capture. filename -- The name of the file *
+ *          to write, relative to the user data path.                                          *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Starting a new trace discards any trace that is still being captured.           *
  *=============================================================================================*/
-unsigned int Benchmark::Value(void) const
+void ProfilerClass::Start_Trace(int frames, char const* filename)
 {
-    if (Counter) {
-        return (Average / Counter);
+    strncpy(TraceName, filename, sizeof(TraceName) - 1);
+    TraceName[sizeof(TraceName) - 1] = '\0';
+    TraceEvents.clear();
+    TraceOrigin = Bench_Clock();
+    TraceFrames = frames;
+}
+
+/***********************************************************************************************
+ * ProfilerClass::Write_Trace -- Write the captured trace events to disk.                      *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void ProfilerClass::Write_Trace(void)
+{
+    std::string path = PathsClass::Is_Absolute(TraceName) ? std::string(TraceName)
+                                                     : PathsClass::Concatenate_Paths(Paths.User_Path(), TraceName);
+    FILE* fp = fopen(path.c_str(), "wt");
+
+    if (fp != NULL) {
+        fprintf(fp, "{\"traceEvents\":[\n");
+        for (size_t index = 0; index < TraceEvents.size(); index++) {
+            TraceEventType const& event = TraceEvents[index];
+            fprintf(fp,
+                    "%s{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                    index ? ",\n" : "",
+                    Name(event.Bench),
+                    event.Start / 1000.0,
+                    event.Duration / 1000.0);
+        }
+        fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+        fclose(fp);
+    }
+
+    TraceEvents.clear();
+    TraceEvents.shrink_to_fit();
+}
+
+/***********************************************************************************************
+ * ProfilerClass::Draw_Overlay -- Draw the per frame timings over the tactical map.            *
+ *                                                                                             *
+ *    This will display the benchmarks for the various processes that are being tracked as a   *
+ *    tree, each one indented under the process that invoked it. For each process the average  *
+ *    time per frame, the time not spent in any tracked child process, the average number of   *
+ *    calls per frame and the fraction of the whole game frame are shown.                      *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   This draws to the current logic page, so it must be called while the hidden page*
+ *             is being composed.                                                              *
+ *=============================================================================================*/
+void ProfilerClass::Draw_Overlay(void) const
+{
+    static int const _line_height = 8;
+
+    BenchType order[BENCH_COUNT];
+    int indent[BENCH_COUNT];
+    int count = 0;
+
+    /*
+    **	Walk the hierarchy depth first so that children appear below their parents. Only
+    **	benchmarks that saw any use are listed.
+    */
+    BenchType stack[BENCH_COUNT];
+    int level[BENCH_COUNT];
+    int sp = 0;
+    for (int index = BENCH_COUNT - 1; index >= 0; index--) {
+        if (Marks[index].Parent == BENCH_COUNT && Marks[index].Total() > 0) {
+            stack[sp] = BenchType(index);
+            level[sp++] = 0;
+        }
+    }
+    while (sp > 0 && count < BENCH_COUNT) {
+        sp--;
+        BenchType bench = stack[sp];
+        int depth = level[sp];
+        order[count] = bench;
+        indent[count++] = depth;
+        for (int index = BENCH_COUNT - 1; index >= 0; index--) {
+            if (Marks[index].Parent == bench && index != bench && Marks[index].Total() > 0 && sp < BENCH_COUNT
+                && depth < 8) {
+                stack[sp] = BenchType(index);
+                level[sp++] = depth + 1;
+            }
+        }
+    }
+
+    int x = Map.TacPixelX + 2;
+    int y = Map.TacPixelY + 2;
+    int width = 220;
+    int height = (count + 1) * _line_height + 4;
+    int frame = Marks[BENCH_GAME_FRAME].Value();
+
+    LogicPage->Fill_Rect(x, y, x + width, y + height, BLACK);
+
+    Fancy_Text_Print("Process", x + 2, y + 2, &GreyScheme, TBLACK, TPF_6POINT | TPF_NOSHADOW);
+    Fancy_Text_Print("us", x + 130, y + 2, &GreyScheme, TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT);
+    Fancy_Text_Print("self", x + 162, y + 2, &GreyScheme, TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT);
+    Fancy_Text_Print("calls", x + 192, y + 2, &GreyScheme, TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT);
+    Fancy_Text_Print("%", x + 216, y + 2, &GreyScheme, TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT);
+
+    for (int index = 0; index < count; index++) {
+        Benchmark const& b = Marks[order[index]];
+        int line = y + 2 + (index + 1) * _line_height;
+
+        unsigned int self = b.Value();
+        for (int child = BENCH_FIRST; child < BENCH_COUNT; child++) {
+            if (child != order[index] && Marks[child].Parent == order[index]) {
+                unsigned int value = Marks[child].Value();
+                self = (value < self) ? self - value : 0;
+            }
+        }
+
+        int percent = frame > 0 ? (int)((b.Value() * 100) / frame) : 0;
+        if (percent > 100) {
+            percent = 100;
+        }
+
+        Fancy_Text_Print(Name(order[index]),
+                         x + 2 + indent[index] * 6,
+                         line,
+                         &ColorRemaps[PCOLOR_GREEN],
+                         TBLACK,
+                         TPF_6POINT | TPF_NOSHADOW);
+        Fancy_Text_Print(
+            "%u", x + 130, line, &ColorRemaps[PCOLOR_GREEN], TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT, b.Value());
+        Fancy_Text_Print("%u", x + 162, line, &ColorRemaps[PCOLOR_GREEN], TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT, self);
+        Fancy_Text_Print(
+            "%u", x + 192, line, &ColorRemaps[PCOLOR_GREEN], TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT, b.Count());
+        Fancy_Text_Print("%d", x + 216, line, &ColorRemaps[PCOLOR_GREEN], TBLACK, TPF_6POINT | TPF_NOSHADOW | TPF_RIGHT, percent);
     }
-    return (0);
 }
-#endif
\ No newline at end of file
@@ -34,96 +34,72 @@
 
 #ifndef BENCH_H
 #define BENCH_H
-#if (0)
 
-#include "mpu.h"
-#include "ftimer.h"
+#include <stdint.h>
+#include <vector>
 
 /*
-**	The "bool" integral type was defined by the C++ committee in
-**	November of '94. Until the compiler supports this, use the following
-**	definition.
+**	Fetch a high resolution time stamp in nanoseconds. The standard steady clock replaces
+**	the old Pentium specific time stamp counter access, so no calibration of the clock
+**	rate is needed.
 */
-#ifndef __BORLANDC__
-#ifndef TRUE_FALSE_DEFINED
-#define TRUE_FALSE_DEFINED
-enum
-{
-    false = 0,
-    true = 1
-};
-typedef int bool;
-#endif
-#endif
-
-/*
-**	This is a timer access object that will fetch the internal Pentium
-**	clock value.
-*/
-class PentiumTimerClass
-{
-public:
-    unsigned int operator()(void) const
-    {
-        unsigned int h;
-        unsigned int l = Get_CPU_Clock(h);
-        return ((l >> 4) | (h << 28));
-    }
-    operator unsigned int(void) const
-    {
-        unsigned int h;
-        unsigned int l = Get_CPU_Clock(h);
-        return ((l >> 4) | (h << 28));
-    }
-};
+int64_t Bench_Clock(void);
 
 /*
 **	A performance tracking tool object. It is used to track elapsed time. Unlike a simple clock, this
 **	class will keep a running average of the duration. Typical use of this would be to benchmark some
 **	process that occurs multiple times. By benchmarking an average time, inconsistencies in a particular
 **	run can be overcome.
+**
+**	Time and calls are accumulated for the current game frame and then folded into a running average
+**	when the frame completes, so the values reported are per frame rather than per event.
 */
 class Benchmark
 {
 public:
     Benchmark(void);
 
-    void Begin(bool reset = false);
-    void End(void);
-
     void Reset(void);
     unsigned int Value(void) const;
-    unsigned int Count(void) const
+    unsigned int Count(void) const;
+    unsigned int Peak(void) const
+    {
+        return (unsigned int)(PeakTime / 1000);
+    }
+    unsigned int Total(void) const
     {
         return (TotalCount);
     }
 
 private:
+    friend class ProfilerClass;
+
+    void Frame_Done(void);
+
     /*
-    **	The maximum number of events to keep running average of. If
-    **	events exceed this number, then older events drop off the
-    **	accumulated time. This number needs to be as small as
-    **	is reasonable. The larger this number gets, the less magnitude
-    **	that the benchmark timer can handle. Example; At a value of
-    **	256, the magnitude of the timer can only be 24 bits.
+    **	The maximum number of frames to keep running average of. If
+    **	frames exceed this number, then older frames drop off the
+    **	accumulated time.
     */
     enum
     {
-        MAXIMUM_EVENT_COUNT = 256
+        MAXIMUM_EVENT_COUNT = 32
     };
 
     /*
-    **	This is the timer the is used to clock the events.
+    **	Time and number of calls accumulated so far in the current frame.
     */
-    BasicTimerClass<PentiumTimerClass> Clock;
+    int64_t FrameTime;
+    unsigned int FrameCalls;
 
     /*
-    **	The total time off all events tracked so far.
+    **	The total time (in nanoseconds) and calls of all frames tracked so far.
     */
-    unsigned int Average;
+    int64_t Average;
+    unsigned int CallAverage;
 
     /*
-    **	The total number of events tracked so far.
+    **	The total number of frames tracked so far.
     */
     unsigned int Counter;
 
@@ -132,7 +108,104 @@ private:
     **	number of events tracked in the average).
     */
     unsigned int TotalCount;
+
+    /*
+    **	Longest single frame time seen since the last reset.
+    */
+    int64_t PeakTime;
+
+    /*
+    **	The benchmark that was active when this one was last started. This is what gives
+    **	the hierarchy in the overlay and trace output.
+    */
+    BenchType Parent;
+
+    /*
+    **	Recursion depth of this benchmark and the time the outermost level was started.
+    */
+    int Nesting;
+    int64_t StartTime;
+};
+
+/*
+**	The profiler owns one benchmark per tracked subsystem and the stack of currently open
+**	scopes. The BStart/BEnd macros only touch it when it has been allocated, so the cost of
+**	leaving the call sites in a normal build is a single pointer test.
+*/
+class ProfilerClass
+{
+public:
+    ProfilerClass(void);
+
+    void Begin(BenchType bench);
+    void End(BenchType bench);
+    void Reset(void);
+
+    Benchmark const& operator[](BenchType bench) const
+    {
+        return (Marks[bench]);
+    }
+
+    unsigned int Frames(void) const
+    {
+        return (FrameCount);
+    }
+
+    void Show_Overlay(bool show)
+    {
+        IsOverlay = show;
+    }
+    bool Is_Overlay(void) const
+    {
+        return (IsOverlay);
+    }
+    void Draw_Overlay(void) const;
+
+    void Start_Trace(int frames, char const* filename = "profile.json");
+    bool Is_Tracing(void) const
+    {
+        return (TraceFrames > 0);
+    }
+
+    static char const* Name(BenchType bench);
+
+private:
+    void Frame_Done(void);
+    void Write_Trace(void);
+
+    enum
+    {
+        MAXIMUM_DEPTH = 32,
+        MAXIMUM_TRACE_EVENTS = 1000000
+    };
+
+    struct TraceEventType
+    {
+        int64_t Start;
+        int64_t Duration;
+        BenchType Bench;
+    };
+
+    Benchmark Marks[BENCH_COUNT];
+
+    /*
+    **	Stack of benchmarks that are currently open.
+    */
+    BenchType Stack[MAXIMUM_DEPTH];
+    int64_t StackStart[MAXIMUM_DEPTH];
+    int Depth;
+
+    unsigned int FrameCount;
+    bool IsOverlay;
+
+    /*
+    **	Chrome trace capture state. While frames remain to be captured every closed scope
+    **	is recorded, the file is written out when the last frame completes.
+    */
+    int TraceFrames;
+    int64_t TraceOrigin;
+    char TraceName[256];
+    std::vector<TraceEventType> TraceEvents;
 };
 
 #endif
-#endif
\ No newline at end of file
@@ -1631,6 +1631,8 @@ void BuildingClass::operator delete(void* ptr)
     if (ptr) {
         ((BuildingClass*)ptr)->IsActive = false;
     }
+    TechnoState.Remove(RTTI_BUILDING, Buildings.ID((BuildingClass*)ptr));
+    StateHash.Remove(RTTI_BUILDING, Buildings.ID((BuildingClass*)ptr));
     Buildings.Free((BuildingClass*)ptr);
 }
 
@@ -1703,6 +1705,8 @@ BuildingClass::BuildingClass(StructType type, HousesType house)
     //	if (Session.Type == GAME_INTERNET) {
     //		House->BuildingTotals->Increment_Unit_Total( (int) type);
     //	}
+
+    TechnoState.Update(this);
 }
 
 /***********************************************************************************************
@@ -2004,6 +2008,7 @@ int BuildingClass::Exit_Object(TechnoClass* base)
     **	will be considered as to have legally entered the visible map domain.
     */
     base->IsLocked = true;
+    TechnoState.Update(base);
 
     /*
     **	Find a good cell to unload the object to. The object, probably a vehicle
@@ -185,7 +185,7 @@ public:
     /*
     **	This is the saboteur responsible for this building's destruction.
     */
-    TARGET WhomToRepay;
+    TargetRefClass WhomToRepay;
 
     /*
     **	This is a record of the last strength of the building. Every so often,
@@ -199,7 +199,7 @@ public:
     ** of this usage are the advanced tech center, which needs to know
     ** when the sputdoor animation has reached a certain stage.
     */
-    TARGET AnimToTrack;
+    TargetRefClass AnimToTrack;
 
     /*
     **	This is the countdown timer that regulates placement retry logic
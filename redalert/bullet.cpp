@@ -91,6 +91,9 @@ BulletClass::BulletClass(BulletType id,
 {
     Strength = strength;
     Height = FLIGHT_LEVEL;
+    if (payback != NULL) {
+        References.Add(payback->As_Target(), &Payback, payback);
+    }
 }
 
 /***********************************************************************************************
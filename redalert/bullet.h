@@ -41,6 +41,8 @@
 
 class BulletClass : public ObjectClass, public FlyClass, public FuseClass
 {
+    friend class ReferenceIndexClass;
+
 public:
     /*
     **	This specifies exactly what kind of bullet this is. All of the static attributes
@@ -151,7 +153,7 @@ private:
     **	This is the target of the projectile. It is especially significant for those projectiles
     **	that home in on a target.
     */
-    TARGET TarCom;
+    TargetRefClass TarCom;
 
     /*
     **	The speed of this projectile.
@@ -50,6 +50,7 @@
  *   CellClass::Closest_Free_Spot -- returns free spot closest to given coord                  *
  *   CellClass::Concrete_Calc -- Calculates the concrete icon to use for the cell.             *
  *   CellClass::Draw_It -- Draws the cell imagery at the location specified.                   *
+ *   CellClass::Flag_Changed -- Tell the state export that something about the cell changed.   *
  *   CellClass::Flag_Place -- Places a house flag down on the cell.                            *
  *   CellClass::Flag_Remove -- Removes the house flag from the cell.                           *
  *   CellClass::Goodie_Check -- Performs crate discovery logic.                                *
@@ -85,6 +86,10 @@
 #include "sidebarglyphx.h"
 #include "utracker.h"
 
+#ifdef REMASTER_BUILD
+extern void On_Cell_Changed(CELL cell, int changes);
+#endif
+
 /***********************************************************************************************
  * CellClass::CellClass -- Constructor for cell objects.                                       *
  *                                                                                             *
@@ -375,6 +380,8 @@ void CellClass::Redraw_Objects(bool forced)
 
     CELL cell = Cell_Number();
 
+    Flag_Changed(CHANGE_OVERLAY);
+
     if (Map.In_View(cell) && (forced || !Map.Is_Cell_Flagged(cell))) {
 
         /*
@@ -398,6 +405,7 @@ void CellClass::Redraw_Objects(bool forced)
 #endif
                 if (optr->Next != nullptr && !optr->Next->IsActive) {
                     optr->Next = nullptr;
+                    Flag_Changed(CHANGE_OCCUPIER);
                 }
                 optr = optr->Next;
             }
@@ -535,6 +543,9 @@ void CellClass::Recalc_Attributes(void)
 {
     assert((unsigned)Cell_Number() <= MAP_CELL_TOTAL);
 
+    PathCache.Invalidate(Cell_Number());
+    Flag_Changed(CHANGE_OVERLAY);
+
     /*
     **	Special override for interior terrain set so that a non-template or a clear template
     **	is equivalent to impassable rock.
@@ -615,6 +626,8 @@ void CellClass::Occupy_Down(ObjectClass* object)
         object->Next = Cell_Occupier();
         OccupierPtr = object;
     }
+    TechnoGrid.Add(Cell_Number(), object);
+    Flag_Changed(CHANGE_OCCUPIER);
     Map.Radar_Pixel(Cell_Number());
 
     /*
@@ -646,6 +659,7 @@ void CellClass::Occupy_Down(ObjectClass* object)
     switch (object->What_Am_I()) {
     case RTTI_BUILDING:
         Flag.Occupy.Building = true;
+        PathCache.Invalidate(Cell_Number());
         break;
 
     case RTTI_VESSEL:
@@ -656,6 +670,7 @@ void CellClass::Occupy_Down(ObjectClass* object)
 
     case RTTI_TERRAIN:
         Flag.Occupy.Monolith = true;
+        PathCache.Invalidate(Cell_Number());
         break;
 
     default:
@@ -689,12 +704,13 @@ void CellClass::Occupy_Up(ObjectClass* object)
         return;
 
     ObjectClass* optr = Cell_Occupier(); // Working pointer to the objects in the chain.
+    bool found = false;
 
     if (optr == object) {
         OccupierPtr = object->Next;
         object->Next = 0;
+        found = true;
     } else {
-        bool found = false;
         while (optr != NULL) {
             if (optr->Next == object) {
                 optr->Next = object->Next;
@@ -706,6 +722,10 @@ void CellClass::Occupy_Up(ObjectClass* object)
         }
         //		assert(found);
     }
+    if (found) {
+        TechnoGrid.Remove(Cell_Number(), object);
+        Flag_Changed(CHANGE_OCCUPIER);
+    }
     Map.Radar_Pixel(Cell_Number());
 
     /*
@@ -714,6 +734,7 @@ void CellClass::Occupy_Up(ObjectClass* object)
     switch (object->What_Am_I()) {
     case RTTI_BUILDING:
         Flag.Occupy.Building = false;
+        PathCache.Invalidate(Cell_Number());
         break;
 
     case RTTI_VESSEL:
@@ -724,6 +745,7 @@ void CellClass::Occupy_Up(ObjectClass* object)
 
     case RTTI_TERRAIN:
         Flag.Occupy.Monolith = false;
+        PathCache.Invalidate(Cell_Number());
         break;
 
     default:
@@ -1733,6 +1755,7 @@ int CellClass::Reduce_Tiberium(int levels)
         if (OverlayData + 1 > levels) {
             OverlayData -= levels;
             reducer = levels;
+            Flag_Changed(CHANGE_OVERLAY);
         } else {
             Overlay = OVERLAY_NONE;
             reducer = OverlayData;
@@ -1787,6 +1810,7 @@ int CellClass::Reduce_Wall(int damage)
             */
             if (destroyed) {
                 OverlayData += 16;
+                Flag_Changed(CHANGE_OVERLAY);
                 if (damage == -1 || (OverlayData >> 4) >= wall.DamageLevels
                     || ((OverlayData >> 4) == wall.DamageLevels - 1 && (OverlayData & 0xF) == 0)) {
 
@@ -3258,11 +3282,15 @@ bool CellClass::Can_Tiberium_Germinate(void) const
 void CellClass::Set_Mapped(HousesType house, bool set)
 {
     int shift = (int)house;
+    unsigned int mask = IsMappedByPlayerMask;
     if (set) {
         IsMappedByPlayerMask |= (1 << shift);
     } else {
         IsMappedByPlayerMask &= ~(1 << shift);
     }
+    if (IsMappedByPlayerMask != mask) {
+        Flag_Changed(CHANGE_MAPPED);
+    }
 }
 
 /***********************************************************************************************
@@ -3320,11 +3348,15 @@ bool CellClass::Is_Mapped(HouseClass* player) const
 void CellClass::Set_Visible(HousesType house, bool set)
 {
     int shift = (int)house;
+    unsigned int mask = IsVisibleByPlayerMask;
     if (set) {
         IsVisibleByPlayerMask |= (1 << shift);
     } else {
         IsVisibleByPlayerMask &= ~(1 << shift);
     }
+    if (IsVisibleByPlayerMask != mask) {
+        Flag_Changed(CHANGE_VISIBLE);
+    }
 }
 
 /***********************************************************************************************
@@ -3386,6 +3418,27 @@ bool CellClass::Is_Jamming(HouseClass* player) const
     return false;
 }
 
+/***********************************************************************************************
+ * CellClass::Flag_Changed -- Tell the state export that something about the cell changed.     *
+ *                                                                                             *
+ *    The DLL only sends the per-cell states of cells flagged here since it last sent them.    *
+ *    Calling this when nothing really changed only costs a look at the cell.                  *
+ *                                                                                             *
+ * INPUT:   changes  -- What changed, a combination of the ChangeType bits.                    *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Does nothing outside the DLL build.                                             *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void CellClass::Flag_Changed(int changes) const
+{
+#ifdef REMASTER_BUILD
+    On_Cell_Changed(Cell_Number(), changes);
+#endif
+}
+
 void CellClass::Override_Land_Type(LandType type)
 {
     OverrideLand = type;
@@ -339,6 +339,19 @@ public:
     void Redraw_Objects(bool forced = false);
     void Shimmer(void);
 
+    /*
+    **	Tells the DLL state export what about this cell changed, so that it only has to look at
+    **	cells that did.
+    */
+    enum ChangeType
+    {
+        CHANGE_MAPPED = 0x01,   // Mapped for some player.
+        CHANGE_VISIBLE = 0x02,  // Visible or jammed for some player.
+        CHANGE_OCCUPIER = 0x04, // Occupier list.
+        CHANGE_OVERLAY = 0x08   // Overlay, smudge, flag or owner, or anything else that needs a redraw.
+    };
+    void Flag_Changed(int changes) const;
+
     /*
     **	Maintenance calculation support.
     */
@@ -319,6 +319,29 @@ void Debug_Key(unsigned input)
             }
             break;
 
+        /*
+        **	Toggles the on screen profiler display. The profiler is created on first use
+        **	if it wasn't requested on the command line.
+        */
+        case KN_F8:
+            if (Benches == NULL) {
+                Benches = new ProfilerClass;
+            }
+            Benches->Show_Overlay(!Benches->Is_Overlay());
+            Map.Flag_To_Redraw(true);
+            break;
+
+        /*
+        **	Captures a trace of the next few seconds of play to "profile.json" in the
+        **	user data directory.
+        */
+        case ((int)KN_F8 | (int)KN_SHIFT_BIT):
+            if (Benches == NULL) {
+                Benches = new ProfilerClass;
+            }
+            Benches->Start_Trace(300);
+            break;
+
         case ((int)KN_F4 | (int)KN_CTRL_BIT):
             Debug_Unshroud = (Debug_Unshroud == false);
             Map.Flag_To_Redraw(true);
@@ -349,26 +372,21 @@ void Debug_Key(unsigned input)
  *=============================================================================================*/
 static char const* Bench_Time(BenchType btype)
 {
-#if 0
     static char buffer[32];
 
-    int rootcount = Benches[BENCH_GAME_FRAME].Count();
-    if (rootcount == 0)
-        rootcount = 1;
-    int roottime = Benches[BENCH_GAME_FRAME].Value();
-    int count = Benches[btype].Count();
-    int time = Benches[btype].Value();
-    if (count > 0 && count * time > roottime * rootcount)
-        time = roottime / count;
+    int roottime = (*Benches)[BENCH_GAME_FRAME].Value();
+    int count = (*Benches)[btype].Count();
+    int time = (*Benches)[btype].Value();
     int percent = 0;
-    if (roottime != 0 && rootcount != 0) {
-        percent = ((count * time) * 99) / (roottime * rootcount);
+    if (roottime != 0) {
+        percent = (time * 99) / roottime;
     }
     if (percent > 99)
         percent = 99;
+    if (count > 1)
+        time = time / count;
     sprintf(buffer, "%-2d%% %7d", percent, time);
     return (buffer);
-#endif
 }
 
 /***********************************************************************************************
@@ -391,7 +409,6 @@ static char const* Bench_Time(BenchType btype)
  *=============================================================================================*/
 static void Benchmarks(MonoClass* mono)
 {
-#if 0
     static bool _first = true;
     if (_first) {
         _first = false;
@@ -450,16 +467,10 @@ static void Benchmarks(MonoClass* mono)
         mono->Printf("%s", Bench_Time(BENCH_BLIT_DISPLAY));
 
         mono->Set_Cursor(66, 2);
-        mono->Printf("%7d", Benches[BENCH_RULES].Value());
+        mono->Printf("%7d", (*Benches)[BENCH_RULES].Value());
         mono->Set_Cursor(66, 4);
-        mono->Printf("%7d", Benches[BENCH_SCENARIO].Value());
-
-        for (BenchType index = BENCH_FIRST; index < BENCH_COUNT; index++) {
-            if (index != BENCH_RULES && index != BENCH_SCENARIO)
-                Benches[index].Reset();
-        }
+        mono->Printf("%7d", (*Benches)[BENCH_SCENARIO].Value());
     }
-#endif
 }
 
 /***********************************************************************************************
@@ -2810,17 +2810,12 @@ typedef enum BenchType : unsigned char
     BENCH_FIRST = 0
 } BenchType;
 
-#if 0
 #define BStart(a)                                                                                                      \
     if (Benches != NULL)                                                                                               \
-    Benches[a].Begin()
+    Benches->Begin(a)
 #define BEnd(a)                                                                                                        \
     if (Benches != NULL)                                                                                               \
-    Benches[a].End()
-#else
-#define BStart(a)
-#define BEnd(a)
-#endif
+    Benches->End(a)
 
 /**********************************************************************
 **	Working MCGA colors that give a pleasing effect for beveled edges and
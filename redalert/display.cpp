@@ -4996,6 +4996,7 @@ void DisplayClass::Flag_Cell(CELL cell)
     Flag_To_Redraw(false);
     IsToRedraw = true;
     CellRedraw[cell] = true;
+    (*this)[cell].Flag_Changed(CellClass::CHANGE_OVERLAY);
 }
 
 static ActionType _priority_actions[] =
@@ -145,6 +145,11 @@ extern "C" __declspec(dllexport) bool __cdecl CNC_Get_Game_State(GameStateReques
                                                                  uint64 player_id,
                                                                  unsigned char* buffer_in,
                                                                  unsigned int buffer_size);
+extern "C" __declspec(dllexport) bool __cdecl CNC_Get_Game_State_Delta(GameStateRequestEnum state_type,
+                                                                       uint64 player_id,
+                                                                       unsigned int base_sequence,
+                                                                       unsigned char* buffer_in,
+                                                                       unsigned int buffer_size);
 extern "C" __declspec(dllexport) bool __cdecl CNC_Read_INI(int scenario_index,
                                                            int scenario_variation,
                                                            int scenario_direction,
@@ -284,7 +289,7 @@ public:
     static void Team_Units_Formation_Toggle_On(uint64 player_id);
     static void Units_Queued_Movement_Toggle(uint64 player_id, bool toggle);
 
-    static void Cell_Class_Draw_It(CNCDynamicMapStruct* dynamic_map,
+    static void Cell_Class_Draw_It(CNCDynamicMapEntryStruct* entries,
                                    int& entry_index,
                                    CellClass* cell_ptr,
                                    int xpixel,
@@ -294,6 +299,12 @@ public:
     static bool Get_Shroud_State(uint64 player_id, unsigned char* buffer_in, unsigned int buffer_size);
     static bool Get_Occupier_State(uint64 player_id, unsigned char* buffer_in, unsigned int buffer_size);
     static bool Get_Player_Info_State(uint64 player_id, unsigned char* buffer_in, unsigned int buffer_size);
+    static bool Get_State_Delta(GameStateRequestEnum state_type,
+                                uint64 player_id,
+                                unsigned int base_sequence,
+                                unsigned char* buffer_in,
+                                unsigned int buffer_size);
+    static void Flag_Cell_Changed(CELL cell, int changes);
 
     static void Set_Event_Callback(CNC_Event_Callback_Type event_callback)
     {
@@ -404,6 +415,22 @@ private:
 
     static void Calculate_Placement_Distances(BuildingTypeClass* placement_type, unsigned char* placement_distance);
 
+    static void Get_Export_Cell_Rect(int& map_cell_x, int& map_cell_y, int& map_cell_width, int& map_cell_height);
+    static void Apply_Gap_Shroud(void);
+    static void Unapply_Gap_Shroud(void);
+    static void Get_Shroud_Entry(CELL cell, CNCShroudEntryStruct& shroud_entry);
+    static int Get_Occupier_Entry(CELL cell, CNCOccupierObjectStruct* occupier, unsigned int room);
+    static void Get_Dynamic_Map_Entries(CELL cell,
+                                        CNCDynamicMapEntryStruct* entries,
+                                        int& entry_index,
+                                        bool debug_output = false);
+    static bool Get_Layer_State_Delta(uint64 player_id,
+                                      int player_index,
+                                      unsigned int base_sequence,
+                                      unsigned char* buffer_in,
+                                      unsigned int buffer_size);
+    static void Reset_State_Deltas(void);
+
     static int CurrentDrawCount;
     static int TotalObjectCount;
     static int SortOrder;
@@ -436,6 +463,66 @@ private:
     ** Mod directories
     */
     static DynamicVectorClass<char*> ModSearchPaths;
+
+    /*
+    ** What was last sent to each player by Get_State_Delta, for the shroud, occupier and dynamic map states, and
+    ** which cells may have changed since. The change flags are set through CellClass::Flag_Changed and are not
+    ** saved; a started or loaded game begins with full updates.
+    */
+    enum
+    {
+        DELTA_STATE_SHROUD,
+        DELTA_STATE_OCCUPIER,
+        DELTA_STATE_DYNAMIC_MAP,
+        DELTA_STATE_COUNT,
+
+        MAX_CELL_DYNAMIC_ENTRIES = 3 // Smudge, overlay and flag.
+    };
+
+    struct StateDeltaType
+    {
+        unsigned int Sequence; // 0 if nothing valid was sent.
+        int MapCellX;
+        int MapCellY;
+        int MapCellWidth;
+        int MapCellHeight;
+        bool IsUnshrouded;
+        unsigned int CellCRC[MAP_CELL_TOTAL];      // Check value of each cell's entries, 0 if it had none.
+        unsigned int Changed[MAP_CELL_TOTAL / 32]; // One bit for each cell that may have changed.
+    };
+
+    static StateDeltaType StateDeltas[MAX_PLAYERS][DELTA_STATE_COUNT];
+    static unsigned int DeltaSequence;
+
+    /*
+    ** What was last sent to each player by Get_State_Delta for the layer state, as a check value for each object
+    ** sorted by type and ID. The layer state is made into LayerScratch first and its entries sorted by object
+    ** through LayerEntries, then the new check values are made in LayerDeltaNext and swapped in once sent.
+    */
+    struct LayerKeyType
+    {
+        int Type;
+        int ID;
+        int Value; // Entry in the layer state while sorting, check value of the object's entries once sent.
+    };
+
+    struct LayerDeltaType
+    {
+        unsigned int Sequence; // 0 if nothing valid was sent.
+        int Count;
+        int Max;
+        LayerKeyType* Objects;
+    };
+
+    static LayerDeltaType LayerDeltas[MAX_PLAYERS];
+    static LayerDeltaType LayerDeltaNext;
+    static LayerKeyType* LayerEntries;
+    static int LayerEntryMax;
+    static unsigned char* LayerScratch;
+    static unsigned int LayerScratchSize;
+
+    static int Compare_Layer_Keys(LayerKeyType const& key1, LayerKeyType const& key2);
+    static int Compare_Layer_Entries(void const* ptr1, void const* ptr2);
 };
 
 /*
@@ -458,6 +545,14 @@ CELL DLLExportClass::MultiplayerStartPositions[MAX_PLAYERS];
 BuildingTypeClass* DLLExportClass::PlacementType[MAX_PLAYERS];
 unsigned char DLLExportClass::PlacementDistance[MAX_PLAYERS][MAP_CELL_TOTAL];
 unsigned char DLLExportClass::SpecialKeyFlags[MAX_PLAYERS] = {0U};
+DLLExportClass::StateDeltaType DLLExportClass::StateDeltas[MAX_PLAYERS][DELTA_STATE_COUNT];
+unsigned int DLLExportClass::DeltaSequence = 0;
+DLLExportClass::LayerDeltaType DLLExportClass::LayerDeltas[MAX_PLAYERS];
+DLLExportClass::LayerDeltaType DLLExportClass::LayerDeltaNext;
+DLLExportClass::LayerKeyType* DLLExportClass::LayerEntries = NULL;
+int DLLExportClass::LayerEntryMax = 0;
+unsigned char* DLLExportClass::LayerScratch = NULL;
+unsigned int DLLExportClass::LayerScratchSize = 0;
 DynamicVectorClass<char*> DLLExportClass::ModSearchPaths;
 std::set<int64> DLLExportClass::MessagesSent;
 bool DLLExportClass::GameOver = false;
@@ -664,6 +759,11 @@ void GlyphX_Debug_Print(const char* debug_text)
     DLLExportClass::On_Debug_Output(debug_text);
 }
 
+void On_Cell_Changed(CELL cell, int changes)
+{
+    DLLExportClass::Flag_Cell_Changed(cell, changes);
+}
+
 void On_Achievement_Event(const HouseClass* player_ptr, const char* achievement_type, const char* achievement_reason)
 {
     DLLExportClass::On_Achievement(player_ptr, achievement_type, achievement_reason);
@@ -3287,6 +3387,29 @@ extern "C" __declspec(dllexport) bool __cdecl CNC_Get_Game_State(GameStateReques
     return got_state;
 }
 
+/**************************************************************************************************
+ * CNC_Get_Game_State_Delta -- Get the changes to a per-cell or layer game state
+ *
+ * In:   Type of state requested, shroud, occupier, dynamic map or layers
+ *       Player perspective
+ *       Sequence of the last state the caller has, 0 if none
+ *       Buffer to contain the changes
+ *       Size of buffer
+ *
+ * Out:  Cells or objects changed since the state with the sequence given, or a full update
+ *
+ *
+ *
+ **************************************************************************************************/
+extern "C" __declspec(dllexport) bool __cdecl CNC_Get_Game_State_Delta(GameStateRequestEnum state_type,
+                                                                       uint64 player_id,
+                                                                       unsigned int base_sequence,
+                                                                       unsigned char* buffer_in,
+                                                                       unsigned int buffer_size)
+{
+    return DLLExportClass::Get_State_Delta(state_type, player_id, base_sequence, buffer_in, buffer_size);
+}
+
 /**************************************************************************************************
  * CNC_Handle_Game_Request
  *
@@ -6032,21 +6155,7 @@ bool DLLExportClass::Get_Shroud_State(uint64 player_id, unsigned char* buffer_in
         return false;
     }
 
-    /*
-    ** Apply mobile gap generators
-    */
-    static unsigned int _shroud_bits[UNIT_MAX];
-
-    if (GAME_TO_PLAY == GAME_GLYPHX_MULTIPLAYER) {
-        for (int index = 0; index < Units.Count(); index++) {
-            UnitClass* obj = Units.Ptr(index);
-            if (obj->Class->IsGapper && obj->IsActive && obj->Strength) {
-                if (!obj->House->Is_Ally(PlayerPtr)) {
-                    _shroud_bits[index] = obj->Apply_Temporary_Jamming_Shroud(PlayerPtr);
-                }
-            }
-        }
-    }
+    Apply_Gap_Shroud();
 
     CNCShroudStruct* shroud = (CNCShroudStruct*)buffer_in;
 
@@ -6061,79 +6170,111 @@ bool DLLExportClass::Get_Shroud_State(uint64 player_id, unsigned char* buffer_in
     **
     **
     */
-    int map_cell_x = Map.MapCellX;
-    int map_cell_y = Map.MapCellY;
-    int map_cell_width = Map.MapCellWidth;
-    int map_cell_height = Map.MapCellHeight;
-
-    if (map_cell_x > 0) {
-        map_cell_x--;
-        map_cell_width++;
-    }
-
-    if (map_cell_width < MAP_MAX_CELL_WIDTH) {
-        map_cell_width++;
-    }
-
-    if (map_cell_y > 0) {
-        map_cell_y--;
-        map_cell_height++;
-    }
-
-    if (map_cell_height < MAP_MAX_CELL_HEIGHT) {
-        map_cell_height++;
-    }
+    int map_cell_x;
+    int map_cell_y;
+    int map_cell_width;
+    int map_cell_height;
+    Get_Export_Cell_Rect(map_cell_x, map_cell_y, map_cell_width, map_cell_height);
 
     for (int y = 0; y < map_cell_height; y++) {
         for (int x = 0; x < map_cell_width; x++) {
             CELL cell = XY_Cell(map_cell_x + x, map_cell_y + y);
-            COORDINATE coord = Cell_Coord(cell) & 0xFF00FF00;
 
             memory_needed += sizeof(CNCShroudEntryStruct);
             if (memory_needed >= buffer_size) {
+                Unapply_Gap_Shroud();
                 return false;
             }
 
-            int xpixel;
-            int ypixel;
+            Get_Shroud_Entry(cell, shroud->Entries[entry_index]);
 
-            Map.Coord_To_Pixel(coord, xpixel, ypixel);
+            entry_index++;
+        }
+    }
+
+    shroud->Count = entry_index;
 
-            CellClass* cellptr = &Map[Coord_Cell(coord)];
+    Unapply_Gap_Shroud();
 
-            CNCShroudEntryStruct& shroud_entry = shroud->Entries[entry_index];
+    return true;
+}
 
-            shroud_entry.IsVisible = cellptr->Is_Visible(PlayerPtr);
-            shroud_entry.IsMapped = cellptr->Is_Mapped(PlayerPtr);
-            shroud_entry.IsJamming = cellptr->Is_Jamming(PlayerPtr);
-            // shroud_entry.IsVisible = cellptr->IsVisible;
-            // shroud_entry.IsMapped = cellptr->IsMapped;
-            shroud_entry.ShadowIndex = -1;
+/*
+** Which cells each mobile gap generator jammed for the current player context.
+*/
+static unsigned int _gap_shroud_bits[UNIT_MAX];
 
-            if (shroud_entry.IsMapped) {
-                if (!shroud_entry.IsVisible) {
-                    shroud_entry.ShadowIndex = (char)Map.Cell_Shadow(cell, PlayerPtr);
+/**************************************************************************************************
+ * DLLExportClass::Apply_Gap_Shroud -- Apply mobile gap generators to the shroud of the current player
+ *
+ * In:
+ *
+ * Out:
+ *
+ *       Must be undone with Unapply_Gap_Shroud once the shroud has been read.
+ *
+ **************************************************************************************************/
+void DLLExportClass::Apply_Gap_Shroud(void)
+{
+    if (GAME_TO_PLAY == GAME_GLYPHX_MULTIPLAYER) {
+        for (int index = 0; index < Units.Count(); index++) {
+            UnitClass* obj = Units.Ptr(index);
+            if (obj->Class->IsGapper && obj->IsActive && obj->Strength) {
+                if (!obj->House->Is_Ally(PlayerPtr)) {
+                    _gap_shroud_bits[index] = obj->Apply_Temporary_Jamming_Shroud(PlayerPtr);
                 }
             }
-
-            entry_index++;
         }
     }
+}
 
-    shroud->Count = entry_index;
-
+/**************************************************************************************************
+ * DLLExportClass::Unapply_Gap_Shroud -- Take the mobile gap generators back off the shroud
+ *
+ * In:
+ *
+ * Out:
+ *
+ **************************************************************************************************/
+void DLLExportClass::Unapply_Gap_Shroud(void)
+{
     if (GAME_TO_PLAY == GAME_GLYPHX_MULTIPLAYER) {
         for (int index = 0; index < Units.Count(); index++) {
             UnitClass* obj = Units.Ptr(index);
             if (obj->Class->IsGapper && obj->IsActive && obj->Strength) {
                 if (!obj->House->Is_Ally(PlayerPtr)) {
-                    obj->Unapply_Temporary_Jamming_Shroud(PlayerPtr, _shroud_bits[index]);
+                    obj->Unapply_Temporary_Jamming_Shroud(PlayerPtr, _gap_shroud_bits[index]);
                 }
             }
         }
     }
+}
 
-    return true;
+/**************************************************************************************************
+ * DLLExportClass::Get_Shroud_Entry -- Get the shroud of one cell for the current player context
+ *
+ * In:   Cell
+ *       Entry to fill in
+ *
+ * Out:
+ *
+ **************************************************************************************************/
+void DLLExportClass::Get_Shroud_Entry(CELL cell, CNCShroudEntryStruct& shroud_entry)
+{
+    CellClass* cellptr = &Map[cell];
+
+    shroud_entry.IsVisible = cellptr->Is_Visible(PlayerPtr);
+    shroud_entry.IsMapped = cellptr->Is_Mapped(PlayerPtr);
+    shroud_entry.IsJamming = cellptr->Is_Jamming(PlayerPtr);
+    // shroud_entry.IsVisible = cellptr->IsVisible;
+    // shroud_entry.IsMapped = cellptr->IsMapped;
+    shroud_entry.ShadowIndex = -1;
+
+    if (shroud_entry.IsMapped) {
+        if (!shroud_entry.IsVisible) {
+            shroud_entry.ShadowIndex = (char)Map.Cell_Shadow(cell, PlayerPtr);
+        }
+    }
 }
 
 /**************************************************************************************************
@@ -6157,10 +6298,88 @@ bool DLLExportClass::Get_Occupier_State(uint64 player_id, unsigned char* buffer_
 
     unsigned int memory_needed = sizeof(CNCOccupierHeaderStruct);
 
-    int map_cell_x = Map.MapCellX;
-    int map_cell_y = Map.MapCellY;
-    int map_cell_width = Map.MapCellWidth;
-    int map_cell_height = Map.MapCellHeight;
+    int map_cell_x;
+    int map_cell_y;
+    int map_cell_width;
+    int map_cell_height;
+    Get_Export_Cell_Rect(map_cell_x, map_cell_y, map_cell_width, map_cell_height);
+
+    for (int y = 0; y < map_cell_height; y++) {
+        for (int x = 0; x < map_cell_width; x++, occupiers->Count++) {
+            CELL cell = XY_Cell(map_cell_x + x, map_cell_y + y);
+
+            memory_needed += sizeof(CNCOccupierEntryHeaderStruct);
+            if (memory_needed >= buffer_size) {
+                return false;
+            }
+
+            CNCOccupierObjectStruct* occupier = reinterpret_cast<CNCOccupierObjectStruct*>(entry + 1U);
+            entry->Count = Get_Occupier_Entry(cell, occupier, buffer_size - memory_needed - 1);
+            if (entry->Count < 0) {
+                return false;
+            }
+            memory_needed += sizeof(CNCOccupierObjectStruct) * entry->Count;
+
+            entry = reinterpret_cast<CNCOccupierEntryHeaderStruct*>(occupier + entry->Count);
+        }
+    }
+
+    return true;
+}
+
+/**************************************************************************************************
+ * DLLExportClass::Get_Occupier_Entry -- Get the occupiers of one cell
+ *
+ * In:   Cell
+ *       Where to put the occupiers
+ *       Bytes of room there
+ *
+ * Out:  Number of occupiers stored, or -1 if they didn't fit
+ *
+ **************************************************************************************************/
+int DLLExportClass::Get_Occupier_Entry(CELL cell, CNCOccupierObjectStruct* occupier, unsigned int room)
+{
+    CellClass* cellptr = &Map[cell];
+
+    int occupier_count = 0;
+    ObjectClass* optr = cellptr->Cell_Occupier();
+    while (optr != NULL) {
+        occupier_count++;
+        optr = optr->Next;
+    }
+
+    if (sizeof(CNCOccupierObjectStruct) * occupier_count > room) {
+        return -1;
+    }
+
+    optr = cellptr->Cell_Occupier();
+    for (int i = 0; i < occupier_count; i++, occupier++) {
+        CNCObjectStruct object;
+        Convert_Type(optr, object);
+        occupier->Type = object.Type;
+        occupier->ID = object.ID;
+        optr = optr->Next;
+    }
+
+    return occupier_count;
+}
+
+/**************************************************************************************************
+ * DLLExportClass::Get_Export_Cell_Rect -- Get the cells the per-cell states are exported for
+ *
+ * In:
+ *
+ * Out:  The map area, grown by a cell on each side where there is room
+ *
+ *
+ *
+ **************************************************************************************************/
+void DLLExportClass::Get_Export_Cell_Rect(int& map_cell_x, int& map_cell_y, int& map_cell_width, int& map_cell_height)
+{
+    map_cell_x = Map.MapCellX;
+    map_cell_y = Map.MapCellY;
+    map_cell_width = Map.MapCellWidth;
+    map_cell_height = Map.MapCellHeight;
 
     if (map_cell_x > 0) {
         map_cell_x--;
@@ -6179,43 +6398,541 @@ bool DLLExportClass::Get_Occupier_State(uint64 player_id, unsigned char* buffer_
     if (map_cell_height < MAP_MAX_CELL_HEIGHT) {
         map_cell_height++;
     }
+}
 
-    for (int y = 0; y < map_cell_height; y++) {
-        for (int x = 0; x < map_cell_width; x++, occupiers->Count++) {
-            CELL cell = XY_Cell(map_cell_x + x, map_cell_y + y);
-            CellClass* cellptr = &Map[cell];
+/**************************************************************************************************
+ * DLLExportClass::Get_State_Delta -- Get the cells of a state that changed since it was last sent
+ *
+ * In:   Type of state requested, shroud, occupier, dynamic map or layers
+ *       Player perspective
+ *       Sequence of the last state the caller has, 0 if none
+ *       Buffer to contain the changes
+ *       Size of buffer
+ *
+ * Out:  CNCStateDeltaStruct followed by the cells that changed, or for the layers the
+ *       CNCLayerDeltaStruct from Get_Layer_State_Delta
+ *
+ *       Only cells flagged through CellClass::Flag_Changed since the last request are looked at.
+ *       Their entries are made straight into the buffer and compared with a check value kept for
+ *       each cell of what was last sent to this player, so cells flagged without a real change
+ *       are left out again. If the caller doesn't have that state, or the map area changed, all
+ *       cells with entries are sent as a full update instead.
+ *
+ **************************************************************************************************/
+bool DLLExportClass::Get_State_Delta(GameStateRequestEnum state_type,
+                                     uint64 player_id,
+                                     unsigned int base_sequence,
+                                     unsigned char* buffer_in,
+                                     unsigned int buffer_size)
+{
+    int player_index = 0;
+    if (GAME_TO_PLAY != GAME_NORMAL) {
+        while (player_index < MULTIPLAYER_COUNT && GlyphxPlayerIDs[player_index] != player_id) {
+            player_index++;
+        }
+        if (player_index == MULTIPLAYER_COUNT) {
+            return false;
+        }
+    }
+
+    int state_index;
+
+    switch (state_type) {
+    case GAME_STATE_SHROUD:
+        state_index = DELTA_STATE_SHROUD;
+        break;
+
+    case GAME_STATE_OCCUPIER:
+        state_index = DELTA_STATE_OCCUPIER;
+        break;
+
+    case GAME_STATE_DYNAMIC_MAP:
+        state_index = DELTA_STATE_DYNAMIC_MAP;
+        break;
+
+    case GAME_STATE_LAYERS:
+        return Get_Layer_State_Delta(player_id, player_index, base_sequence, buffer_in, buffer_size);
+
+    default:
+        return false;
+    }
+
+    if (buffer_size < sizeof(CNCStateDeltaStruct)) {
+        return false;
+    }
+
+    if (state_index == DELTA_STATE_SHROUD && !Set_Player_Context(player_id)) {
+        return false;
+    }
+
+    int map_cell_x;
+    int map_cell_y;
+    int map_cell_width;
+    int map_cell_height;
+    Get_Export_Cell_Rect(map_cell_x, map_cell_y, map_cell_width, map_cell_height);
 
-            int occupier_count = 0;
-            ObjectClass* optr = cellptr->Cell_Occupier();
-            while (optr != NULL) {
-                occupier_count++;
-                optr = optr->Next;
+    StateDeltaType& last = StateDeltas[player_index][state_index];
+
+    bool full_update = base_sequence == 0 || last.Sequence == 0 || base_sequence != last.Sequence
+                       || map_cell_x != last.MapCellX || map_cell_y != last.MapCellY
+                       || map_cell_width != last.MapCellWidth || map_cell_height != last.MapCellHeight
+                       || (state_index == DELTA_STATE_DYNAMIC_MAP && Debug_Unshroud != last.IsUnshrouded);
+
+    if (full_update) {
+        memset(last.CellCRC, 0, sizeof(last.CellCRC));
+        memset(last.Changed, 0, sizeof(last.Changed));
+        last.MapCellX = map_cell_x;
+        last.MapCellY = map_cell_y;
+        last.MapCellWidth = map_cell_width;
+        last.MapCellHeight = map_cell_height;
+        last.IsUnshrouded = Debug_Unshroud;
+
+        for (int y = 0; y < map_cell_height; y++) {
+            for (int x = 0; x < map_cell_width; x++) {
+                CELL cell = XY_Cell(map_cell_x + x, map_cell_y + y);
+                last.Changed[cell / 32] |= 1U << (cell % 32);
             }
+        }
+    }
 
-            memory_needed += sizeof(CNCOccupierEntryHeaderStruct) + (sizeof(CNCOccupierObjectStruct) * occupier_count);
-            if (memory_needed >= buffer_size) {
+    /*
+    ** Anything that goes wrong from here on leaves the check values part updated, so the next request
+    ** has to be a full update.
+    */
+    last.Sequence = 0;
+
+    CNCStateDeltaStruct* delta = (CNCStateDeltaStruct*)buffer_in;
+    memset(delta, 0, sizeof(*delta));
+    delta->BaseSequence = full_update ? 0 : base_sequence;
+    delta->MapCellX = map_cell_x;
+    delta->MapCellY = map_cell_y;
+    delta->MapCellWidth = map_cell_width;
+    delta->MapCellHeight = map_cell_height;
+
+    switch (state_index) {
+    case DELTA_STATE_SHROUD:
+        Apply_Gap_Shroud();
+        break;
+
+    case DELTA_STATE_DYNAMIC_MAP:
+        /*
+        ** A flag on the ground animates, so its cell changes every frame.
+        */
+        for (int index = 0; index < Houses.Count(); index++) {
+            HouseClass* house = Houses.Ptr(index);
+            if (house != NULL && Is_Target_Cell(house->FlagLocation)) {
+                CELL cell = As_Cell(house->FlagLocation);
+                last.Changed[cell / 32] |= 1U << (cell % 32);
+            }
+        }
+
+        // Need to ignore view constraints for dynamic map updates, so the radar map
+        // has the latest tiberium state for cells outside the tactical view
+        Adjust_Internal_View(true);
+        break;
+    }
+
+    unsigned char* out = (unsigned char*)(delta + 1);
+    unsigned int memory_needed = sizeof(*delta);
+    bool fits = true;
+
+    for (int word = 0; word < ARRAY_SIZE(last.Changed) && fits; word++) {
+        unsigned int changed = last.Changed[word];
+        last.Changed[word] = 0;
+
+        for (int bit = 0; changed != 0 && fits; bit++, changed >>= 1) {
+            if ((changed & 1) == 0) {
+                continue;
+            }
+
+            CELL cell = (CELL)(word * 32 + bit);
+            int cell_x = Cell_X(cell);
+            int cell_y = Cell_Y(cell);
+            if (cell_x < map_cell_x || cell_x >= map_cell_x + map_cell_width || cell_y < map_cell_y
+                || cell_y >= map_cell_y + map_cell_height) {
+                continue;
+            }
+
+            /*
+            ** Make the cell's entries where they go in the reply, and only keep them if they changed.
+            */
+            CNCCellDeltaStruct* cell_delta = (CNCCellDeltaStruct*)out;
+            unsigned char* entries = (unsigned char*)(cell_delta + 1);
+            unsigned int room = buffer_size - memory_needed;
+            int entry_count = 0;
+            unsigned int entry_size = 0;
+
+            switch (state_index) {
+            case DELTA_STATE_SHROUD:
+                entry_size = sizeof(CNCShroudEntryStruct);
+                if (room < sizeof(CNCCellDeltaStruct) + entry_size) {
+                    fits = false;
+                    continue;
+                }
+                Get_Shroud_Entry(cell, *(CNCShroudEntryStruct*)entries);
+                entry_count = 1;
+                break;
+
+            case DELTA_STATE_OCCUPIER:
+                entry_size = sizeof(CNCOccupierObjectStruct);
+                if (room < sizeof(CNCCellDeltaStruct)) {
+                    fits = false;
+                    continue;
+                }
+                entry_count = Get_Occupier_Entry(
+                    cell, (CNCOccupierObjectStruct*)entries, room - sizeof(CNCCellDeltaStruct));
+                if (entry_count < 0) {
+                    fits = false;
+                    continue;
+                }
+                break;
+
+            case DELTA_STATE_DYNAMIC_MAP:
+                entry_size = sizeof(CNCDynamicMapEntryStruct);
+                if (room < sizeof(CNCCellDeltaStruct) + entry_size * MAX_CELL_DYNAMIC_ENTRIES) {
+                    fits = false;
+                    continue;
+                }
+                Get_Dynamic_Map_Entries(cell, (CNCDynamicMapEntryStruct*)entries, entry_count);
+                break;
+            }
+
+            unsigned int crc = 0;
+            if (entry_count > 0) {
+                crc = Calculate_CRC(entries, entry_count * entry_size);
+                if (crc == 0) {
+                    crc = 1;
+                }
+            }
+
+            if (crc == last.CellCRC[cell]) {
+                continue;
+            }
+
+            cell_delta->CellX = (unsigned char)cell_x;
+            cell_delta->CellY = (unsigned char)cell_y;
+            cell_delta->Count = (short)entry_count;
+            out += sizeof(CNCCellDeltaStruct) + entry_count * entry_size;
+            memory_needed += sizeof(CNCCellDeltaStruct) + entry_count * entry_size;
+
+            delta->CellCount++;
+            last.CellCRC[cell] = crc;
+        }
+    }
+
+    if (state_index == DELTA_STATE_SHROUD) {
+        Unapply_Gap_Shroud();
+    }
+
+    if (!fits) {
+        return false;
+    }
+
+    if (state_index == DELTA_STATE_DYNAMIC_MAP) {
+        delta->VortexActive = ChronalVortex.Is_Active();
+        delta->VortexX = Coord_X(ChronalVortex.Get_Position());
+        delta->VortexY = Coord_Y(ChronalVortex.Get_Position());
+        delta->VortexWidth = Pixel_To_Lepton(64);
+        delta->VortexHeight = Pixel_To_Lepton(64);
+    }
+
+    if (++DeltaSequence == 0) {
+        DeltaSequence = 1;
+    }
+    delta->Sequence = DeltaSequence;
+    last.Sequence = DeltaSequence;
+
+    return true;
+}
+
+/**************************************************************************************************
+ * DLLExportClass::Get_Layer_State_Delta -- Get the objects of the layer state that changed since it was last sent
+ *
+ * In:   Player perspective
+ *       Index of the player's delta records
+ *       Sequence of the last layer state the caller has, 0 if none
+ *       Buffer to contain the changes
+ *       Size of buffer
+ *
+ * Out:  CNCLayerDeltaStruct followed by the objects that changed and the keys of those removed
+ *
+ *       The full layer state is made by Get_Layer_State, then its entries are grouped by the type
+ *       and heap ID of the object they draw, sub-objects going with their base object. Each group
+ *       is compared with a check value kept of what was last sent to this player, and only new or
+ *       changed groups are sent. Objects that are gone are sent by key. If the caller doesn't have
+ *       the last state sent, every object is sent as a full update instead.
+ *
+ **************************************************************************************************/
+bool DLLExportClass::Get_Layer_State_Delta(uint64 player_id,
+                                           int player_index,
+                                           unsigned int base_sequence,
+                                           unsigned char* buffer_in,
+                                           unsigned int buffer_size)
+{
+    if (buffer_size < sizeof(CNCLayerDeltaStruct)) {
+        return false;
+    }
+
+    LayerDeltaType& last = LayerDeltas[player_index];
+
+    bool full_update = base_sequence == 0 || last.Sequence == 0 || base_sequence != last.Sequence;
+    int last_count = full_update ? 0 : last.Count;
+
+    /*
+    ** Anything that goes wrong from here on leaves the caller without a state to build on, so the next request
+    ** has to be a full update.
+    */
+    last.Sequence = 0;
+
+    /*
+    ** The full state fits in no more room than the delta would need, so it is made in a scratch buffer the same
+    ** size. Get_Layer_State doesn't set the count if it runs out of room.
+    */
+    if (LayerScratchSize < buffer_size) {
+        delete[] LayerScratch;
+        LayerScratch = new unsigned char[buffer_size];
+        LayerScratchSize = buffer_size;
+    }
+
+    CNCObjectListStruct* list = (CNCObjectListStruct*)LayerScratch;
+    list->Count = -1;
+    Get_Layer_State(player_id, LayerScratch, buffer_size);
+    if (list->Count < 0) {
+        return false;
+    }
+
+    int count = list->Count;
+    if (LayerEntryMax < count) {
+        delete[] LayerEntries;
+        LayerEntries = new LayerKeyType[count];
+        LayerEntryMax = count;
+    }
+    if (LayerDeltaNext.Max < count) {
+        delete[] LayerDeltaNext.Objects;
+        LayerDeltaNext.Objects = new LayerKeyType[count];
+        LayerDeltaNext.Max = count;
+    }
+
+    for (int index = 0; index < count; index++) {
+        CNCObjectStruct const& object = list->Objects[index];
+        LayerKeyType& entry = LayerEntries[index];
+        entry.Type = object.SubObject ? object.BaseObjectType : object.Type;
+        entry.ID = object.SubObject ? object.BaseObjectID : object.ID;
+        entry.Value = index;
+    }
+    qsort(LayerEntries, count, sizeof(LayerEntries[0]), Compare_Layer_Entries);
+
+    CNCLayerDeltaStruct* delta = (CNCLayerDeltaStruct*)buffer_in;
+    memset(delta, 0, sizeof(*delta));
+    delta->BaseSequence = full_update ? 0 : base_sequence;
+
+    unsigned char* out = (unsigned char*)(delta + 1);
+    unsigned int memory_needed = sizeof(*delta);
+    int last_index = 0;
+
+    LayerDeltaNext.Count = 0;
+
+    for (int first = 0; first < count;) {
+
+        /*
+        ** The entries of one object are together after the sort, still in draw order.
+        */
+        CRCEngine crc;
+        int end = first;
+        while (end < count && Compare_Layer_Keys(LayerEntries[first], LayerEntries[end]) == 0) {
+            crc(&list->Objects[LayerEntries[end].Value], sizeof(CNCObjectStruct));
+            end++;
+        }
+
+        LayerKeyType& object = LayerDeltaNext.Objects[LayerDeltaNext.Count++];
+        object.Type = LayerEntries[first].Type;
+        object.ID = LayerEntries[first].ID;
+        object.Value = crc();
+
+        while (last_index < last_count && Compare_Layer_Keys(last.Objects[last_index], object) < 0) {
+            last_index++;
+        }
+
+        if (last_index >= last_count || Compare_Layer_Keys(last.Objects[last_index], object) != 0
+            || last.Objects[last_index].Value != object.Value) {
+
+            unsigned int size = sizeof(CNCObjectDeltaStruct) + (end - first) * sizeof(CNCObjectStruct);
+            if (buffer_size - memory_needed < size) {
                 return false;
             }
 
-            CNCOccupierObjectStruct* occupier = reinterpret_cast<CNCOccupierObjectStruct*>(entry + 1U);
-            entry->Count = 0;
-
-            optr = cellptr->Cell_Occupier();
-            for (int i = 0; i < occupier_count; i++, occupier++, entry->Count++) {
-                CNCObjectStruct object;
-                Convert_Type(optr, object);
-                occupier->Type = object.Type;
-                occupier->ID = object.ID;
-                optr = optr->Next;
+            CNCObjectDeltaStruct* object_delta = (CNCObjectDeltaStruct*)out;
+            object_delta->Type = (DllObjectTypeEnum)object.Type;
+            object_delta->ID = object.ID;
+            object_delta->Count = end - first;
+
+            unsigned char* entries = (unsigned char*)(object_delta + 1);
+            for (int index = first; index < end; index++) {
+                memcpy(entries, &list->Objects[LayerEntries[index].Value], sizeof(CNCObjectStruct));
+                entries += sizeof(CNCObjectStruct);
             }
 
-            entry = reinterpret_cast<CNCOccupierEntryHeaderStruct*>(occupier + 1U);
+            out += size;
+            memory_needed += size;
+            delta->ObjectCount++;
+        }
+
+        first = end;
+    }
+
+    /*
+    ** Whatever was sent last time and isn't in the state now has been removed.
+    */
+    int next_index = 0;
+    for (int index = 0; index < last_count; index++) {
+        while (next_index < LayerDeltaNext.Count
+               && Compare_Layer_Keys(LayerDeltaNext.Objects[next_index], last.Objects[index]) < 0) {
+            next_index++;
+        }
+        if (next_index < LayerDeltaNext.Count
+            && Compare_Layer_Keys(LayerDeltaNext.Objects[next_index], last.Objects[index]) == 0) {
+            continue;
+        }
+
+        if (buffer_size - memory_needed < sizeof(CNCObjectKeyStruct)) {
+            return false;
         }
+
+        CNCObjectKeyStruct* removed = (CNCObjectKeyStruct*)out;
+        removed->Type = (DllObjectTypeEnum)last.Objects[index].Type;
+        removed->ID = last.Objects[index].ID;
+        out += sizeof(CNCObjectKeyStruct);
+        memory_needed += sizeof(CNCObjectKeyStruct);
+        delta->RemovedCount++;
+    }
+
+    /*
+    ** What was just made becomes what was last sent.
+    */
+    LayerDeltaType sent = LayerDeltaNext;
+    LayerDeltaNext.Count = 0;
+    LayerDeltaNext.Max = last.Max;
+    LayerDeltaNext.Objects = last.Objects;
+    last.Count = sent.Count;
+    last.Max = sent.Max;
+    last.Objects = sent.Objects;
+
+    if (++DeltaSequence == 0) {
+        DeltaSequence = 1;
     }
+    delta->Sequence = DeltaSequence;
+    last.Sequence = DeltaSequence;
 
     return true;
 }
 
+/**************************************************************************************************
+ * DLLExportClass::Compare_Layer_Keys -- Order layer keys by object type and ID
+ *
+ * In:   The two keys to compare
+ *
+ * Out:  Less than, equal to or greater than zero, as the first orders before, with or after the second
+ *
+ **************************************************************************************************/
+int DLLExportClass::Compare_Layer_Keys(LayerKeyType const& key1, LayerKeyType const& key2)
+{
+    if (key1.Type != key2.Type) {
+        return (key1.Type < key2.Type) ? -1 : 1;
+    }
+    if (key1.ID != key2.ID) {
+        return (key1.ID < key2.ID) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**************************************************************************************************
+ * DLLExportClass::Compare_Layer_Entries -- Order layer entries by object, for qsort
+ *
+ * In:   Pointers to the two LayerKeyType to compare
+ *
+ * Out:  Less than, equal to or greater than zero, as the first orders before, with or after the second
+ *
+ *       Entries of the same object are ordered by their place in the layer state, so they keep
+ *       their draw order.
+ *
+ **************************************************************************************************/
+int DLLExportClass::Compare_Layer_Entries(void const* ptr1, void const* ptr2)
+{
+    LayerKeyType const& entry1 = *(LayerKeyType const*)ptr1;
+    LayerKeyType const& entry2 = *(LayerKeyType const*)ptr2;
+
+    int result = Compare_Layer_Keys(entry1, entry2);
+    if (result == 0 && entry1.Value != entry2.Value) {
+        result = (entry1.Value < entry2.Value) ? -1 : 1;
+    }
+    return result;
+}
+
+/**************************************************************************************************
+ * DLLExportClass::Flag_Cell_Changed -- Note that the exported states of a cell may have changed
+ *
+ * In:   Cell
+ *       What changed, CellClass::ChangeType bits
+ *
+ * Out:
+ *
+ *       Flags the cell for every player's delta of each state that depends on what changed. The
+ *       shadow of a shrouded cell depends on whether its neighbours are mapped, so those are
+ *       flagged too when mapping changes.
+ *
+ **************************************************************************************************/
+void DLLExportClass::Flag_Cell_Changed(CELL cell, int changes)
+{
+    if ((unsigned)cell >= MAP_CELL_TOTAL) {
+        return;
+    }
+
+    unsigned int bit = 1U << (cell % 32);
+    int word = cell / 32;
+
+    for (int player = 0; player < MAX_PLAYERS; player++) {
+        StateDeltaType* deltas = StateDeltas[player];
+
+        if (changes & CellClass::CHANGE_MAPPED) {
+            for (FacingType face = FACING_N; face < FACING_COUNT; face++) {
+                CELL adjacent = Adjacent_Cell(cell, face);
+                if ((unsigned)adjacent < MAP_CELL_TOTAL) {
+                    deltas[DELTA_STATE_SHROUD].Changed[adjacent / 32] |= 1U << (adjacent % 32);
+                }
+            }
+        }
+        if (changes & (CellClass::CHANGE_MAPPED | CellClass::CHANGE_VISIBLE)) {
+            deltas[DELTA_STATE_SHROUD].Changed[word] |= bit;
+        }
+        if (changes & CellClass::CHANGE_OCCUPIER) {
+            deltas[DELTA_STATE_OCCUPIER].Changed[word] |= bit;
+        }
+        if (changes & (CellClass::CHANGE_MAPPED | CellClass::CHANGE_OVERLAY)) {
+            deltas[DELTA_STATE_DYNAMIC_MAP].Changed[word] |= bit;
+        }
+    }
+}
+
+/**************************************************************************************************
+ * DLLExportClass::Reset_State_Deltas -- Forget what state deltas were sent
+ *
+ * In:
+ *
+ * Out:
+ *
+ *       Called when a game starts or is loaded, so the next delta requests get full updates.
+ *
+ **************************************************************************************************/
+void DLLExportClass::Reset_State_Deltas(void)
+{
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        for (int j = 0; j < DELTA_STATE_COUNT; j++) {
+            StateDeltas[i][j].Sequence = 0;
+        }
+        LayerDeltas[i].Sequence = 0;
+    }
+}
+
 /**************************************************************************************************
  * DLLExportClass::Get_Player_Info_State -- Get the multiplayer info for this player
  *
@@ -6391,28 +7108,11 @@ bool DLLExportClass::Get_Dynamic_Map_State(uint64 player_id, unsigned char* buff
     **
     **
     */
-    int map_cell_x = Map.MapCellX;
-    int map_cell_y = Map.MapCellY;
-    int map_cell_width = Map.MapCellWidth;
-    int map_cell_height = Map.MapCellHeight;
-
-    if (map_cell_x > 0) {
-        map_cell_x--;
-        map_cell_width++;
-    }
-
-    if (map_cell_width < MAP_MAX_CELL_WIDTH) {
-        map_cell_width++;
-    }
-
-    if (map_cell_y > 0) {
-        map_cell_y--;
-        map_cell_height++;
-    }
-
-    if (map_cell_height < MAP_MAX_CELL_WIDTH) {
-        map_cell_height++;
-    }
+    int map_cell_x;
+    int map_cell_y;
+    int map_cell_width;
+    int map_cell_height;
+    Get_Export_Cell_Rect(map_cell_x, map_cell_y, map_cell_width, map_cell_height);
 
     int cell_index = 0;
 
@@ -6428,40 +7128,13 @@ bool DLLExportClass::Get_Dynamic_Map_State(uint64 player_id, unsigned char* buff
     for (int y = 0; y < map_cell_height; y++) {
         for (int x = 0; x < map_cell_width; x++) {
             CELL cell = XY_Cell(map_cell_x + x, map_cell_y + y);
-            COORDINATE coord = Cell_Coord(cell) & 0xFF00FF00;
 
             memory_needed += sizeof(CNCDynamicMapEntryStruct) * 2;
             if (memory_needed >= buffer_size) {
                 return false;
             }
 
-            /*
-            **	Only cells flagged to be redraw are examined.
-            */
-            // if (In_View(cell) && Is_Cell_Flagged(cell)) {
-            int xpixel;
-            int ypixel;
-
-            if (Map.Coord_To_Pixel(coord, xpixel, ypixel)) {
-                CellClass* cellptr = &Map[Coord_Cell(coord)];
-
-                /*
-                **	If there is a portion of the underlying icon that could be visible,
-                **	then draw it.  Also draw the cell if the shroud is off.
-                */
-                if (GAME_TO_PLAY == GAME_GLYPHX_MULTIPLAYER || cellptr->IsMapped || Debug_Unshroud) {
-                    Cell_Class_Draw_It(dynamic_map, entry_index, cellptr, xpixel, ypixel, debug_output);
-                }
-
-                /*
-                **	If any cell is not fully mapped, then flag it so that the shadow drawing
-                **	process will occur.  Only draw the shadow if Debug_Unshroud is false.
-                */
-                // if (!cellptr->IsMapped && !Debug_Unshroud) {
-                //	IsShadowPresent = true;
-                //}
-            }
-            //}
+            Get_Dynamic_Map_Entries(cell, dynamic_map->Entries, entry_index, debug_output);
         }
     }
 
@@ -6480,6 +7153,54 @@ bool DLLExportClass::Get_Dynamic_Map_State(uint64 player_id, unsigned char* buff
     return true;
 }
 
+/**************************************************************************************************
+ * DLLExportClass::Get_Dynamic_Map_Entries -- Get the dynamic map entries of one cell
+ *
+ * In:   Cell
+ *       Entries to add to, with room for at least MAX_CELL_DYNAMIC_ENTRIES more
+ *       Index of the next free entry, moved on past the ones added
+ *
+ * Out:
+ *
+ *       The internal view must already be set up to ignore view constraints.
+ *
+ **************************************************************************************************/
+void DLLExportClass::Get_Dynamic_Map_Entries(CELL cell,
+                                             CNCDynamicMapEntryStruct* entries,
+                                             int& entry_index,
+                                             bool debug_output)
+{
+    COORDINATE coord = Cell_Coord(cell) & 0xFF00FF00;
+
+    /*
+    **	Only cells flagged to be redraw are examined.
+    */
+    // if (In_View(cell) && Is_Cell_Flagged(cell)) {
+    int xpixel;
+    int ypixel;
+
+    if (Map.Coord_To_Pixel(coord, xpixel, ypixel)) {
+        CellClass* cellptr = &Map[cell];
+
+        /*
+        **	If there is a portion of the underlying icon that could be visible,
+        **	then draw it.  Also draw the cell if the shroud is off.
+        */
+        if (GAME_TO_PLAY == GAME_GLYPHX_MULTIPLAYER || cellptr->IsMapped || Debug_Unshroud) {
+            Cell_Class_Draw_It(entries, entry_index, cellptr, xpixel, ypixel, debug_output);
+        }
+
+        /*
+        **	If any cell is not fully mapped, then flag it so that the shadow drawing
+        **	process will occur.  Only draw the shadow if Debug_Unshroud is false.
+        */
+        // if (!cellptr->IsMapped && !Debug_Unshroud) {
+        //	IsShadowPresent = true;
+        //}
+    }
+    //}
+}
+
 /**************************************************************************************************
  * DLLExportClass::Cell_Class_Draw_It -- Go through the motions of drawing a cell to get the smudge and overlay info
  *
@@ -6491,7 +7212,7 @@ bool DLLExportClass::Get_Dynamic_Map_State(uint64 player_id, unsigned char* buff
  *
  * History: 2/8/2019 11:09AM - ST
  **************************************************************************************************/
-void DLLExportClass::Cell_Class_Draw_It(CNCDynamicMapStruct* dynamic_map,
+void DLLExportClass::Cell_Class_Draw_It(CNCDynamicMapEntryStruct* entries,
                                         int& entry_index,
                                         CellClass* cell_ptr,
                                         int xpixel,
@@ -6523,7 +7244,7 @@ void DLLExportClass::Cell_Class_Draw_It(CNCDynamicMapStruct* dynamic_map,
                 IsTheaterShape = false;
             }
 
-            CNCDynamicMapEntryStruct& smudge_entry = dynamic_map->Entries[entry_index++];
+            CNCDynamicMapEntryStruct& smudge_entry = entries[entry_index++];
 
             strncpy(smudge_entry.AssetName, smudge_type.IniName, CNC_OBJECT_ASSET_NAME_LENGTH);
             smudge_entry.Type = (short)cell_ptr->Smudge;
@@ -6558,7 +7279,7 @@ void DLLExportClass::Cell_Class_Draw_It(CNCDynamicMapStruct* dynamic_map,
 
         if (overlay_type.Get_Image_Data() != NULL) {
 
-            CNCDynamicMapEntryStruct& overlay_entry = dynamic_map->Entries[entry_index++];
+            CNCDynamicMapEntryStruct& overlay_entry = entries[entry_index++];
 
             if (debug_output) {
                 IsTheaterShape = (bool)overlay_type.IsTheater;
@@ -6594,7 +7315,7 @@ void DLLExportClass::Cell_Class_Draw_It(CNCDynamicMapStruct* dynamic_map,
         const void* image_data = MFCD::Retrieve("FLAGFLY.SHP");
         if (image_data != NULL) {
 
-            CNCDynamicMapEntryStruct& flag_entry = dynamic_map->Entries[entry_index++];
+            CNCDynamicMapEntryStruct& flag_entry = entries[entry_index++];
 
             strncpy(flag_entry.AssetName, "FLAGFLY", CNC_OBJECT_ASSET_NAME_LENGTH);
             flag_entry.AssetName[CNC_OBJECT_ASSET_NAME_LENGTH - 1] = 0;
@@ -6961,6 +7682,7 @@ void DLLExportClass::Reset_Player_Context(void)
 {
     CurrentLocalPlayerIndex = 0;
     CurrentObject.Clear_All();
+    Reset_State_Deltas();
 }
 
 /**************************************************************************************************
@@ -8596,6 +9318,8 @@ bool DLLExportClass::Load(Straw& file)
 {
     unsigned int version = 0;
 
+    Reset_State_Deltas();
+
     if (file.Get(&version, sizeof(version)) != sizeof(version)) {
         return false;
     }
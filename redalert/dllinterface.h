@@ -883,6 +883,70 @@ struct CNCOccupierHeaderStruct
     int Count;
 };
 
+/**************************************************************************************
+**
+**  Cell state deltas.
+**
+**  Shroud, occupier and dynamic map state as changed since an earlier request. BaseSequence is the
+**  Sequence of the state the changes apply to, or 0 if this is a full update and the receiver
+**  should clear what it has first. CellCount cell records follow the header, each followed by
+**  Count entries of the type the full state uses for that cell.
+**
+*/
+struct CNCCellDeltaStruct
+{
+    unsigned char CellX;
+    unsigned char CellY;
+    short Count;
+};
+
+struct CNCStateDeltaStruct
+{
+    unsigned int Sequence;
+    unsigned int BaseSequence;
+    int MapCellX;
+    int MapCellY;
+    int MapCellWidth;
+    int MapCellHeight;
+    int CellCount;
+    bool VortexActive; // Dynamic map only
+    int VortexX;
+    int VortexY;
+    int VortexWidth;
+    int VortexHeight;
+};
+
+/**************************************************************************************
+**
+**  Layer state deltas.
+**
+**  Layer (object) state as changed since an earlier request, keyed on each object's type and ID. BaseSequence
+**  is as for the cell deltas. ObjectCount object records follow the header, each followed by Count entries of
+**  the layer state for that object and its sub-objects, which replace all the receiver has for it. RemovedCount
+**  keys follow those, for the objects that are no longer in the state.
+**
+*/
+struct CNCObjectKeyStruct
+{
+    DllObjectTypeEnum Type;
+    int ID;
+};
+
+struct CNCObjectDeltaStruct
+{
+    DllObjectTypeEnum Type;
+    int ID;
+    int Count;
+};
+
+struct CNCLayerDeltaStruct
+{
+    unsigned int Sequence;
+    unsigned int BaseSequence;
+    int ObjectCount;
+    int RemovedCount;
+};
+
 /**************************************************************************************
 **
 **  Carryover object.
@@ -24,6 +24,6 @@
 **
 **
 */
-#define CNC_DLL_API_VERSION 0x102
+#define CNC_DLL_API_VERSION 0x103
 
 #endif // DLL_INTERFACE_VERSION_H
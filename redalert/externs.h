@@ -152,7 +152,7 @@ extern CCINIClass RuleINI;
 #ifdef FIXIT_CSII //	checked - ajw 9/28/98
 extern CCINIClass AftermathINI;
 #endif
-// extern Benchmark *				Benches;
+extern ProfilerClass* Benches;
 extern int MapTriggerID;
 extern int LogicTriggerID;
 extern PKey FastKey;
@@ -308,6 +308,13 @@ extern HousesType Whom;
 extern VQAConfig AnimControl;
 extern int SpareTicks;
 extern int PathCount;
+extern PathCacheClass PathCache;
+extern SimContextClass MainSimContext;
+extern TechnoGridClass TechnoGrid;
+extern TechnoStateClass TechnoState;
+extern StateHashClass StateHash;
+extern ReferenceIndexClass References;
+extern JobPoolClass LogicJobs;
 extern int CellCount;
 extern int TargetScan;
 extern int SidebarRedraws;
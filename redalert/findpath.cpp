@@ -138,16 +138,10 @@ inline static FacingType Next_Direction(FacingType facing, FacingType dir)
 }
 
 /*=========================================================================*/
-/* Define a couple of variables which are private to the module they are   */
-/*      declared in.                                                       */
+/* The overlap lists and the start and end of the search are kept in the   */
+/*      PathScratchType of the current simulation context.                 */
 /*=========================================================================*/
-static unsigned int MainOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the main path
-static unsigned int LeftOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the left path
-static unsigned int RightOverlap[MAP_CELL_TOTAL / 32]; // overlap list for the right path
-
 // static CELL MoveMask = 0;
-static CELL DestLocation;
-static CELL StartLocation;
 
 /***************************************************************************
  * Point_Relative_To_Line -- Relation between a point and a line           *
@@ -431,12 +425,13 @@ bool FootClass::Register_Cell(PathType* path, CELL cell, FacingType dir, int cos
  *=============================================================================================*/
 PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, MoveType threshhold)
 {
-    CELL source = Coord_Cell(Coord); // Source expressed as cell
-    static PathType path;            // Main path control.
-    CELL next;                       // Next cell to enter
-    CELL startcell;                  // Cell we started in
-    FacingType direction;            // Working direction of look ahead.
-    FacingType newdir;               // Tentative facing value.
+    CELL source = Coord_Cell(Coord);                             // Source expressed as cell
+    PathScratchType& scratch = SimContextClass::Current()->Path; // Search state of the current simulation.
+    PathType& path = scratch.Path;                               // Main path control.
+    CELL next;                                                   // Next cell to enter
+    CELL startcell;                                              // Cell we started in
+    FacingType direction;                                        // Working direction of look ahead.
+    FacingType newdir;                                           // Tentative facing value.
 
     bool left = false, // Was leftward path legal?
         right = false; // Was rightward path legal?
@@ -458,6 +453,32 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
     if (!final_moves)
         return (NULL);
 
+    /*
+    **	Objects that don't weigh up threats can share paths with others of the same type
+    **	heading to the same place.
+    */
+    bool cacheable = Rule.IsPathCache && !(Team && Team->Class->IsRoundAbout);
+    if (cacheable) {
+        PathType* cached = Fetch_Cached_Path(dest, final_moves, maxlen, threshhold);
+        if (cached != NULL) {
+            return (cached);
+        }
+    }
+
+    /*
+    **	Hand the search over to the A* engine if the rules ask for it. The destination is
+    **	still recorded here since Passable_Cell() uses it for the threat check.
+    */
+    if (Rule.IsAStarPath) {
+        scratch.StartLocation = source;
+        scratch.DestLocation = dest;
+        PathType* found = Find_Path_AStar(dest, final_moves, maxlen, threshhold);
+        if (cacheable) {
+            Store_Cached_Path(dest, found, threshhold);
+        }
+        return (found);
+    }
+
     BStart(BENCH_FINDPATH);
 
     PathCount++;
@@ -470,8 +491,8 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
         unit_threat = threat = -1;
     }
 
-    StartLocation = source;
-    DestLocation = dest;
+    scratch.StartLocation = source;
+    scratch.DestLocation = dest;
 
     /*
     ** Initialize the path structure so that we can keep track of the
@@ -482,11 +503,11 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
     path.Length = 0;
     path.Command = final_moves;
     path.Command[0] = END;
-    path.Overlap = MainOverlap;
+    path.Overlap = scratch.MainOverlap;
     path.LastOverlap = -1;
     path.LastFixup = -1;
 
-    memset(path.Overlap, 0, sizeof(MainOverlap));
+    memset(path.Overlap, 0, sizeof(scratch.MainOverlap));
 
     /*
     ** Clear the over lap list and then make sure that our starting position is marked
@@ -625,9 +646,9 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
 
                 Mem_Copy(&path, &pleft, sizeof(PathType));
                 pleft.Command = &moves_left[0];
-                pleft.Overlap = LeftOverlap;
+                pleft.Overlap = scratch.LeftOverlap;
                 Mem_Copy(path.Command, pleft.Command, path.Length);
-                Mem_Copy(path.Overlap, pleft.Overlap, sizeof(LeftOverlap));
+                Mem_Copy(path.Overlap, pleft.Overlap, sizeof(scratch.LeftOverlap));
 
 // MBL 09.30.2019: We hit a runtime bounds crash where END (-1 / 0xFF) was being poked into +1 just past the end of the
 // moves_right[] array; The FacingType moves_left[] and moves_right[] arrays already have MAX_MLIST_SIZE+2 as their
@@ -646,9 +667,9 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
 
                 Mem_Copy(&path, &pright, sizeof(PathType));
                 pright.Command = &moves_right[0];
-                pright.Overlap = RightOverlap;
+                pright.Overlap = scratch.RightOverlap;
                 Mem_Copy(path.Command, pright.Command, path.Length);
-                Mem_Copy(path.Overlap, pright.Overlap, sizeof(RightOverlap));
+                Mem_Copy(path.Overlap, pright.Overlap, sizeof(scratch.RightOverlap));
 
 // MBL 09.30.2019: We hit a runtime bounds crash where END (-1 / 0xFF) was being poked into +1 just past the end of the
 // moves_right[] array; The FacingType moves_left[] and moves_right[] arrays already have MAX_MLIST_SIZE+2 as their
@@ -737,7 +758,7 @@ PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, M
             len = which->Length;
             len = min(len, maxlen);
             if (len > 0) {
-                memcpy(&path.Overlap[0], &which->Overlap[0], sizeof(LeftOverlap));
+                memcpy(&path.Overlap[0], &which->Overlap[0], sizeof(scratch.LeftOverlap));
                 memcpy(&path.Command[0], &which->Command[0], len * sizeof(FacingType));
                 path.Length = len;
                 path.Cost = which->Cost;
@@ -766,6 +787,10 @@ end_of_list:
     Optimize_Moves(&path, threshhold);
 #endif
 
+    if (cacheable) {
+        Store_Cached_Path(dest, &path, threshhold);
+    }
+
     BEnd(BENCH_FINDPATH);
 
     return (&path);
@@ -1314,7 +1339,8 @@ int FootClass::Passable_Cell(CELL cell, FacingType face, int threat, MoveType th
 
     if (Session.Type == GAME_NORMAL) {
         if (threat != -1) {
-            if (::Distance(Cell_Coord(cell), Cell_Coord(DestLocation)) > (THREAT_THRESHOLD * CELL_LEPTON_W)) {
+            CELL dest = SimContextClass::Current()->Path.DestLocation;
+            if (::Distance(Cell_Coord(cell), Cell_Coord(dest)) > (THREAT_THRESHOLD * CELL_LEPTON_W)) {
                 //			if (Map.Cell_Distance(cell, DestLocation) > THREAT_THRESHOLD) {
                 if (Map.Cell_Threat(cell, Owner()) > threat)
                     return (0);
@@ -167,11 +167,11 @@ void FootClass::Debug_Dump(MonoClass* mono) const
     mono->Printf("%02X", Speed);
     if (NavCom) {
         mono->Set_Cursor(29, 5);
-        mono->Printf("%08X", NavCom);
+        mono->Printf("%08X", (TARGET)NavCom);
     }
     if (SuspendedNavCom) {
         mono->Set_Cursor(38, 5);
-        mono->Printf("%08X", SuspendedNavCom);
+        mono->Printf("%08X", (TARGET)SuspendedNavCom);
     }
 
     if (Team)
@@ -1833,6 +1833,7 @@ void FootClass::Assign_Destination(TARGET target)
     assert(IsActive);
 
     NavCom = target;
+    StateHash.Changed(this);
 
     /*
     **	Presume that the easiest path is tried first. As the findpath proceeds, when
@@ -2105,8 +2106,9 @@ void FootClass::Detach(TARGET target, bool all)
         if (NavQueue[index] == target) {
             NavQueue[index] = TARGET_NONE;
             if (index < ARRAY_SIZE(NavQueue) - 1) {
-                memmove(
-                    &NavQueue[index], &NavQueue[index + 1], ((ARRAY_SIZE(NavQueue) - index) - 1) * sizeof(NavQueue[0]));
+                for (int move = index; move < ARRAY_SIZE(NavQueue) - 1; move++) {
+                    NavQueue[move] = NavQueue[move + 1];
+                }
                 NavQueue[ARRAY_SIZE(NavQueue) - 1] = TARGET_NONE;
                 index--;
             }
@@ -2346,7 +2348,9 @@ void FootClass::Handle_Navigation_List(void)
         */
         if (Target_Legal(target)) {
             Assign_Destination(target);
-            memmove(&NavQueue[0], &NavQueue[1], sizeof(NavQueue) - sizeof(NavQueue[0]));
+            for (int move = 0; move < ARRAY_SIZE(NavQueue) - 1; move++) {
+                NavQueue[move] = NavQueue[move + 1];
+            }
             NavQueue[ARRAY_SIZE(NavQueue) - 1] = TARGET_NONE;
 
             /*
@@ -178,15 +178,15 @@ public:
     **	This is the desired destination of the unit. The unit will attempt to head
     **	toward this target (avoiding intervening obstacles).
     */
-    TARGET NavCom;
-    TARGET SuspendedNavCom;
+    TargetRefClass NavCom;
+    TargetRefClass SuspendedNavCom;
 
     /*
     **	A sequence of move destinations can be given to a unit. The sequence is
     **	stores as an array of movement targets. The list is terminated with a
     **	TARGET_NONE.
     */
-    TARGET NavQueue[10];
+    TargetRefClass NavQueue[10];
 
     /*
     **	This points to the team that "owns" this object. This pointer is used to
@@ -373,6 +373,9 @@ public:
 private:
     int Passable_Cell(CELL cell, FacingType face, int threat, MoveType threshhold);
     PathType* Find_Path(CELL dest, FacingType* final_moves, int maxlen, MoveType threshhold);
+    PathType* Find_Path_AStar(CELL dest, FacingType* final_moves, int maxlen, MoveType threshhold);
+    PathType* Fetch_Cached_Path(CELL dest, FacingType* final_moves, int maxlen, MoveType threshhold);
+    void Store_Cached_Path(CELL dest, PathType const* path, MoveType threshhold);
     void Debug_Draw_Map(char const* txt, CELL start, CELL dest, bool pause);
     void Debug_Draw_Path(PathType* path);
     bool Follow_Edge(CELL start,
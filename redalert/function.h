@@ -59,7 +59,6 @@
 
 #include "common/wwlib32.h"
 #include "common/winstub.h"
-#include "bench.h"
 #include "compat.h"
 #include "fixed.h"
 
@@ -97,8 +96,10 @@ extern int LParam;
 #include "debug.h"
 #include "special.h"
 #include "defines.h"
+#include "bench.h"
 #include "ccini.h"
 #include "ccptr.h"
+#include "refindex.h" // Which objects refer to each target.
 
 extern int Frame;
 CELL Coord_Cell(COORDINATE coord);
@@ -125,6 +126,12 @@ CELL Coord_Cell(COORDINATE coord);
 #include "infantry.h" // Infantry objects.
 #include "score.h"    // Scoring system class.
 #include "factory.h"  // Production manager class.
+#include "pathcache.h" // Recent path search results.
+#include "simctx.h"    // Path finder scratch and other per simulation state.
+#include "techgrid.h"  // Where techno objects are on the map.
+#include "techstat.h"  // Compact copy of techno object values.
+#include "statehash.h" // Hierarchical hash of the game state.
+#include "common/jobpool.h"
 
 // Denzil 5/18/98 - Mpeg movie playback
 #ifdef MPEGMOVIE
@@ -188,8 +195,14 @@ void Speak(VoxType voice, HouseClass* house = NULL, COORDINATE coord = 0);
 void Speak_AI(void);
 void Stop_Speaking(void);
 void Sound_Effect(VocType voc, COORDINATE coord, int variation = 1, HousesType house = HOUSE_NONE);
+void Preload_Sound_Effects(void);
 bool Is_Speaking(void);
 
+/*
+**	BENCHSIM.CPP
+*/
+bool Bench_Sim(int argc, char* argv[]);
+
 /*
 **	COMBAT.CPP
 */
@@ -484,6 +497,7 @@ bool Queue_Options(void);
 bool Queue_Exit(void);
 void Queue_AI(void);
 void Add_CRC(unsigned int* crc, unsigned int val);
+unsigned int Get_Game_CRC(void);
 
 /*
 **	REINF.CPP
@@ -525,6 +539,7 @@ bool Save_Game(const char* file_name, const char* descr);
 bool Write_Object(void* ptr, int class_size, FileClass& file);
 void Code_All_Pointers(void);
 void Decode_All_Pointers(void);
+bool Finish_Background_Save(void);
 void Dump(void);
 
 /*
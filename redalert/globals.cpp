@@ -233,10 +233,10 @@ CCINIClass AftermathINI;
 #endif
 
 /***************************************************************************
-**	This points to the benchmark objects that are allocated only if the
-**	machine is running on a Pentium and this is a debug version.
+**	This points to the profiler that is allocated only if it was requested
+**	on the command line (-PROFILE or -PROFILETRACE).
 */
-// Benchmark * Benches;
+ProfilerClass* Benches = NULL;
 
 /***************************************************************************
 **	General rules that control the game.
@@ -368,6 +368,44 @@ int CellCount;      // Number of cells redrawn.
 int TargetScan;     // Number of target scans.
 int SidebarRedraws; // Number of sidebar redraws.
 
+/***************************************************************************
+**	Recently computed paths that other units of the same type may reuse.
+*/
+PathCacheClass PathCache;
+
+/***************************************************************************
+**	The game's own simulation context, current on every thread unless the
+**	caller running a simulation sets its own.
+*/
+SimContextClass MainSimContext;
+thread_local SimContextClass* SimContextClass::Active = &MainSimContext;
+
+/***************************************************************************
+**	Counts of the techno objects on the map, bucketed by area and owner.
+*/
+TechnoGridClass TechnoGrid;
+
+/***************************************************************************
+**	Compact copy of the techno object values that the per frame scans use.
+*/
+TechnoStateClass TechnoState;
+
+/***************************************************************************
+**	Hierarchical hash of the game state, for tracking down desyncs.
+*/
+StateHashClass StateHash;
+
+/***************************************************************************
+**	Which objects refer to each target, so that dying objects can be detached
+**	from just those objects.
+*/
+ReferenceIndexClass References;
+
+/***************************************************************************
+**	Worker threads that large game logic scans can be split between.
+*/
+JobPoolClass LogicJobs;
+
 /***************************************************************************
 **	This is the monochrome debug page array. The various monochrome data
 **	screens are located here.
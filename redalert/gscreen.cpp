@@ -390,6 +390,13 @@ void GScreenClass::Render(void)
         }
         Session.Messages.Draw();
 
+        /*
+        ** The profiler display is drawn last so that it sits on top of everything else.
+        */
+        if (Benches != NULL && Benches->Is_Overlay()) {
+            Benches->Draw_Overlay();
+        }
+
 #ifndef REMASTER_BUILD
         Blit_Display();
 #endif
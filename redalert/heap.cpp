@@ -31,19 +31,24 @@
  *---------------------------------------------------------------------------------------------*
  * Functions:                                                                                  *
  *   FixedHeapClass::Allocate -- Allocate a sub-block from the heap.                           *
+ *   FixedHeapClass::Allocate_At -- Marks the specified sub-block as allocated.                *
  *   FixedHeapClass::Clear -- Clears (and frees) the heap manager memory.                      *
+ *   FixedHeapClass::First_Free -- Finds the lowest numbered free sub-block.                   *
  *   FixedHeapClass::FixedHeapClass -- Normal constructor for heap management class.           *
  *   FixedHeapClass::Free -- Frees a sub-block in the heap.                                    *
  *   FixedHeapClass::Free_All -- Frees all objects in the fixed heap.                          *
  *   FixedHeapClass::ID -- Converts a pointer to a sub-block index number.                     *
  *   FixedHeapClass::Set_Heap -- Assigns a memory block for this heap manager.                 *
  *   FixedHeapClass::~FixedHeapClass -- Destructor for the heap manager class.                 *
+ *   FixedIHeapClass::Activate -- Allocates the specified sub-block and makes it active.       *
+ *   FixedIHeapClass::Active_Index -- Finds the position of an object in the active list.      *
  *   FixedIHeapClass::Allocate -- Allocate an object from the heap.                            *
  *   FixedIHeapClass::Clear -- Clears the fixed heap of all entries.                           *
  *   FixedIHeapClass::Free -- Frees an object in the heap.                                     *
  *   FixedIHeapClass::Free_All -- Frees all objects out of the indexed heap.                   *
  *   FixedIHeapClass::Logical_ID -- Fetches the logical ID number.                             *
  *   FixedIHeapClass::Set_Heap -- Set the heap to the buffer provided.                         *
+ *   FixedIHeapClass::~FixedIHeapClass -- Destructor for the iterable heap class.              *
  *   TFixedIHeapClass::Code_Pointers -- codes pointers for every object, to prepare for save   *
  *   TFixedIHeapClass::Decode_Pointers -- Decodes all object pointers, for after loading       *
  *   TFixedIHeapClass::Load -- Loads all active objects                                        *
@@ -55,6 +60,7 @@
 #include <stdio.h>
 #include <stddef.h>
 #include <string.h>
+#include <limits.h>
 
 template class TFixedIHeapClass<AircraftClass>;
 template class TFixedIHeapClass<AircraftTypeClass>;
@@ -112,6 +118,8 @@ FixedHeapClass::FixedHeapClass(int size)
     , TotalCount(0)
     , ActiveCount(0)
     , Buffer(0)
+    , FreeMap(0)
+    , FreeSummary(0)
 {
 }
 
@@ -177,23 +185,30 @@ int FixedHeapClass::Set_Heap(int count, void* buffer)
         return (true);
 
     /*
-    **	Initialize the free boolean vector and the buffer for the actual
+    **	Initialize the free bit arrays and the buffer for the actual
     **	allocation objects.
     */
-    if (FreeFlag.Resize(count)) {
+    int words = (count + 31) / 32;
+    FreeMap = new unsigned[words + (words + 31) / 32];
+    if (!FreeMap) {
+        return (false);
+    }
+    FreeSummary = FreeMap + words;
+
+    if (!buffer) {
+        buffer = new char[count * Size];
         if (!buffer) {
-            buffer = new char[count * Size];
-            if (!buffer) {
-                FreeFlag.Clear();
-                return (false);
-            }
-            IsAllocated = true;
+            delete[] FreeMap;
+            FreeMap = 0;
+            FreeSummary = 0;
+            return (false);
         }
-        Buffer = buffer;
-        TotalCount = count;
-        return (true);
+        IsAllocated = true;
     }
-    return (false);
+    Buffer = buffer;
+    TotalCount = count;
+    Free_All();
+    return (true);
 }
 
 /***********************************************************************************************
@@ -215,15 +230,67 @@ int FixedHeapClass::Set_Heap(int count, void* buffer)
 void* FixedHeapClass::Allocate(void)
 {
     if (ActiveCount < TotalCount) {
-        int index = FreeFlag.First_False();
+        return (Allocate_At(First_Free()));
+    }
+    return (0);
+}
 
-        if (index != -1) {
-            ActiveCount++;
-            FreeFlag[index] = true;
-            return ((*this)[index]);
+/***********************************************************************************************
+ * FixedHeapClass::First_Free -- Finds the lowest numbered free sub-block.                     *
+ *                                                                                             *
+ *    The free sub-blocks are always handed out lowest number first, since the sub-block       *
+ *    number of an object is visible to the game logic (as a TARGET value). The summary bits   *
+ *    lead straight to the first word of the free bit array that has a free sub-block in it,   *
+ *    so this takes only a few operations no matter how full the heap is.                      *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns with the index number of the lowest free sub-block. If there are no free   *
+ *          sub-blocks then -1 is returned.                                                    *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int FixedHeapClass::First_Free(void) const
+{
+    int words = (TotalCount + 31) / 32;
+    int summaries = (words + 31) / 32;
+
+    for (int index = 0; index < summaries; index++) {
+        if (FreeSummary[index] != 0) {
+            int word = (index << 5) + Lowest_Bit(FreeSummary[index]);
+            return ((word << 5) + Lowest_Bit(FreeMap[word]));
         }
     }
-    return (0);
+    return (-1);
+}
+
+/***********************************************************************************************
+ * FixedHeapClass::Allocate_At -- Marks the specified sub-block as allocated.                  *
+ *                                                                                             *
+ *    This is the low level allocation routine. It flags the sub-block as being in use and     *
+ *    updates the summary bits if this was the last free sub-block in its word of the free     *
+ *    bit array.                                                                               *
+ *                                                                                             *
+ * INPUT:   index -- The index number of the sub-block to allocate.                            *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the sub-block. If the index is out of range or the sub-  *
+ *          block is already in use then NULL is returned.                                     *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void* FixedHeapClass::Allocate_At(int index)
+{
+    if (index < 0 || index >= TotalCount || Is_Allocated(index)) {
+        return (0);
+    }
+
+    int word = index >> 5;
+    FreeMap[word] &= ~(1U << (index & 31));
+    if (FreeMap[word] == 0) {
+        FreeSummary[word >> 5] &= ~(1U << (word & 31));
+    }
+    ActiveCount++;
+    return ((*this)[index]);
 }
 
 /***********************************************************************************************
@@ -247,10 +314,12 @@ int FixedHeapClass::Free(void* pointer)
     if (pointer && ActiveCount) {
         int index = ID(pointer);
 
-        if (index < TotalCount) {
-            if (FreeFlag[index]) {
+        if (index >= 0 && index < TotalCount) {
+            if (Is_Allocated(index)) {
+                int word = index >> 5;
                 ActiveCount--;
-                FreeFlag[index] = false;
+                FreeMap[word] |= 1U << (index & 31);
+                FreeSummary[word >> 5] |= 1U << (word & 31);
                 return (true);
             }
         }
@@ -311,7 +380,9 @@ void FixedHeapClass::Clear(void)
     IsAllocated = false;
     ActiveCount = 0;
     TotalCount = 0;
-    FreeFlag.Clear();
+    delete[] FreeMap;
+    FreeMap = 0;
+    FreeSummary = 0;
 }
 
 /***********************************************************************************************
@@ -332,7 +403,20 @@ void FixedHeapClass::Clear(void)
 int FixedHeapClass::Free_All(void)
 {
     ActiveCount = 0;
-    FreeFlag.Reset();
+
+    /*
+    **	Every sub-block is free. The unused bits at the end of the last word are
+    **	left clear so that they are never handed out.
+    */
+    int words = (TotalCount + 31) / 32;
+    for (int index = 0; index < words; index++) {
+        int bits = TotalCount - (index << 5);
+        FreeMap[index] = (bits >= 32) ? ~0U : ((1U << bits) - 1);
+    }
+    for (int index = 0; index < (words + 31) / 32; index++) {
+        int bits = words - (index << 5);
+        FreeSummary[index] = (bits >= 32) ? ~0U : ((1U << bits) - 1);
+    }
     return (true);
 }
 
@@ -356,9 +440,24 @@ int FixedHeapClass::Free_All(void)
 int FixedIHeapClass::Free_All(void)
 {
     ActivePointers.Delete_All();
+    NextSequence = 0;
     return (FixedHeapClass::Free_All());
 }
 
+/***********************************************************************************************
+ * FixedIHeapClass::~FixedIHeapClass -- Destructor for the iterable heap class.                *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+FixedIHeapClass::~FixedIHeapClass(void)
+{
+    FixedIHeapClass::Clear();
+}
+
 /***********************************************************************************************
  * FixedIHeapClass::Clear -- Clears the fixed heap of all entries.                             *
  *                                                                                             *
@@ -379,6 +478,9 @@ void FixedIHeapClass::Clear(void)
 {
     FixedHeapClass::Clear();
     ActivePointers.Clear();
+    delete[] Sequence;
+    Sequence = 0;
+    NextSequence = 0;
 }
 
 /***********************************************************************************************
@@ -404,6 +506,9 @@ int FixedIHeapClass::Set_Heap(int count, void* buffer)
     Clear();
     if (FixedHeapClass::Set_Heap(count, buffer)) {
         ActivePointers.Resize(count);
+        if (count) {
+            Sequence = new unsigned[count];
+        }
         return (true);
     }
     return (false);
@@ -426,14 +531,90 @@ int FixedIHeapClass::Set_Heap(int count, void* buffer)
  *=============================================================================================*/
 void* FixedIHeapClass::Allocate(void)
 {
-    void* ptr = FixedHeapClass::Allocate();
+    void* ptr = 0;
+    if (ActiveCount < TotalCount) {
+        ptr = Activate(First_Free());
+    }
     if (ptr) {
-        ActivePointers.Add(ptr);
         memset(ptr, 0, Size);
     }
     return (ptr);
 }
 
+/***********************************************************************************************
+ * FixedIHeapClass::Activate -- Allocates the specified sub-block and makes it active.         *
+ *                                                                                             *
+ *    The sub-block is allocated and added to the end of the active pointer list. It is given  *
+ *    the next allocation sequence number so that it can be found in the active list later     *
+ *    on.                                                                                      *
+ *                                                                                             *
+ * INPUT:   index -- The index number of the sub-block to allocate.                            *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the sub-block. If it could not be allocated then NULL is *
+ *          returned.                                                                          *
+ *                                                                                             *
+ * WARNINGS:   The contents of the sub-block are not cleared.                                  *
+ *=============================================================================================*/
+void* FixedIHeapClass::Activate(int index)
+{
+    void* ptr = FixedHeapClass::Allocate_At(index);
+    if (ptr) {
+
+        /*
+        **	If the sequence numbers have run out, then renumber the active
+        **	objects. Their order is not changed by this.
+        */
+        if (NextSequence == UINT_MAX) {
+            for (int active = 0; active < ActivePointers.Count(); active++) {
+                Sequence[ID(ActivePointers[active])] = active;
+            }
+            NextSequence = ActivePointers.Count();
+        }
+
+        Sequence[index] = NextSequence++;
+        ActivePointers.Add(ptr);
+    }
+    return (ptr);
+}
+
+/***********************************************************************************************
+ * FixedIHeapClass::Active_Index -- Finds the position of an object in the active list.        *
+ *                                                                                             *
+ *    The active pointer list is always in allocation order, so the object can be located      *
+ *    with a binary search on the allocation sequence numbers.                                 *
+ *                                                                                             *
+ * INPUT:   pointer -- Pointer to an allocated block in the heap.                              *
+ *                                                                                             *
+ * OUTPUT:  Returns with the position of the object in the active pointer list. If the pointer *
+ *          is not to an allocated block then -1 is returned.                                  *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int FixedIHeapClass::Active_Index(void const* pointer) const
+{
+    int id = ID(pointer);
+    if (id < 0 || id >= TotalCount || !Is_Allocated(id)) {
+        return (-1);
+    }
+
+    unsigned sequence = Sequence[id];
+    int low = 0;
+    int high = ActivePointers.Count() - 1;
+    while (low <= high) {
+        int middle = (low + high) >> 1;
+        unsigned value = Sequence[ID(ActivePointers[middle])];
+        if (value == sequence) {
+            return (middle);
+        }
+        if (value < sequence) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return (-1);
+}
+
 /***********************************************************************************************
  * FixedIHeapClass::Free -- Frees an object in the heap.                                       *
  *                                                                                             *
@@ -452,8 +633,9 @@ void* FixedIHeapClass::Allocate(void)
  *=============================================================================================*/
 int FixedIHeapClass::Free(void* pointer)
 {
-    if (FixedHeapClass::Free(pointer)) {
-        ActivePointers.Delete(pointer);
+    int index = Active_Index(pointer);
+    if (index != -1 && FixedHeapClass::Free(pointer)) {
+        ActivePointers.Delete(index);
     }
     return (false);
 }
@@ -471,7 +653,7 @@ int FixedIHeapClass::Free(void* pointer)
  *          be used as a regular index into the heap until such time as the heap has been      *
  *          compacted (by some means or another) without modifying the block order.            *
  *                                                                                             *
- * WARNINGS:   Runs in linear time.                                                            *
+ * WARNINGS:   none                                                                            *
  *                                                                                             *
  * HISTORY:                                                                                    *
  *   05/06/1996 JLB : Created.                                                                 *
@@ -479,11 +661,7 @@ int FixedIHeapClass::Free(void* pointer)
 int FixedIHeapClass::Logical_ID(void const* pointer) const
 {
     if (pointer != NULL) {
-        for (int index = 0; index < Count(); index++) {
-            if (Active_Ptr(index) == pointer) {
-                return (index);
-            }
-        }
+        return (Active_Index(pointer));
     }
     return (-1);
 }
@@ -576,10 +754,10 @@ template <class T> int TFixedIHeapClass<T>::Load(Straw& file)
         /*
         ** Get a pointer to the object, activate that object
         */
-        ptr = (T*)(*this)[idx];
-        FreeFlag[idx] = true;
-        ActiveCount++;
-        ActivePointers.Add(ptr);
+        ptr = (T*)Activate(idx);
+        if (ptr == NULL) {
+            return (false);
+        }
 
         /*
         ** Load the object
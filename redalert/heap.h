@@ -76,6 +76,14 @@ public:
     {
         return ((char*)Buffer) + (index * Size);
     };
+
+    /*
+    **	Does the address fall inside one of the heap's blocks?
+    */
+    bool Contains(void const* pointer) const
+    {
+        return (pointer >= Buffer && (char const*)pointer < (char const*)Buffer + TotalCount * Size);
+    };
     void const* operator[](int index) const
     {
         return ((char*)Buffer) + (index * Size);
@@ -110,9 +118,20 @@ protected:
     void* Buffer;
 
     /*
-    **	This is a boolean vector array of allocation flag bits.
+    **	This is a bit array with a bit set for every free sub-block. The summary array
+    **	has a bit set for every word of the free array that still has a free sub-block
+    **	in it. Together they allow the lowest free sub-block to be found without having
+    **	to scan through the whole heap.
     */
-    BooleanVectorClass FreeFlag;
+    unsigned* FreeMap;
+    unsigned* FreeSummary;
+
+    int First_Free(void) const;
+    bool Is_Allocated(int index) const
+    {
+        return ((FreeMap[index >> 5] & (1U << (index & 31))) == 0);
+    };
+    void* Allocate_At(int index);
 
 private:
     // The assignment operator is not supported.
@@ -161,14 +180,16 @@ public:
 **	This is a derivative of the fixed heap class. This class adds the
 **	ability to quickly iterate through the active (allocated) objects. Since the
 **	active array is a sequence of pointers, the overhead of this class
-**	is 4 bytes per potential allocated object (be warned).
+**	is 8 bytes per potential allocated object (be warned).
 */
 class FixedIHeapClass : public FixedHeapClass
 {
 public:
     FixedIHeapClass(int size)
-        : FixedHeapClass(size){};
-    virtual ~FixedIHeapClass(void){};
+        : FixedHeapClass(size)
+        , Sequence(0)
+        , NextSequence(0){};
+    virtual ~FixedIHeapClass(void);
 
     virtual int Set_Heap(int count, void* buffer = 0);
     virtual void* Allocate(void);
@@ -193,10 +214,22 @@ public:
     /*
     **	This is an array of pointers to allocated objects. Using this array
     **	to control iteration through the objects ensures a minimum of processing.
-    **	It also allows access to this array so that custom sorting can be
-    **	performed.
+    **	The objects are kept in the order they were allocated in, which must not
+    **	be changed since the game logic relies on it for a consistent order.
     */
     DynamicVectorClass<void*> ActivePointers;
+
+protected:
+    int Active_Index(void const* pointer) const;
+    void* Activate(int index);
+
+    /*
+    **	The order in which each sub-block was allocated. The active pointer array is
+    **	always in allocation order, so this allows an object to be found in it by a
+    **	binary search rather than by comparing against every active object.
+    */
+    unsigned* Sequence;
+    unsigned NextSequence;
 };
 
 /**************************************************************************
@@ -4499,6 +4499,7 @@ void HouseClass::Sell_Wall(CELL cell)
                     Map[cell].Overlay = OVERLAY_NONE;
                     Map[cell].OverlayData = 0;
                     Map[cell].Owner = HOUSE_NONE;
+                    Map[cell].Flag_Changed(CellClass::CHANGE_OVERLAY);
                     Map[cell].Wall_Update();
                     CellClass* ncell = Map[cell].Adjacent_Cell(FACING_N);
                     if (ncell)
@@ -7038,60 +7039,70 @@ void HouseClass::Recalc_Attributes(void)
 
     /*
     **	A second pass through the sentient objects is required so that the appropriate scan
-    **	bits will be set for the owner house.
+    **	bits will be set for the owner house. The values needed are read from the compact
+    **	techno state tables rather than from the objects themselves.
     */
-    for (index = 0; index < Units.Count(); index++) {
-        UnitClass const* unit = Units.Ptr(index);
-        unit->House->UScan |= (1L << unit->Class->Type);
-        if (unit->IsLocked && (Session.Type != GAME_NORMAL || !unit->House->IsHuman || unit->IsDiscoveredByPlayer)) {
-            if (!unit->IsInLimbo) {
-                unit->House->ActiveUScan |= (1L << unit->Class->Type);
+    bool normal = (Session.Type == GAME_NORMAL);
+    for (index = 0; index < 5; index++) {
+        static RTTIType const _kinds[5] = {RTTI_UNIT, RTTI_INFANTRY, RTTI_AIRCRAFT, RTTI_BUILDING, RTTI_VESSEL};
+        RTTIType rtti = _kinds[index];
+        TechnoStateClass::TableType const& table = TechnoState.Table(rtti);
+
+        for (int id = 0; id < table.Top; id++) {
+            if (table.House[id] == -1) {
+                continue;
             }
-        }
-    }
-    for (index = 0; index < Infantry.Count(); index++) {
-        InfantryClass const* infantry = Infantry.Ptr(index);
-        infantry->House->IScan |= (1L << infantry->Class->Type);
-        if (infantry->IsLocked
-            && (Session.Type != GAME_NORMAL || !infantry->House->IsHuman || infantry->IsDiscoveredByPlayer)) {
-            if (!infantry->IsInLimbo) {
-                infantry->House->ActiveIScan |= (1L << infantry->Class->Type);
-                infantry->House->OldIScan |= (1L << infantry->Class->Type);
+
+            int type = table.Type[id];
+            if (rtti == RTTI_BUILDING && type >= 32) {
+                continue;
             }
-        }
-    }
-    for (index = 0; index < Aircraft.Count(); index++) {
-        AircraftClass const* aircraft = Aircraft.Ptr(index);
-        aircraft->House->AScan |= (1L << aircraft->Class->Type);
-        if (aircraft->IsLocked
-            && (Session.Type != GAME_NORMAL || !aircraft->House->IsHuman || aircraft->IsDiscoveredByPlayer)) {
-            if (!aircraft->IsInLimbo) {
-                aircraft->House->ActiveAScan |= (1L << aircraft->Class->Type);
-                aircraft->House->OldAScan |= (1L << aircraft->Class->Type);
-            }
-        }
-    }
-    for (index = 0; index < Buildings.Count(); index++) {
-        BuildingClass const* building = Buildings.Ptr(index);
-        if (building->Class->Type < 32) {
-            building->House->BScan |= (1L << building->Class->Type);
-            if (building->IsLocked
-                && (Session.Type != GAME_NORMAL || !building->House->IsHuman || building->IsDiscoveredByPlayer)) {
-                if (!building->IsInLimbo) {
-                    building->House->ActiveBScan |= (1L << building->Class->Type);
-                    building->House->OldBScan |= (1L << building->Class->Type);
+
+            HouseClass* house = (HouseClass*)Houses[table.House[id]];
+            int flags = table.Flags[id];
+            bool active = (flags & TechnoStateClass::IS_LOCKED) && !(flags & TechnoStateClass::IS_IN_LIMBO)
+                          && (!normal || !house->IsHuman || (flags & TechnoStateClass::IS_DISCOVERED_BY_PLAYER));
+            long bit = (1L << type);
+
+            switch (rtti) {
+            case RTTI_UNIT:
+                house->UScan |= bit;
+                if (active) {
+                    house->ActiveUScan |= bit;
                 }
-            }
-        }
-    }
-    for (index = 0; index < Vessels.Count(); index++) {
-        VesselClass const* vessel = Vessels.Ptr(index);
-        vessel->House->VScan |= (1L << vessel->Class->Type);
-        if (vessel->IsLocked
-            && (Session.Type != GAME_NORMAL || !vessel->House->IsHuman || vessel->IsDiscoveredByPlayer)) {
-            if (!vessel->IsInLimbo) {
-                vessel->House->ActiveVScan |= (1L << vessel->Class->Type);
-                vessel->House->OldVScan |= (1L << vessel->Class->Type);
+                break;
+
+            case RTTI_INFANTRY:
+                house->IScan |= bit;
+                if (active) {
+                    house->ActiveIScan |= bit;
+                    house->OldIScan |= bit;
+                }
+                break;
+
+            case RTTI_AIRCRAFT:
+                house->AScan |= bit;
+                if (active) {
+                    house->ActiveAScan |= bit;
+                    house->OldAScan |= bit;
+                }
+                break;
+
+            case RTTI_BUILDING:
+                house->BScan |= bit;
+                if (active) {
+                    house->ActiveBScan |= bit;
+                    house->OldBScan |= bit;
+                }
+                break;
+
+            default:
+                house->VScan |= bit;
+                if (active) {
+                    house->ActiveVScan |= bit;
+                    house->OldVScan |= bit;
+                }
+                break;
             }
         }
     }
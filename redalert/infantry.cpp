@@ -208,6 +208,8 @@ InfantryClass::InfantryClass(InfantryType classid, HousesType house)
     **	Civilians carry much less ammo than soldiers do.
     */
     Ammo = Class->MaxAmmo;
+
+    TechnoState.Update(this);
 }
 
 /***********************************************************************************************
@@ -288,6 +290,8 @@ void InfantryClass::operator delete(void* ptr)
     if (ptr != NULL) {
         ((InfantryClass*)ptr)->IsActive = false;
     }
+    TechnoState.Remove(RTTI_INFANTRY, Infantry.ID((InfantryClass*)ptr));
+    StateHash.Remove(RTTI_INFANTRY, Infantry.ID((InfantryClass*)ptr));
     Infantry.Free((InfantryClass*)ptr);
 }
 
@@ -2425,6 +2429,7 @@ bool InfantryClass::Unlimbo(COORDINATE coord, DirType facing)
         */
         if (Class->SightRange == 0) {
             IsDiscoveredByPlayer = false;
+            TechnoState.Update(this);
         }
 
         Set_Occupy_Bit(coord);
@@ -168,15 +168,6 @@ static void Load_Prolog_Page(void)
 bool Init_Game(int, char*[])
 {
     bool dosmode = (RESFACTOR == 1);
-/*
-**	Allocate the benchmark tracking objects only if the machine and
-**	compile flags indicate.
-*/
-#if 0
-    if (Processor() >= 2) {
-        Benches = new Benchmark[BENCH_COUNT];
-    }
-#endif
 
     /*
     **	Initialize the encryption keys.
@@ -1304,6 +1295,7 @@ void Anim_Init(void)
 #endif
     AnimControl.Vmode = 0;
     AnimControl.OptionFlags |= VQAOPTF_CAPTIONS | VQAOPTF_EVA;
+    AnimControl.OptionFlags |= VQAOPTF_PIPELINE;
     if (SlowPalette) {
         AnimControl.OptionFlags |= VQAOPTF_SLOWPAL;
     }
@@ -1501,6 +1493,27 @@ bool Parse_Command_Line(int argc, char* argv[])
             continue;
         }
 
+        /*
+        **	Frame profiler. "-PROFILE" shows the timing overlay on the tactical map while
+        **	"-PROFILETRACE:<frames>" writes a trace of the first frames of play to disk.
+        */
+        if (strstr(string, "-PROFILETRACE")) {
+            if (Benches == NULL) {
+                Benches = new ProfilerClass;
+            }
+            char const* frames = strchr(string, ':');
+            Benches->Start_Trace(frames != NULL ? atoi(frames + 1) : 300);
+            continue;
+        }
+
+        if (strstr(string, "-PROFILE")) {
+            if (Benches == NULL) {
+                Benches = new ProfilerClass;
+            }
+            Benches->Show_Overlay(true);
+            continue;
+        }
+
 #ifdef CHEAT_KEYS
         /*
         **	Specify the random number seed (for debugging)
@@ -2061,6 +2074,8 @@ static void Init_Heaps(void)
     Teams.Set_Heap(Rule.TeamMax);
     Houses.Set_Heap(HOUSE_MAX);
     TriggerTypes.Set_Heap(Rule.TrigTypeMax);
+    TechnoState.Init();
+    StateHash.Init();
     //	Weapons.Set_Heap(Rule.WeaponMax);
 
     /*
@@ -56,6 +56,8 @@
  *   IPXManagerClass::Set_Bridge -- prepares to cross a bridge             *
  *   IPXManagerClass::Set_Socket -- sets socket ID for all connections		*
  *   IPXManagerClass::Response_Time -- Returns largest Avg Response Time   *
+ *   IPXManagerClass::Percentile_Response_Time -- largest percentile       *
+ *   IPXManagerClass::Response_Jitter -- Returns largest jitter            *
  *   IPXManagerClass::Global_Response_Time -- Returns Avg Response Time    *
  *   IPXManagerClass::Reset_Response_Time -- Reset response time 				*
  *   IPXManagerClass::Oldest_Send -- gets ptr to oldest send buf           *
@@ -1409,6 +1411,66 @@ unsigned int IPXManagerClass::Response_Time(void)
 
 } /* end of Response_Time */
 
+/***************************************************************************
+ * IPXManagerClass::Percentile_Response_Time -- largest percentile         *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		percent		percentile of the recent response times to use				*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		largest response time percentile of all connections						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *                                                                         *
+ *=========================================================================*/
+unsigned int IPXManagerClass::Percentile_Response_Time(int percent)
+{
+    unsigned int resp;
+    unsigned int maxresp = 0;
+    int i;
+
+    for (i = 0; i < NumConnections; i++) {
+        resp = Connection[i]->Queue->Percentile_Response_Time(percent);
+        if (resp > maxresp) {
+            maxresp = resp;
+        }
+    }
+
+    return (maxresp);
+
+} /* end of Percentile_Response_Time */
+
+/***************************************************************************
+ * IPXManagerClass::Response_Jitter -- Returns largest jitter              *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none.																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		largest variation in response time of all connections					*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *                                                                         *
+ *=========================================================================*/
+unsigned int IPXManagerClass::Response_Jitter(void)
+{
+    unsigned int jitter;
+    unsigned int maxjitter = 0;
+    int i;
+
+    for (i = 0; i < NumConnections; i++) {
+        jitter = Connection[i]->Queue->Response_Jitter();
+        if (jitter > maxjitter) {
+            maxjitter = jitter;
+        }
+    }
+
+    return (maxjitter);
+
+} /* end of Response_Jitter */
+
 /***************************************************************************
  * IPXManagerClass::Global_Response_Time -- Returns Avg Response Time      *
  *                                                                         *
@@ -219,6 +219,8 @@ public:
     reset the response time for all queues.
     .....................................................................*/
     virtual unsigned int Response_Time(void);
+    virtual unsigned int Percentile_Response_Time(int percent);
+    virtual unsigned int Response_Jitter(void);
     unsigned int Global_Response_Time(void);
     virtual void Reset_Response_Time(void);
 
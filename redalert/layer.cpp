@@ -77,8 +77,8 @@ bool LayerClass::Submit(ObjectClass const* object, bool sort)
  * OUTPUT:  none                                                                               *
  *                                                                                             *
  * WARNINGS:   Don't call this routine too often since it does take a bit of time to           *
- *             execute. It is a single pass binary sort and thus isn't horribly slow,          *
- *             but it does take some time.                                                     *
+ *             execute. Unless the rules ask for a full sort, it is a single pass binary       *
+ *             sort and thus isn't horribly slow, but it does take some time.                  *
  *                                                                                             *
  * HISTORY:                                                                                    *
  *   10/17/1994 JLB : Created.                                                                 *
@@ -86,13 +86,63 @@ bool LayerClass::Submit(ObjectClass const* object, bool sort)
  *=============================================================================================*/
 void LayerClass::Sort(void)
 {
-    for (int index = 0; index < Count() - 1; index++) {
-        if (*(*this)[index + 1] < *(*this)[index]) {
-            ObjectClass* temp;
+    int count = Count();
+    if (count < 2) {
+        return;
+    }
+
+    /*
+    **	Fetch the sort key of every object just once, so that the comparisons don't have to
+    **	keep calling the virtual Sort_Y() function. The keys are moved along with the objects.
+    */
+    static VectorClass<COORDINATE> _keys;
+    if ((int)_keys.Length() < count) {
+        _keys.Resize(count + 64);
+    }
+    for (int index = 0; index < count; index++) {
+        _keys[index] = (*this)[index]->Sort_Y();
+    }
+
+    if (Rule.IsSortLayers) {
 
-            temp = (*this)[index + 1];
-            (*this)[index + 1] = (*this)[index];
-            (*this)[index] = temp;
+        /*
+        **	Full insertion sort. Objects only move a little each frame, so the layer is nearly
+        **	in order already and this takes close to linear time. Objects with the same key
+        **	keep their relative order.
+        */
+        for (int index = 1; index < count; index++) {
+            COORDINATE key = _keys[index];
+            if (key < _keys[index - 1]) {
+                ObjectClass* object = (*this)[index];
+                int pos = index;
+                while (pos > 0 && key < _keys[pos - 1]) {
+                    _keys[pos] = _keys[pos - 1];
+                    (*this)[pos] = (*this)[pos - 1];
+                    pos--;
+                }
+                _keys[pos] = key;
+                (*this)[pos] = object;
+            }
+        }
+    } else {
+
+        /*
+        **	A single pass that moves each object at most one position back. The layer order
+        **	feeds into the game logic, so this must stay exactly as it always was unless the
+        **	rules ask otherwise.
+        */
+        for (int index = 0; index < count - 1; index++) {
+            if (_keys[index + 1] < _keys[index]) {
+                ObjectClass* temp;
+
+                temp = (*this)[index + 1];
+                (*this)[index + 1] = (*this)[index];
+                (*this)[index] = temp;
+
+                COORDINATE key = _keys[index + 1];
+                _keys[index + 1] = _keys[index];
+                _keys[index] = key;
+            }
         }
     }
 }
@@ -137,9 +187,10 @@ int LayerClass::Sorted_Add(ObjectClass const* const object)
     /*
     **	There is room for the new object now. Add it to the right sorted position.
     */
+    COORDINATE key = object->Sort_Y();
     int index;
     for (index = 0; index < ActiveCount; index++) {
-        if ((*(*this)[index]) > (*object)) {
+        if ((*this)[index]->Sort_Y() > key) {
             break;
         }
     }
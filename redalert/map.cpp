@@ -52,6 +52,8 @@
  *   MapClass::Remove_Crate -- Remove a crate from the specified cell.                         *
  *   MapClass::Set_Map_Dimensions -- Initialize the map.                                       *
  *   MapClass::Sight_From -- Mark as visible the cells within a specified radius.              *
+ *   MapClass::Tiberium_Placed -- Records that ore has been placed in a cell.                  *
+ *   MapClass::Tiberium_Rebuild -- Rebuilds the record of which cells hold ore.                *
  *   MapClass::Validate -- validates every cell on the map                                     *
  *   MapClass::Write_Binary -- Pipes the map template data to the destination specified.       *
  *   MapClass::Zone_Reset -- Resets all zone numbers to match the map.                         *
@@ -64,6 +66,35 @@
 #include "lcwstraw.h"
 #include "common/endianness.h"
 
+/*
+**	A bit for every cell that has (or recently had) ore in it. Only these cells can grow or
+**	spread ore, so the ore scan in MapClass::Logic() skips everything else. A set bit does
+**	not guarantee that the ore is still there, but every cell with ore has its bit set.
+*/
+static unsigned TiberiumCells[MAP_CELL_TOTAL / 32];
+
+static inline bool Is_Ore_Overlay(OverlayType overlay)
+{
+    return (overlay == OVERLAY_GOLD1 || overlay == OVERLAY_GOLD2 || overlay == OVERLAY_GOLD3
+            || overlay == OVERLAY_GOLD4);
+}
+
+/*
+**	The entries of RadiusOffset that lie within each sight range, kept in the same order. Whether
+**	an offset is in range only depends on the offset, so the distance check is done once when the
+**	map is set up instead of for every cell of every sighting. The X distance is kept so that
+**	offsets that wrap around the edge of the map can still be thrown out.
+*/
+struct SightOffsetType
+{
+    int Offset; // Cell number offset from the center cell.
+    int X;      // Cell X coordinate offset from the center cell.
+};
+
+static SightOffsetType SightOffsets[11][309];
+static int SightCount[11]; // Number of offsets within each range.
+static int SightInner[11]; // Number of those offsets that an incremental scan skips.
+
 #define MCW MAP_CELL_W
 int const MapClass::RadiusOffset[] = {
     /* 0  */ 0,
@@ -410,6 +441,34 @@ void MapClass::One_Time(void)
     **	Allocate the cell array.
     */
     Alloc_Cells();
+
+    /*
+    **	Build the table of sight offsets for each range. The test cell is in the middle of the
+    **	map so that none of the offsets wrap.
+    */
+    CELL center = XY_Cell(MAP_CELL_W / 2, MAP_CELL_H / 2);
+    for (int range = 0; range < ARRAY_SIZE(RadiusCount); range++) {
+        int inner = (range > 2) ? RadiusCount[range - 3] : 0;
+        int count = 0;
+
+        for (int index = 0; index < RadiusCount[range]; index++) {
+            if (index == inner) {
+                SightInner[range] = count;
+            }
+
+            CELL newcell = center + RadiusOffset[index];
+            int xdiff = Cell_X(newcell) - Cell_X(center);
+            if (ABS(xdiff) > range)
+                continue;
+            if (Distance(Cell_Coord(newcell), Cell_Coord(center)) > (range * CELL_LEPTON_W))
+                continue;
+
+            SightOffsets[range][count].Offset = RadiusOffset[index];
+            SightOffsets[range][count].X = xdiff;
+            count++;
+        }
+        SightCount[range] = count;
+    }
 }
 
 /***********************************************************************************************
@@ -431,6 +490,7 @@ void MapClass::Init_Clear(void)
 {
     GScreenClass::Init_Clear();
     Init_Cells();
+    memset(TiberiumCells, 0, sizeof(TiberiumCells));
     TiberiumScan = 0;
     TiberiumGrowthCount = 0;
     TiberiumGrowthExcess = 0;
@@ -575,9 +635,10 @@ void MapClass::Set_Map_Dimensions(int x, int y, int w, int h)
  *=============================================================================================*/
 void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool incremental)
 {
-    int xx;         // Center cell X coordinate (bounds checking).
-    int const* ptr; // Offset pointer.
-    int count;      // Counter for number of offsets to process.
+    int xx;                     // Center cell X coordinate (bounds checking).
+    SightOffsetType const* ptr; // Offset pointer.
+    int count;                  // Counter for number of offsets to process.
+    unsigned int seen;          // House bit of cells that need no further mapping.
 
     /*
     **	Units that are off-map cannot sight.
@@ -596,13 +657,29 @@ void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool inc
     **	Incremental scans only scan the outer rings. Full scans
     **	scan all internal cells as well.
     */
-    count = RadiusCount[sightrange];
-    ptr = &RadiusOffset[0];
+    count = SightCount[sightrange];
+    ptr = &SightOffsets[sightrange][0];
     if (incremental) {
-        if (sightrange > 2) {
-            ptr += RadiusCount[sightrange - 3];
-            count -= RadiusCount[sightrange - 3];
+        ptr += SightInner[sightrange];
+        count -= SightInner[sightrange];
+    }
+
+    /*
+    **	Map_Cell() does nothing at all with a cell that is already both mapped and visible for
+    **	the house that it maps for, so such cells are skipped here. This is the same house that
+    **	Map_Cell() will pick. The multiplayer version can also map for other players, so every
+    **	cell is passed on in that case.
+    */
+    seen = 0;
+    if (house != NULL && Session.Type != GAME_GLYPHX_MULTIPLAYER) {
+        HouseClass* mapper = house;
+        if (mapper != PlayerPtr) {
+            if (mapper->RadarSpied & (1 << (PlayerPtr->Class->House)))
+                mapper = PlayerPtr;
+            if (Session.Type == GAME_NORMAL && mapper->Is_Ally(PlayerPtr))
+                mapper = PlayerPtr;
         }
+        seen = 1 << mapper->Class->House;
     }
 
     /*
@@ -612,7 +689,9 @@ void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool inc
         CELL newcell; // New cell with offset.
         int xdiff;    // New cell's X coordinate distance from center.
 
-        newcell = cell + *ptr++;
+        newcell = cell + ptr->Offset;
+        xdiff = ptr->X;
+        ptr++;
 
         /*
         **	Determine if the map edge has been wrapped. If so,
@@ -620,11 +699,11 @@ void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool inc
         */
         if ((unsigned)newcell >= MAP_CELL_TOTAL)
             continue;
-        xdiff = Cell_X(newcell) - xx;
-        xdiff = ABS(xdiff);
-        if (xdiff > sightrange)
+        if (Cell_X(newcell) - xx != xdiff)
             continue;
-        if (Distance(Cell_Coord(newcell), Cell_Coord(cell)) > (sightrange * CELL_LEPTON_W))
+
+        CellClass const& cellref = (*this)[newcell];
+        if (cellref.IsMappedByPlayerMask & cellref.IsVisibleByPlayerMask & seen)
             continue;
 
         /*
@@ -659,9 +738,9 @@ void MapClass::Sight_From(CELL cell, int sightrange, HouseClass* house, bool inc
  *=============================================================================================*/
 void MapClass::Shroud_From(CELL cell, int sightrange, HouseClass* house)
 {
-    int xx;         // Center cell X coordinate (bounds checking).
-    int const* ptr; // Offset pointer.
-    int count;      // Counter for number of offsets to process.
+    int xx;                     // Center cell X coordinate (bounds checking).
+    SightOffsetType const* ptr; // Offset pointer.
+    int count;                  // Counter for number of offsets to process.
 
     /*
     **	Units that are off-map cannot sight.
@@ -680,8 +759,8 @@ void MapClass::Shroud_From(CELL cell, int sightrange, HouseClass* house)
     **	Incremental scans only scan the outer rings. Full scans
     **	scan all internal cells as well.
     */
-    count = RadiusCount[sightrange];
-    ptr = &RadiusOffset[0];
+    count = SightCount[sightrange];
+    ptr = &SightOffsets[sightrange][0];
 
     /*
     **	Process all offsets required for the desired scan.
@@ -690,7 +769,9 @@ void MapClass::Shroud_From(CELL cell, int sightrange, HouseClass* house)
         CELL newcell; // New cell with offset.
         int xdiff;    // New cell's X coordinate distance from center.
 
-        newcell = cell + *ptr++;
+        newcell = cell + ptr->Offset;
+        xdiff = ptr->X;
+        ptr++;
 
         /*
         **	Determine if the map edge has been wrapped. If so,
@@ -698,11 +779,7 @@ void MapClass::Shroud_From(CELL cell, int sightrange, HouseClass* house)
         */
         if ((unsigned)newcell >= MAP_CELL_TOTAL)
             continue;
-        xdiff = Cell_X(newcell) - xx;
-        xdiff = ABS(xdiff);
-        if (xdiff > sightrange)
-            continue;
-        if (Distance(Cell_Coord(newcell), Cell_Coord(cell)) > (sightrange * CELL_LEPTON_W))
+        if (Cell_X(newcell) - xx != xdiff)
             continue;
 
         /*
@@ -734,9 +811,9 @@ void MapClass::Shroud_From(CELL cell, int sightrange, HouseClass* house)
  *=============================================================================================*/
 void MapClass::Jam_From(CELL cell, int jamrange, HouseClass* house)
 {
-    int xx;         // Center cell X coordinate (bounds checking).
-    int const* ptr; // Offset pointer.
-    int count;      // Counter for number of offsets to process.
+    int xx;                     // Center cell X coordinate (bounds checking).
+    SightOffsetType const* ptr; // Offset pointer.
+    int count;                  // Counter for number of offsets to process.
 
     /*
     **	Units that are off-map cannot jam.
@@ -753,8 +830,8 @@ void MapClass::Jam_From(CELL cell, int jamrange, HouseClass* house)
     **	Incremental scans only scan the outer rings. Full scans
     **	scan all internal cells as well.
     */
-    count = RadiusCount[jamrange];
-    ptr = &RadiusOffset[0];
+    count = SightCount[jamrange];
+    ptr = &SightOffsets[jamrange][0];
 
     /*
     **	Process all offsets required for the desired scan.
@@ -763,7 +840,9 @@ void MapClass::Jam_From(CELL cell, int jamrange, HouseClass* house)
         CELL newcell; // New cell with offset.
         int xdiff;    // New cell's X coordinate distance from center.
 
-        newcell = cell + *ptr++;
+        newcell = cell + ptr->Offset;
+        xdiff = ptr->X;
+        ptr++;
 
         /*
         **	Determine if the map edge has been wrapped. If so,
@@ -771,11 +850,7 @@ void MapClass::Jam_From(CELL cell, int jamrange, HouseClass* house)
         */
         if ((unsigned)newcell >= MAP_CELL_TOTAL)
             continue;
-        xdiff = Cell_X(newcell) - xx;
-        xdiff = ABS(xdiff);
-        if (xdiff > jamrange)
-            continue;
-        if (Distance(Cell_Coord(newcell), Cell_Coord(cell)) > (jamrange * CELL_LEPTON_W))
+        if (Cell_X(newcell) - xx != xdiff)
             continue;
 
         /*
@@ -888,9 +963,9 @@ void MapClass::Jam_From(CELL cell, int jamrange, HouseClass* house)
  *=============================================================================================*/
 void MapClass::UnJam_From(CELL cell, int jamrange, HouseClass* house)
 {
-    int xx;         // Center cell X coordinate (bounds checking).
-    int const* ptr; // Offset pointer.
-    int count;      // Counter for number of offsets to process.
+    int xx;                     // Center cell X coordinate (bounds checking).
+    SightOffsetType const* ptr; // Offset pointer.
+    int count;                  // Counter for number of offsets to process.
 
     /*
     **	Units that are off-map cannot jam.
@@ -907,8 +982,8 @@ void MapClass::UnJam_From(CELL cell, int jamrange, HouseClass* house)
     **	Incremental scans only scan the outer rings. Full scans
     **	scan all internal cells as well.
     */
-    count = RadiusCount[jamrange];
-    ptr = &RadiusOffset[0];
+    count = SightCount[jamrange];
+    ptr = &SightOffsets[jamrange][0];
 
     /*
     **	Process all offsets required for the desired scan.
@@ -917,7 +992,9 @@ void MapClass::UnJam_From(CELL cell, int jamrange, HouseClass* house)
         CELL newcell; // New cell with offset.
         int xdiff;    // New cell's X coordinate distance from center.
 
-        newcell = cell + *ptr++;
+        newcell = cell + ptr->Offset;
+        xdiff = ptr->X;
+        ptr++;
 
         /*
         **	Determine if the map edge has been wrapped. If so,
@@ -925,11 +1002,7 @@ void MapClass::UnJam_From(CELL cell, int jamrange, HouseClass* house)
         */
         if ((unsigned)newcell >= MAP_CELL_TOTAL)
             continue;
-        xdiff = Cell_X(newcell) - xx;
-        xdiff = ABS(xdiff);
-        if (xdiff > jamrange)
-            continue;
-        if (Distance(Cell_Coord(newcell), Cell_Coord(cell)) > (jamrange * CELL_LEPTON_W))
+        if (Cell_X(newcell) - xx != xdiff)
             continue;
 
         /*
@@ -1349,12 +1422,43 @@ void MapClass::Logic(void)
     }
 
     subcount = max(subcount, 1);
-    int index;
-    for (index = TiberiumScan; index < MAP_CELL_TOTAL; index++) {
-        CELL cell = index;
-        if (In_Radar(cell)) {
+
+    /*
+    **	Only cells holding ore can grow or spread, so only the cells in the ore bit array
+    **	are examined. They are visited in the same order, and so get the same random
+    **	picks, as when every cell was examined. The scan stops on (not after) the last
+    **	cell of the block, so that cell is examined again at the start of the next block.
+    */
+    int last = TiberiumScan + subcount - 1;
+    int stop = min(last, MAP_CELL_TOTAL - 1);
+    for (int word = TiberiumScan >> 5; word <= (stop >> 5); word++) {
+        unsigned bits = TiberiumCells[word];
+        if (word == (TiberiumScan >> 5)) {
+            bits &= ~0U << (TiberiumScan & 31);
+        }
+        if (word == (stop >> 5) && (stop & 31) != 31) {
+            bits &= (1U << ((stop & 31) + 1)) - 1;
+        }
+
+        while (bits != 0) {
+            int bit = Lowest_Bit(bits);
+            bits &= bits - 1;
+
+            CELL cell = (word << 5) + bit;
             CellClass* ptr = &(*this)[cell];
 
+            /*
+            **	Ore that has since been harvested away is dropped from the bit array.
+            */
+            if (!Is_Ore_Overlay(ptr->Overlay)) {
+                TiberiumCells[word] &= ~(1U << bit);
+                continue;
+            }
+
+            if (!In_Radar(cell)) {
+                continue;
+            }
+
             /*
             **	Tiberium cells can grow.
             */
@@ -1392,12 +1496,8 @@ void MapClass::Logic(void)
                 TiberiumSpreadExcess++;
             }
         }
-
-        subcount--;
-        if (subcount == 0)
-            break;
     }
-    TiberiumScan = index;
+    TiberiumScan = (last < MAP_CELL_TOTAL) ? last : MAP_CELL_TOTAL;
 
     /*
     **	When the entire map has been processed, proceed with tiberium (ore) growth
@@ -1432,6 +1532,49 @@ void MapClass::Logic(void)
     }
 }
 
+/***********************************************************************************************
+ * MapClass::Tiberium_Placed -- Records that ore has been placed in a cell.                    *
+ *                                                                                             *
+ *    This is called whenever an ore overlay is put into a cell so that the ore growth scan    *
+ *    will examine the cell.                                                                   *
+ *                                                                                             *
+ * INPUT:   cell  -- The cell that the ore was placed in.                                      *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ *=============================================================================================*/
+void MapClass::Tiberium_Placed(CELL cell)
+{
+    if ((unsigned)cell < MAP_CELL_TOTAL) {
+        TiberiumCells[cell >> 5] |= 1U << (cell & 31);
+    }
+}
+
+/***********************************************************************************************
+ * MapClass::Tiberium_Rebuild -- Rebuilds the record of which cells hold ore.                  *
+ *                                                                                             *
+ *    This scans the whole map for ore. It is needed after the cells have been loaded from a   *
+ *    saved game.                                                                              *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ *=============================================================================================*/
+void MapClass::Tiberium_Rebuild(void)
+{
+    memset(TiberiumCells, 0, sizeof(TiberiumCells));
+    for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
+        if (Is_Ore_Overlay((*this)[cell].Overlay)) {
+            Tiberium_Placed(cell);
+        }
+    }
+}
+
 /***********************************************************************************************
  * MapClass::Cell_Region -- Determines the region from a specified cell number.                *
  *                                                                                             *
@@ -1546,6 +1689,7 @@ bool MapClass::Remove_Crate(CELL cell)
     if (cellptr->Overlay != OVERLAY_NONE && OverlayTypeClass::As_Reference(cellptr->Overlay).IsCrate) {
         cellptr->Overlay = OVERLAY_NONE;
         cellptr->OverlayData = 0;
+        cellptr->Flag_Changed(CellClass::CHANGE_OVERLAY);
         return (true);
     }
     //	} else {
@@ -1800,6 +1944,11 @@ ObjectClass* MapClass::Close_Object(COORDINATE coord) const
  *=============================================================================================*/
 bool MapClass::Zone_Reset(int method)
 {
+    /*
+    **	Paths found before the change in zones can't be trusted any more.
+    */
+    PathCache.Clear();
+
     /*
     **	Zero out all zones to a null state.
     */
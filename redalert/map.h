@@ -97,6 +97,9 @@ public:
 
     int Overpass(void);
 
+    void Tiberium_Placed(CELL cell);
+    void Tiberium_Rebuild(void);
+
     virtual void Logic(void);
     virtual void Set_Map_Dimensions(int x, int y, int w, int h);
 
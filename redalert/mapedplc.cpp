@@ -1511,6 +1511,7 @@ void MapEditClass::Toggle_House(void)
     */
     tp = (TechnoClass*)PendingObjectPtr;
     tp->House = HouseClass::As_Pointer(LastHouse);
+    TechnoState.Update(tp);
 
     /*
     **	Set house variables to new house
@@ -577,6 +577,7 @@ bool MapEditClass::Change_House(HousesType newhouse)
     */
     tp = (TechnoClass*)CurrentObject[0];
     tp->House = HouseClass::As_Pointer(newhouse);
+    TechnoState.Update(tp);
 
     tp->IsOwnedByPlayer = false;
     if (tp->House == PlayerPtr) {
@@ -185,6 +185,7 @@ void MissionClass::Set_Mission(MissionType mission)
 
     Mission = mission;
     MissionQueue = MISSION_NONE;
+    StateHash.Changed(this);
 }
 
 /***********************************************************************************************
@@ -396,6 +397,7 @@ bool MissionClass::Commence(void)
     if (MissionQueue != MISSION_NONE) {
         Mission = MissionQueue;
         MissionQueue = MISSION_NONE;
+        StateHash.Changed(this);
 
         /*
         **	Force immediate state machine processing at the first state machine state value.
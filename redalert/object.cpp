@@ -1443,6 +1443,9 @@ bool ObjectClass::Limbo(void)
         Hidden();
         IsInLimbo = true;
         IsToDisplay = false;
+        if (Is_Techno()) {
+            TechnoState.Update((TechnoClass const*)this);
+        }
         return (true);
     }
     return (false);
@@ -1476,6 +1479,9 @@ bool ObjectClass::Unlimbo(COORDINATE coord, DirType)
             IsInLimbo = false;
             IsToDisplay = false;
             Coord = Class_Of().Coord_Fixup(coord);
+            if (Is_Techno()) {
+                TechnoState.Update((TechnoClass const*)this);
+            }
 
             if (Mark(MARK_DOWN)) {
                 if (IsActive) {
@@ -1650,6 +1656,7 @@ ResultType ObjectClass::Take_Damage(int& damage, int distance, WarheadType warhe
     int oldstrength = Strength;
 
     if (oldstrength && damage != 0 && (forced || !Class_Of().IsImmune)) {
+        StateHash.Changed(this);
         int maxstrength = Class_Of().MaxStrength;
 
         /*
@@ -1794,6 +1801,14 @@ bool ObjectClass::Mark(MarkType mark)
     assert(this != 0);
     assert(IsActive);
 
+    /*
+    **	Picking an object up or putting it down only happens when it moves or enters or leaves
+    **	the map, so its state hash needs to be updated.
+    */
+    if (mark == MARK_UP || mark == MARK_DOWN) {
+        StateHash.Changed(this);
+    }
+
     if (!IsInLimbo && IsActive) {
 
         /*
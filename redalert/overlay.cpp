@@ -216,6 +216,7 @@ bool OverlayClass::Mark(MarkType mark)
                     if (Class->Land == LAND_TIBERIUM) {
                         cellptr->OverlayData = 1;
                         cellptr->Tiberium_Adjust();
+                        Map.Tiberium_Placed(cell);
                     }
                 }
             }
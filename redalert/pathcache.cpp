@@ -0,0 +1,266 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "function.h"
+
+/*
+**	Facing to move in to get from one cell to a neighbouring cell, indexed by the X and Y
+**	offsets (each plus one) between them.
+*/
+static FacingType const NeighbourFacing[3][3] = {
+    {FACING_NW, FACING_N, FACING_NE},
+    {FACING_W, FACING_NONE, FACING_E},
+    {FACING_SW, FACING_S, FACING_SE},
+};
+
+PathCacheClass::PathCacheClass(void)
+    : Hits(0)
+    , Misses(0)
+    , UseCount(0)
+{
+    Clear();
+}
+
+int PathCacheClass::Region(CELL cell)
+{
+    return ((Cell_Y(cell) >> REGION_SHIFT) * (MAP_CELL_W >> REGION_SHIFT) + (Cell_X(cell) >> REGION_SHIFT));
+}
+
+/*
+**	Forget every path. Used whenever the movement zones are rebuilt and when a scenario
+**	is cleared or loaded.
+*/
+void PathCacheClass::Clear(void)
+{
+    for (int index = 0; index < MAXIMUM_ENTRIES; index++) {
+        Entries[index].IsActive = false;
+    }
+}
+
+/*
+**	Forget every path that passes through the region holding the cell specified. This is
+**	called when something lasting changes about whether the cell can be entered.
+*/
+void PathCacheClass::Invalidate(CELL cell)
+{
+    int region = Region(cell);
+    unsigned int bit = 1U << (region & 31);
+
+    for (int index = 0; index < MAXIMUM_ENTRIES; index++) {
+        EntryType& entry = Entries[index];
+        if (entry.IsActive && (entry.Regions[region >> 5] & bit)) {
+            entry.IsActive = false;
+        }
+    }
+}
+
+/*
+**	Looks for a cached path to the destination in the key that passes through or next to the
+**	source cell. The rest of that path, from the point closest to the destination that the
+**	source touches, is copied into the move list. Returns the number of moves copied or zero
+**	if no suitable path is known.
+*/
+int PathCacheClass::Fetch(KeyType const& key, CELL source, FacingType* moves, int maxlen)
+{
+    for (int index = 0; index < MAXIMUM_ENTRIES; index++) {
+        EntryType& entry = Entries[index];
+
+        if (!entry.IsActive || entry.Key.Dest != key.Dest || entry.Key.Type != key.Type
+            || entry.Key.RTTI != key.RTTI || entry.Key.House != key.House
+            || entry.Key.Threshhold != key.Threshhold) {
+            continue;
+        }
+
+        if (Frame - entry.Frame > LIFETIME) {
+            entry.IsActive = false;
+            continue;
+        }
+
+        /*
+        **	Walk the path looking for the furthest point along it that the source cell is at
+        **	or next to.
+        */
+        int sx = Cell_X(source);
+        int sy = Cell_Y(source);
+        int found = -1;
+        FacingType first = FACING_NONE;
+        CELL cell = entry.Start;
+        for (int step = 0; step <= entry.Length; step++) {
+            int dx = Cell_X(cell) - sx;
+            int dy = Cell_Y(cell) - sy;
+            if (dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1) {
+                found = step;
+                first = NeighbourFacing[dy + 1][dx + 1];
+            }
+            if (step < entry.Length) {
+                cell = Adjacent_Cell(cell, entry.Moves[step]);
+            }
+        }
+
+        if (found < 0 || (found == entry.Length && first == FACING_NONE)) {
+            continue;
+        }
+
+        int length = 0;
+        if (first != FACING_NONE && length < maxlen) {
+            moves[length++] = first;
+        }
+        for (int step = found; step < entry.Length && length < maxlen; step++) {
+            moves[length++] = entry.Moves[step];
+        }
+
+        entry.LastUsed = ++UseCount;
+        Hits++;
+        return (length);
+    }
+
+    Misses++;
+    return (0);
+}
+
+/*
+**	Remembers the result of a path search. The least recently used path is dropped to make room.
+*/
+void PathCacheClass::Store(KeyType const& key, CELL start, FacingType const* moves, int length)
+{
+    if (length <= 0) {
+        return;
+    }
+    length = min(length, (int)MAXIMUM_MOVES);
+
+    EntryType* entry = &Entries[0];
+    for (int index = 0; index < MAXIMUM_ENTRIES; index++) {
+        if (!Entries[index].IsActive) {
+            entry = &Entries[index];
+            break;
+        }
+        if (Entries[index].LastUsed < entry->LastUsed) {
+            entry = &Entries[index];
+        }
+    }
+
+    entry->IsActive = true;
+    entry->Key = key;
+    entry->Start = start;
+    entry->Length = length;
+    entry->Frame = Frame;
+    entry->LastUsed = ++UseCount;
+    memset(entry->Regions, 0, sizeof(entry->Regions));
+
+    CELL cell = start;
+    int region = Region(cell);
+    entry->Regions[region >> 5] |= 1U << (region & 31);
+    for (int index = 0; index < length; index++) {
+        entry->Moves[index] = moves[index];
+        cell = Adjacent_Cell(cell, moves[index]);
+        region = Region(cell);
+        entry->Regions[region >> 5] |= 1U << (region & 31);
+    }
+}
+
+/***********************************************************************************************
+ * FootClass::Fetch_Cached_Path -- Try to reuse a recent path to the destination.              *
+ *                                                                                             *
+ *    Checks the path cache for a path that another object of the same type and owner found    *
+ *    recently. Every step of the cached path is checked to make sure it can still be taken    *
+ *    by this object before it is used.                                                        *
+ *                                                                                             *
+ * INPUT:   dest        -- The cell to find a path to.                                         *
+ *                                                                                             *
+ *          final_moves -- The buffer to hold the resulting move list.                         *
+ *                                                                                             *
+ *          maxlen      -- The size of the move list buffer.                                   *
+ *                                                                                             *
+ *          threshhold  -- The most difficult movement restriction that is allowed.            *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the path or NULL if there was no usable cached path.     *
+ *                                                                                             *
+ * WARNINGS:   The path structure returned belongs to the current simulation context and is  *
+ *             only valid until the next search in it.                                         *
+ *=============================================================================================*/
+PathType* FootClass::Fetch_Cached_Path(CELL dest, FacingType* final_moves, int maxlen, MoveType threshhold)
+{
+    PathType& path = SimContextClass::Current()->Path.Path;
+    CELL source = Coord_Cell(Coord);
+
+    PathCacheClass::KeyType key;
+    key.RTTI = Techno_Type_Class()->What_Am_I();
+    key.Type = Techno_Type_Class()->ID;
+    key.House = Owner();
+    key.Threshhold = threshhold;
+    key.Dest = dest;
+
+    /*
+    **	Leave room for the end of list marker as well as the one that Optimize_Moves() adds.
+    */
+    int length = PathCache.Fetch(key, source, final_moves, maxlen - 2);
+    if (length == 0) {
+        return (NULL);
+    }
+
+    path.Start = source;
+    path.Cost = 0;
+    path.Length = 0;
+    path.Command = final_moves;
+    path.Overlap = NULL;
+    path.LastOverlap = -1;
+    path.LastFixup = -1;
+
+    CELL cell = source;
+    for (int index = 0; index < length; index++) {
+        cell = Adjacent_Cell(cell, final_moves[index]);
+        int cost = Passable_Cell(cell, final_moves[index], -1, threshhold);
+        if (cost == 0) {
+            final_moves[0] = FACING_NONE;
+            return (NULL);
+        }
+        path.Cost += cost;
+    }
+    path.Length = length;
+    final_moves[path.Length++] = FACING_NONE;
+
+    Optimize_Moves(&path, threshhold);
+    return (&path);
+}
+
+/***********************************************************************************************
+ * FootClass::Store_Cached_Path -- Remember a path that was just found.                        *
+ *                                                                                             *
+ * INPUT:   dest        -- The destination cell that the path was searched for.                *
+ *                                                                                             *
+ *          path        -- The path that was found.                                            *
+ *                                                                                             *
+ *          threshhold  -- The movement restriction the path was searched with.                *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void FootClass::Store_Cached_Path(CELL dest, PathType const* path, MoveType threshhold)
+{
+    if (path == NULL || path->Cost == 0) {
+        return;
+    }
+
+    int length = 0;
+    while (length < path->Length && path->Command[length] != FACING_NONE) {
+        length++;
+    }
+
+    PathCacheClass::KeyType key;
+    key.RTTI = Techno_Type_Class()->What_Am_I();
+    key.Type = Techno_Type_Class()->ID;
+    key.House = Owner();
+    key.Threshhold = threshhold;
+    key.Dest = dest;
+
+    PathCache.Store(key, path->Start, path->Command, length);
+}
@@ -0,0 +1,83 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+/*
+**	Cache of recently computed movement paths. When several units of the same kind are sent to
+**	the same place they all end up searching over the same cells. The cache keeps the move lists
+**	of the most recent searches so that a unit that starts on (or next to) a cached path can
+**	follow the rest of it instead of searching again.
+**
+**	Entries are thrown away when they get old, when a cell they pass through has its terrain
+**	recalculated or gains or loses a building, and whenever the movement zones are rebuilt. The
+**	caller is expected to check that every step of a fetched path is still passable before
+**	using it.
+*/
+class PathCacheClass
+{
+public:
+    /*
+    **	Everything that affects the result of a path search for a given start and end point.
+    */
+    struct KeyType
+    {
+        RTTIType RTTI;       // Kind of object (infantry, vehicle, ship).
+        int Type;            // Type of object within that kind.
+        HousesType House;    // Owner of the object.
+        MoveType Threshhold; // Most difficult movement restriction allowed.
+        CELL Dest;           // Destination cell of the search.
+    };
+
+    PathCacheClass(void);
+
+    void Clear(void);
+    void Invalidate(CELL cell);
+
+    int Fetch(KeyType const& key, CELL source, FacingType* moves, int maxlen);
+    void Store(KeyType const& key, CELL start, FacingType const* moves, int length);
+
+    /*
+    **	Statistics for tuning the cache size.
+    */
+    unsigned int Hits;
+    unsigned int Misses;
+
+private:
+    enum
+    {
+        MAXIMUM_ENTRIES = 64, // Number of paths remembered.
+        MAXIMUM_MOVES = 200,  // Longest move list remembered.
+        LIFETIME = 30,        // Game frames that a path is considered current.
+        REGION_SHIFT = 3,     // Regions are 8x8 cells.
+        REGION_COUNT = (MAP_CELL_W >> REGION_SHIFT) * (MAP_CELL_H >> REGION_SHIFT)
+    };
+
+    static int Region(CELL cell);
+
+    struct EntryType
+    {
+        bool IsActive;
+        KeyType Key;
+        CELL Start;
+        int Length;
+        int Frame;         // Frame the path was calculated on.
+        unsigned LastUsed; // Use stamp for least recently used replacement.
+        unsigned int Regions[REGION_COUNT / 32];
+        FacingType Moves[MAXIMUM_MOVES];
+    };
+
+    EntryType Entries[MAXIMUM_ENTRIES];
+    unsigned UseCount;
+};
+
+#endif
@@ -41,6 +41,7 @@
  * Main Multiplayer Queue Logic:															*
  *   Wait_For_Players -- Waits for other systems to come on-line           *
  *   Generate_Timing_Event -- computes & queues a RESPONSE_TIME event      *
+ *   Log_Timing_Decision -- Records a frame delay chosen by TimingControl  *
  *   Process_Send_Period -- timing for sending packets every 'n' frames    *
  *   Send_Packets -- sends out events from the OutList                     *
  *   Send_FrameSync -- Sends a FRAMESYNC packet                            *
@@ -67,6 +68,7 @@
  *                                                                         *
  * Debugging:																					*
  *   Compute_Game_CRC -- Computes a CRC value of the entire game.				*
+ *   Get_Game_CRC -- Computes and returns the CRC of the entire game.      *
  *   Add_CRC -- Adds a value to a CRC                                      *
  *   Print_CRCs -- Prints a data file for finding Sync Bugs						*
  *   Init_Queue_Mono -- inits mono display                                 *
@@ -78,6 +80,8 @@
 #include "msgbox.h"
 #include "common/paths.h"
 #include "common/framelimit.h"
+#include "common/delayctl.h"
+#include "common/debugstring.h"
 
 #ifdef WOLAPI_INTEGRATION
 //#include "WolDebug.h"
@@ -111,6 +115,13 @@ int NetMonoMode = 1;
 int NewMonoMode = 1;
 static int IsMono = 0;
 
+//...........................................................................
+// Frame delay chosen by the host when Rule.IsAdaptiveTiming is set; each
+// decision it makes is logged by Log_Timing_Decision.
+//...........................................................................
+static void Log_Timing_Decision(DelayControlClass::DecisionType const& decision);
+static DelayControlClass TimingControl(Log_Timing_Decision);
+
 //---------------------------------------------------------------------------
 // Several routines return various codes; here's an enum for all of them.
 //---------------------------------------------------------------------------
@@ -623,6 +634,7 @@ static void Queue_AI_Multiplayer(void)
     //------------------------------------------------------------------------
     Compute_Game_CRC();
     CRC[Frame & 0x001f] = GameCRC;
+    StateHash.Update();
 
     //------------------------------------------------------------------------
     //	If we've just started a game, or loaded a multiplayer game, we must
@@ -708,7 +720,9 @@ static void Queue_AI_Multiplayer(void)
         // sending data again  (loading MIX files will have introduced
         // deceptively large values).
         //.....................................................................
+        ConnectionClass::IsFineTime = Rule.IsAdaptiveTiming;
         net->Reset_Response_Time();
+        TimingControl.Reset();
 
         //.....................................................................
         // Initialize the frame timers
@@ -1418,15 +1432,31 @@ static void Generate_Real_Timing_Event(ConnManClass* net, int my_sent)
     // resp_time is divided by 2 because, as reported, it represents a round-
     // trip, and we only want to use a one-way trip.
     //
-    maxahead = (resp_time * Session.DesiredFrameRate) / (2 * 60);
+    if (Rule.IsAdaptiveTiming) {
 
-    //
-    // Now, we have to round 'maxahead' so it's an even multiple of our
-    // send rate.  It also must be at least thrice the FrameSendRate.
-    // (Isn't "thrice" a cool word?)
-    //
-    maxahead = ((maxahead + Session.FrameSendRate - 1) / Session.FrameSendRate) * Session.FrameSendRate;
-    maxahead = MAX(maxahead, (int)Session.FrameSendRate * 3);
+        //
+        // Use the time that 95% of recent packets made it within, plus an
+        // allowance for jitter, rather than the long term average; the average
+        // is too slow to follow a change in line conditions and takes no
+        // account of how much the response time varies.  The result is still
+        // a multiple of the send rate, but only needs to be twice it.
+        //
+        maxahead = TimingControl.Compute(net->Percentile_Response_Time(95),
+                                         net->Response_Jitter(),
+                                         Session.DesiredFrameRate,
+                                         Session.FrameSendRate,
+                                         Session.FrameSendRate * 2);
+    } else {
+        maxahead = (resp_time * Session.DesiredFrameRate) / (2 * 60);
+
+        //
+        // Now, we have to round 'maxahead' so it's an even multiple of our
+        // send rate.  It also must be at least thrice the FrameSendRate.
+        // (Isn't "thrice" a cool word?)
+        //
+        maxahead = ((maxahead + Session.FrameSendRate - 1) / Session.FrameSendRate) * Session.FrameSendRate;
+        maxahead = MAX(maxahead, (int)Session.FrameSendRate * 3);
+    }
 
     ev.Type = EventClass::TIMING;
     ev.Data.Timing.DesiredFrameRate = Session.DesiredFrameRate;
@@ -1448,6 +1478,39 @@ static void Generate_Real_Timing_Event(ConnManClass* net, int my_sent)
     }
 }
 
+/***************************************************************************
+ * Log_Timing_Decision -- Records a frame delay chosen by TimingControl    *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		decision		the values that went into the new frame delay				*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		none.																						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *                                                                         *
+ *=========================================================================*/
+static void Log_Timing_Decision(DelayControlClass::DecisionType const& decision)
+{
+    DBG_INFO("Frame %d: response %u jitter %u at %d fps needs %d frames, MaxAhead %d -> %d\n",
+             Frame,
+             decision.ResponseTime,
+             decision.Jitter,
+             decision.FrameRate,
+             decision.Needed,
+             decision.Previous,
+             decision.MaxAhead);
+
+    if (IsMono) {
+        MonoClass::Enable();
+        Mono_Set_Cursor(0, 22);
+        Mono_Printf(
+            "Response:%03u Jitter:%03u MaxAhead:%03d\n", decision.ResponseTime, decision.Jitter, decision.MaxAhead);
+        MonoClass::Disable();
+    }
+}
+
 /***************************************************************************
  * Generate_Process_Time_Event -- Generates a PROCESS_TIME event           *
  *                                                                         *
@@ -3491,6 +3554,7 @@ static void Queue_Playback(void)
     //------------------------------------------------------------------------
     Compute_Game_CRC();
     CRC[Frame & 0x001f] = GameCRC;
+    StateHash.Update();
 #if 0 // This whole block is potentially the cause of playback desyncs, so wall it off for now.
     //------------------------------------------------------------------------
     // If we've reached the CRC print frame, do so & exit
@@ -3668,6 +3732,28 @@ static void Compute_Game_CRC(void)
 
 } /* end of Compute_Game_CRC */
 
+/***************************************************************************
+ * Get_Game_CRC -- Computes and returns the CRC of the entire game.        *
+ *                                                                         *
+ * This lets code outside the queue (such as the simulation benchmark)     *
+ * sample the same value that is exchanged between peers for sync checks.  *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none.																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		CRC of the current game state												*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+unsigned int Get_Game_CRC(void)
+{
+    Compute_Game_CRC();
+    return (GameCRC);
+
+} /* end of Get_Game_CRC */
+
 /***************************************************************************
  * Add_CRC -- Adds a value to a CRC                                        *
  *                                                                         *
@@ -3792,7 +3878,7 @@ static void Print_CRCs(EventClass* ev)
                              infp->Class->Type,
                              infp->As_Target(),
                              infp->Speed,
-                             infp->NavCom);
+                             (TARGET)infp->NavCom);
                     fc.Write(buffer, strlen(buffer));
                 }
             }
@@ -4067,6 +4153,11 @@ static void Print_CRCs(EventClass* ev)
         snprintf(buffer, sizeof(buffer), "  Delay:        %d\n", ev->Data.FrameInfo.Delay);
         fc.Write(buffer, strlen(buffer));
     }
+
+    //------------------------------------------------------------------------
+    //	State hashes, for comparing with the other system's log
+    //------------------------------------------------------------------------
+    StateHash.Write(fc);
 } /* end of Print_CRCs */
 
 /***************************************************************************
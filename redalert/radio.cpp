@@ -168,6 +168,7 @@ RadioMessageType RadioClass::Receive_Message(RadioClass* from, RadioMessageType
     if (message == RADIO_HELLO && Strength) {
         if (Radio == from || Radio == NULL) {
             Radio = from;
+            References.Add(from->As_Target(), &Radio, from);
             return (RADIO_ROGER);
         }
         return (RADIO_NEGATIVE);
@@ -228,6 +229,7 @@ RadioMessageType RadioClass::Transmit_Message(RadioMessageType message, int& par
         Transmit_Message(RADIO_OVER_OUT);
         if (to->Receive_Message(this, message, param) == RADIO_ROGER) {
             Radio = to;
+            References.Add(to->As_Target(), &Radio, to);
             return (RADIO_ROGER);
         }
         return (RADIO_NEGATIVE);
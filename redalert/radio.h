@@ -48,6 +48,8 @@ class TechnoClass;
 */
 class RadioClass : public MissionClass
 {
+    friend class ReferenceIndexClass;
+
 private:
     /*
     **	This is a record of the last message received by this receiver.
@@ -0,0 +1,431 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "function.h"
+
+/*
+**	The object heap and name that go with each kind, in the order the full sweep visits them.
+*/
+static FixedIHeapClass* const KindHeap[] = {&Units, &Vessels, &Aircraft, &Buildings, &Bullets, &Infantry};
+static char const* const KindName[] = {"Units", "Vessels", "Aircraft", "Buildings", "Bullets", "Infantry"};
+
+void TargetRefClass::Add(void) const
+{
+    References.Add(Target, &Target);
+}
+
+ReferenceIndexClass::ReferenceIndexClass(void)
+    : Visited(0)
+    , Swept(0)
+    , Missed(0)
+    , Entries(NULL)
+    , Capacity(0)
+    , Used(0)
+    , FreeList(-1)
+    , Changes(0)
+{
+    memset(Buckets, -1, sizeof(Buckets));
+}
+
+ReferenceIndexClass::~ReferenceIndexClass(void)
+{
+    delete[] Entries;
+}
+
+/*
+**	Throws away every entry, called when the scenario is cleared.
+*/
+void ReferenceIndexClass::Clear(void)
+{
+    memset(Buckets, -1, sizeof(Buckets));
+    FreeList = -1;
+    for (int index = Capacity - 1; index >= 0; index--) {
+        Entries[index].Next = FreeList;
+        FreeList = index;
+    }
+    Used = 0;
+}
+
+void ReferenceIndexClass::Track_Foot(FootClass* foot)
+{
+    foot->TarCom.Track();
+    foot->SuspendedTarCom.Track();
+    foot->ArchiveTarget.Track();
+    foot->NavCom.Track();
+    foot->SuspendedNavCom.Track();
+    for (int index = 0; index < ARRAY_SIZE(foot->NavQueue); index++) {
+        foot->NavQueue[index].Track();
+    }
+    if (foot->Radio != NULL) {
+        Add(foot->Radio->As_Target(), &foot->Radio, foot->Radio);
+    }
+}
+
+/*
+**	Makes the index again from the objects themselves, called after a game is loaded since the
+**	objects were read in without their fields being assigned.
+*/
+void ReferenceIndexClass::Rebuild(void)
+{
+    int index;
+
+    Clear();
+
+    for (index = 0; index < Units.Count(); index++) {
+        Track_Foot(Units.Ptr(index));
+    }
+    for (index = 0; index < Vessels.Count(); index++) {
+        Track_Foot(Vessels.Ptr(index));
+    }
+    for (index = 0; index < Aircraft.Count(); index++) {
+        Track_Foot(Aircraft.Ptr(index));
+    }
+    for (index = 0; index < Infantry.Count(); index++) {
+        Track_Foot(Infantry.Ptr(index));
+    }
+
+    for (index = 0; index < Buildings.Count(); index++) {
+        BuildingClass* building = Buildings.Ptr(index);
+        building->TarCom.Track();
+        building->SuspendedTarCom.Track();
+        building->ArchiveTarget.Track();
+        building->WhomToRepay.Track();
+        building->AnimToTrack.Track();
+        if (building->Radio != NULL) {
+            Add(building->Radio->As_Target(), &building->Radio, building->Radio);
+        }
+    }
+
+    for (index = 0; index < Bullets.Count(); index++) {
+        BulletClass* bullet = Bullets.Ptr(index);
+        bullet->TarCom.Track();
+        if (bullet->Payback != NULL) {
+            Add(bullet->Payback->As_Target(), &bullet->Payback, bullet->Payback);
+        }
+    }
+}
+
+/*
+**	Is the target one that the index keeps track of? Cells and triggers are not, since they can be
+**	held by fields that aren't tracked.
+*/
+bool ReferenceIndexClass::Is_Indexed(TARGET target)
+{
+    return (target != TARGET_NONE && !Is_Target_Cell(target) && !Is_Target_Trigger(target));
+}
+
+int ReferenceIndexClass::Bucket(TARGET target)
+{
+    return ((int)(((unsigned)target * 0x9E3779B1U) >> (32 - BUCKET_BITS)));
+}
+
+/*
+**	Records that the field at the address given now holds the target. Pointer fields also pass
+**	the pointer they hold, so that the entry can be checked against it later. Nothing is kept
+**	while the index is turned off in the rules; it is rebuilt when it gets turned on.
+*/
+void ReferenceIndexClass::Add(TARGET target, void const* field, void const* pointer)
+{
+    if (!Rule.IsReferenceIndex || !Is_Indexed(target)) {
+        return;
+    }
+
+    Changes++;
+
+    int bucket = Bucket(target);
+    for (int index = Buckets[bucket]; index != -1; index = Entries[index].Next) {
+        if (Entries[index].Target == target && Entries[index].Field == field) {
+            Entries[index].Pointer = pointer;
+            return;
+        }
+    }
+
+    if (FreeList == -1) {
+        Grow();
+    }
+
+    int index = FreeList;
+    EntryType& entry = Entries[index];
+    FreeList = entry.Next;
+    entry.Target = target;
+    entry.Field = field;
+    entry.Pointer = pointer;
+    entry.Next = Buckets[bucket];
+    Buckets[bucket] = index;
+    Used++;
+}
+
+/*
+**	Finds the object whose memory holds the field, and where it is in its heap's active list.
+**	Returns NULL if the field isn't inside an object that is in use.
+*/
+ObjectClass* ReferenceIndexClass::Holder(void const* field, int& kind, int& index)
+{
+    for (kind = KIND_UNIT; kind < KIND_COUNT; kind++) {
+        FixedIHeapClass* heap = KindHeap[kind];
+        if (heap->Contains(field)) {
+            index = heap->Logical_ID(field);
+            if (index == -1) {
+                return (NULL);
+            }
+            return (Object(kind, index));
+        }
+    }
+    return (NULL);
+}
+
+ObjectClass* ReferenceIndexClass::Object(int kind, int index)
+{
+    switch (kind) {
+    case KIND_UNIT:
+        return (Units.Ptr(index));
+    case KIND_VESSEL:
+        return (Vessels.Ptr(index));
+    case KIND_AIRCRAFT:
+        return (Aircraft.Ptr(index));
+    case KIND_BUILDING:
+        return (Buildings.Ptr(index));
+    case KIND_BULLET:
+        return (Bullets.Ptr(index));
+    default:
+        return (Infantry.Ptr(index));
+    }
+}
+
+/*
+**	Does the field still hold what it held when the entry was made? Only called once the field is
+**	known to be inside an object that is in use.
+*/
+bool ReferenceIndexClass::Is_Current(EntryType const& entry) const
+{
+    if (entry.Pointer != NULL) {
+        return (*(void const* const*)entry.Field == entry.Pointer);
+    }
+    return (*(TARGET const*)entry.Field == entry.Target);
+}
+
+int ReferenceIndexClass::Compare_Referrers(void const* a, void const* b)
+{
+    ReferrerType const* left = (ReferrerType const*)a;
+    ReferrerType const* right = (ReferrerType const*)b;
+
+    if (left->Kind != right->Kind) {
+        return (left->Kind - right->Kind);
+    }
+    return (left->Index - right->Index);
+}
+
+/*
+**	Fills the list with the objects that hold the target and come after the one given, in the order
+**	the full sweep would take them in. Entries that are out of date are thrown away on the way.
+**	Returns the number of objects, or -1 if there are too many to fit.
+*/
+int ReferenceIndexClass::Gather(TARGET target, ReferrerType const* after, ReferrerType* list)
+{
+    int count = 0;
+    int bucket = Bucket(target);
+    int previous = -1;
+    int index = Buckets[bucket];
+
+    while (index != -1) {
+        EntryType& entry = Entries[index];
+        int next = entry.Next;
+
+        if (entry.Target == target) {
+            ReferrerType referrer;
+            referrer.Object = Holder(entry.Field, referrer.Kind, referrer.Index);
+
+            if (referrer.Object == NULL || !Is_Current(entry)) {
+                if (previous == -1) {
+                    Buckets[bucket] = next;
+                } else {
+                    Entries[previous].Next = next;
+                }
+                entry.Next = FreeList;
+                FreeList = index;
+                Used--;
+                index = next;
+                continue;
+            }
+
+            if (after == NULL || Compare_Referrers(&referrer, after) > 0) {
+                int found = 0;
+                while (found < count && list[found].Object != referrer.Object) {
+                    found++;
+                }
+                if (found == count) {
+                    if (count == MAX_REFERRERS) {
+                        return (-1);
+                    }
+                    list[count++] = referrer;
+                }
+            }
+        }
+
+        previous = index;
+        index = next;
+    }
+
+    qsort(list, count, sizeof(list[0]), Compare_Referrers);
+    return (count);
+}
+
+/*
+**	Detaches the target from the objects that refer to it. A detach can give another object the
+**	target, so if anything is added to the index on the way, the objects still to come are found
+**	again. This catches the same objects the full sweep would. Returns false if the target isn't
+**	indexed or has too many referrers, in which case nothing was done and the caller should sweep
+**	all the objects instead.
+*/
+bool ReferenceIndexClass::Detach(TARGET target, bool all)
+{
+    if (!Is_Indexed(target)) {
+        Swept++;
+        return (false);
+    }
+
+    ReferrerType list[MAX_REFERRERS];
+    ReferrerType last;
+    int count = Gather(target, NULL, list);
+
+    if (count == -1) {
+        Swept++;
+        return (false);
+    }
+
+    while (count > 0) {
+        int index;
+        for (index = 0; index < count; index++) {
+            unsigned changes = Changes;
+            list[index].Object->Detach(target, all);
+            Visited++;
+            last = list[index];
+            if (Changes != changes) {
+                break;
+            }
+        }
+        if (index == count) {
+            break;
+        }
+
+        count = Gather(target, &last, list);
+
+        /*
+        **	Too many to list, so sweep everything after the last object detached.
+        */
+        if (count == -1) {
+            for (int kind = last.Kind; kind < KIND_COUNT; kind++) {
+                for (index = (kind == last.Kind) ? last.Index + 1 : 0; index < KindHeap[kind]->Count(); index++) {
+                    Object(kind, index)->Detach(target, all);
+                }
+            }
+            break;
+        }
+    }
+
+#ifdef VIC
+    for (int index = 0; index < Anims.Count(); index++) {
+        Anims.Ptr(index)->Detach(target, all);
+    }
+#endif
+
+    return (true);
+}
+
+/*
+**	Detaches the target from every object again and reports any object that changed, since that
+**	means it still referred to the target after the index was used. Used to test the index.
+*/
+template <class T> static int Check_Heap(TFixedIHeapClass<T>& heap, char const* name, TARGET target, bool all)
+{
+    int missed = 0;
+
+    for (int index = 0; index < heap.Count(); index++) {
+        T* object = heap.Ptr(index);
+        int before = Calculate_CRC(object, sizeof(T));
+        object->Detach(target, all);
+        if (Calculate_CRC(object, sizeof(T)) != before) {
+            DBG_ERROR("Reference index missed %s %d referring to target %08X", name, index, target);
+            missed++;
+        }
+    }
+    return (missed);
+}
+
+void ReferenceIndexClass::Check(TARGET target, bool all)
+{
+    if (!Is_Indexed(target)) {
+        return;
+    }
+
+    Missed += Check_Heap(Units, KindName[KIND_UNIT], target, all);
+    Missed += Check_Heap(Vessels, KindName[KIND_VESSEL], target, all);
+    Missed += Check_Heap(Aircraft, KindName[KIND_AIRCRAFT], target, all);
+    Missed += Check_Heap(Buildings, KindName[KIND_BUILDING], target, all);
+    Missed += Check_Heap(Bullets, KindName[KIND_BULLET], target, all);
+    Missed += Check_Heap(Infantry, KindName[KIND_INFANTRY], target, all);
+}
+
+/*
+**	Makes room for more entries, first by throwing away those that are out of date and then, if
+**	the index is still mostly full, by making it bigger.
+*/
+void ReferenceIndexClass::Grow(void)
+{
+    Compact();
+
+    if (FreeList != -1 && Used < Capacity - Capacity / 4) {
+        return;
+    }
+
+    int capacity = (Capacity == 0) ? MIN_ENTRIES : Capacity * 2;
+    EntryType* entries = new EntryType[capacity];
+    if (Capacity > 0) {
+        memcpy(entries, Entries, Capacity * sizeof(EntryType));
+    }
+    delete[] Entries;
+    Entries = entries;
+
+    for (int index = capacity - 1; index >= Capacity; index--) {
+        Entries[index].Next = FreeList;
+        FreeList = index;
+    }
+    Capacity = capacity;
+}
+
+void ReferenceIndexClass::Compact(void)
+{
+    for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        int previous = -1;
+        int index = Buckets[bucket];
+
+        while (index != -1) {
+            EntryType& entry = Entries[index];
+            int next = entry.Next;
+            int kind;
+            int position;
+
+            if (Holder(entry.Field, kind, position) == NULL || !Is_Current(entry)) {
+                if (previous == -1) {
+                    Buckets[bucket] = next;
+                } else {
+                    Entries[previous].Next = next;
+                }
+                entry.Next = FreeList;
+                FreeList = index;
+                Used--;
+            } else {
+                previous = index;
+            }
+            index = next;
+        }
+    }
+}
@@ -0,0 +1,172 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef REFINDEX_H
+#define REFINDEX_H
+
+class ObjectClass;
+class FootClass;
+
+/*
+**	A target number held by a game object that the reference index is told about whenever it
+**	changes. It converts to and from TARGET so it can be used like one, but it must not be
+**	copied around with memcpy or memmove since that would bypass the index.
+*/
+class TargetRefClass
+{
+public:
+    TargetRefClass(void){};
+    TargetRefClass(NoInitClass const&){};
+    explicit TargetRefClass(TARGET target)
+        : Target(target)
+    {
+        Track();
+    };
+    TargetRefClass(TargetRefClass const& that)
+        : Target(that.Target)
+    {
+        Track();
+    };
+
+    TargetRefClass& operator=(TARGET target)
+    {
+        Target = target;
+        Track();
+        return (*this);
+    };
+    TargetRefClass& operator=(TargetRefClass const& that)
+    {
+        Target = that.Target;
+        Track();
+        return (*this);
+    };
+
+    operator TARGET(void) const
+    {
+        return (Target);
+    };
+
+    void Track(void) const
+    {
+        if (Target != TARGET_NONE) {
+            Add();
+        }
+    };
+
+private:
+    void Add(void) const;
+
+    TARGET Target;
+};
+
+/*
+**	Records which units, vessels, aircraft, buildings, infantry and bullets may refer to each
+**	target, so that when an object dies only those objects need to be detached from it rather
+**	than every object in the game.
+**
+**	An entry is added whenever a target is put into a tracked field (the targeting and
+**	navigation computers and their suspended and archived copies, the navigation queue, the
+**	building repair and animation targets, radio contacts and bullet paybacks). Entries are never
+**	removed when a field changes. Instead each entry is checked against the field when it is
+**	used and thrown away if the field no longer holds the target or its object is gone. An
+**	entry too many only costs a check, whereas a missing one would leave a dangling reference,
+**	so every assignment must be seen. Cells and triggers are not indexed and their detach still
+**	sweeps every object.
+**
+**	The objects are detached in the same order the full sweep would take them in, so the game
+**	plays out the same either way.
+*/
+class ReferenceIndexClass
+{
+public:
+    enum
+    {
+        BUCKET_BITS = 12,
+        BUCKET_COUNT = 1 << BUCKET_BITS,
+        MIN_ENTRIES = 4096,
+        MAX_REFERRERS = 256 // More referrers than this falls back to the full sweep.
+    };
+
+    ReferenceIndexClass(void);
+    ~ReferenceIndexClass(void);
+
+    void Clear(void);
+    void Rebuild(void);
+
+    void Add(TARGET target, void const* field, void const* pointer = NULL);
+    bool Detach(TARGET target, bool all);
+    void Check(TARGET target, bool all);
+
+    static bool Is_Indexed(TARGET target);
+
+    /*
+    **	Statistics for tuning.
+    */
+    unsigned Visited; // Objects detached through the index.
+    unsigned Swept;   // Detaches that fell back to the full sweep.
+    unsigned Missed;  // Referrers found by the check that the index did not know about.
+
+private:
+    /*
+    **	The object kinds in the order the full sweep visits them.
+    */
+    enum KindType
+    {
+        KIND_UNIT,
+        KIND_VESSEL,
+        KIND_AIRCRAFT,
+        KIND_BUILDING,
+        KIND_BULLET,
+        KIND_INFANTRY,
+        KIND_COUNT
+    };
+
+    struct EntryType
+    {
+        TARGET Target;
+        int Next;            // Next entry in the same bucket, or -1.
+        void const* Field;   // Address of the field that was given the target.
+        void const* Pointer; // Object pointer held by a pointer field, NULL for a target field.
+    };
+
+    struct ReferrerType
+    {
+        int Kind;
+        int Index; // Position in the heap's active list.
+        ObjectClass* Object;
+    };
+
+    static int Bucket(TARGET target);
+    static ObjectClass* Object(int kind, int index);
+    static ObjectClass* Holder(void const* field, int& kind, int& index);
+    static int Compare_Referrers(void const* a, void const* b);
+
+    void Track_Foot(FootClass* foot);
+    bool Is_Current(EntryType const& entry) const;
+    int Gather(TARGET target, ReferrerType const* after, ReferrerType* list);
+    void Grow(void);
+    void Compact(void);
+
+    EntryType* Entries;
+    int Capacity;
+    int Used;
+    int FreeList;
+    int Buckets[BUCKET_COUNT];
+    unsigned Changes; // Count of entries added, to see when a detach makes new referrers.
+
+    // The assignment operator is not supported.
+    ReferenceIndexClass& operator=(ReferenceIndexClass const&) = delete;
+
+    // The copy constructor is not supported.
+    ReferenceIndexClass(ReferenceIndexClass const&) = delete;
+};
+
+#endif
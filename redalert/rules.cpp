@@ -192,6 +192,14 @@ RulesClass::RulesClass(void)
     , IsSmartDefense(false)
     , IsScatter(false)
     , IsChronoKill(true)
+    , IsAStarPath(false)
+    , IsPathCache(false)
+    , IsSortLayers(false)
+    , IsAdaptiveTiming(false)
+    , IsParallelLogic(false)
+    , IsReferenceIndex(false)
+    , IsReferenceCheck(false)
+    , IsBackgroundSave(false)
     , ProneDamageBias(1, 2)
     , QuakeDamagePercent(".33")
     , QuakeChance(".2")
@@ -412,6 +420,14 @@ bool RulesClass::General(CCINIClass& ini)
         IsCurleyShuffle = ini.Get_Bool(GENERAL, "CurleyShuffle", IsCurleyShuffle);
         IsFlashLowPower = ini.Get_Bool(GENERAL, "FlashLowPower", IsFlashLowPower);
         IsChronoKill = ini.Get_Bool(GENERAL, "ChronoKillCargo", IsChronoKill);
+        IsAStarPath = ini.Get_Bool(GENERAL, "AStarPath", IsAStarPath);
+        IsPathCache = ini.Get_Bool(GENERAL, "PathCache", IsPathCache);
+        IsSortLayers = ini.Get_Bool(GENERAL, "SortLayers", IsSortLayers);
+        IsAdaptiveTiming = ini.Get_Bool(GENERAL, "AdaptiveTiming", IsAdaptiveTiming);
+        IsParallelLogic = ini.Get_Bool(GENERAL, "ParallelLogic", IsParallelLogic);
+        IsReferenceIndex = ini.Get_Bool(GENERAL, "ReferenceIndex", IsReferenceIndex);
+        IsReferenceCheck = ini.Get_Bool(GENERAL, "ReferenceCheck", IsReferenceCheck);
+        IsBackgroundSave = ini.Get_Bool(GENERAL, "BackgroundSave", IsBackgroundSave);
         ChronoDuration = ini.Get_Fixed(GENERAL, "ChronoDuration", ChronoDuration);
         IsFineDifficulty = ini.Get_Bool(GENERAL, "FineDiffControl", IsFineDifficulty);
         WaterCrateChance = ini.Get_Fixed(GENERAL, "WaterCrateChance", WaterCrateChance);
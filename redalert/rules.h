@@ -595,6 +595,54 @@ public:
     */
     unsigned IsChronoKill : 1;
 
+    /*
+    **	Should ground units use the A* path finder rather than the original line of sight
+    **	and edge following path finder?
+    */
+    unsigned IsAStarPath : 1;
+
+    /*
+    **	Can objects reuse a path recently found by another object of the same type
+    **	heading to the same destination?
+    */
+    unsigned IsPathCache : 1;
+
+    /*
+    **	Should the ground layer be fully sorted into draw order every frame rather than
+    **	being given a single sorting pass?
+    */
+    unsigned IsSortLayers : 1;
+
+    /*
+    **	Should the host pick the multiplayer frame delay from recent response time
+    **	percentiles and jitter rather than from the average response time?
+    */
+    unsigned IsAdaptiveTiming : 1;
+
+    /*
+    **	Should large whole map target scans be split between worker threads? The result
+    **	is the same as scanning in one thread.
+    */
+    unsigned IsParallelLogic : 1;
+
+    /*
+    **	Should dying objects only be detached from the objects that the reference index
+    **	says refer to them, rather than from every object? The result is the same.
+    */
+    unsigned IsReferenceIndex : 1;
+
+    /*
+    **	Should every detach through the reference index be checked against a detach from
+    **	every object? This is slow and only meant for testing the index.
+    */
+    unsigned IsReferenceCheck : 1;
+
+    /*
+    **	Should saves only copy the game state to memory, and leave compressing,
+    **	encrypting and writing it out to another thread?
+    */
+    unsigned IsBackgroundSave : 1;
+
     /*
     **	When infantry are prone or when civilians are running around like crazy,
     **	they are less prone to damage. This specifies the multiplier to the damage
@@ -32,12 +32,14 @@
  * Functions:                                                                                  *
  *   Code_All_Pointers -- Code all pointers.                                                   *
  *   Decode_All_Pointers -- Decodes all pointers.                                              *
+ *   Finish_Background_Save -- Waits for a save being written by another thread.              *
  *   Get_Savefile_Info -- gets description, scenario #, house                                  *
  *   Load_Game -- loads a saved game                                                           *
  *   Load_MPlayer_Values -- Loads multiplayer-specific values                                  *
  *   Load_Misc_Values -- loads miscellaneous variables                                         *
  *   MPlayer_Save_Message -- pops up a "saving..." message                                     *
  *   Put_All -- Store all save game data to the pipe.                                          *
+ *   Put_Header -- Store the uncompressed header of a save game file.                          *
  *   Reconcile_Players -- Reconciles loaded data with the 'Players' vector							  *
  *   Save_Game -- saves a game to disk                                                         *
  *   Save_MPlayer_Values -- Saves multiplayer-specific values                                  *
@@ -47,12 +49,14 @@
 #include "function.h"
 #include "factory.h"
 #include "xpipe.h"
-#include "blowpipe.h"
-#include "shapipe.h"
-#include "lcwpipe.h"
+#include "savepipe.h"
 #include "lcwstraw.h"
 #include "vortex.h"
 #include "carry.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
 
 #ifdef REMASTER_BUILD
 extern bool DLLSave(Pipe& file);
@@ -282,6 +286,210 @@ static void Put_All(Pipe& pipe, int save_net)
     pipe.Flush();
 }
 
+/***********************************************************************************************
+ * Put_Header -- Store the uncompressed header of a save game file.                            *
+ *                                                                                             *
+ *    Saves the description, scenario #, and house (scenario # & house are saved separately    *
+ *    from the actual Scenario & PlayerPtr globals for convenience; we can quickly find out    *
+ *    which house & scenario this save-game file is for by reading these values. Also,         *
+ *    PlayerPtr is stored in a coded form in Save_Misc_Values(), which may or may not be a     *
+ *    HousesType number; so, saving 'house' here ensures we can always pull out the house for  *
+ *    this file.) The save game version follows, for loading verification.                     *
+ *                                                                                             *
+ * INPUT:   pipe     -- Reference to the pipe that will receive the header.                    *
+ *                                                                                             *
+ *          descr    -- The description of the save game.                                      *
+ *                                                                                             *
+ *          scenario -- The scenario number.                                                   *
+ *                                                                                             *
+ *          house    -- The house of the player.                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+static void Put_Header(Pipe& pipe, char const* descr, unsigned scenario, HousesType house)
+{
+    char descr_buf[DESCRIP_MAX];
+    memset(descr_buf, '\0', sizeof(descr_buf));
+    sprintf(descr_buf, "%s\r\n", descr); // put CR-LF after text
+    // descr_buf[strlen(descr_buf) + 1] = 26;		// put CTRL-Z after NULL
+    pipe.Put(descr_buf, DESCRIP_MAX);
+
+    pipe.Put(&scenario, sizeof(scenario));
+
+    pipe.Put(&house, sizeof(house));
+
+    unsigned int version = SAVEGAME_VERSION;
+#ifdef FIXIT_CSII //	checked - ajw 9/28/98
+    version++;
+#endif
+    pipe.Put(&version, sizeof(version));
+}
+
+/*
+**	Compresses and encrypts the game data into the file after the header,
+**	then puts the message digest of the data as it is on disk at
+**	'digest_pos'. The data comes either straight from the game or from a
+**	snapshot of it, and both give the same bytes.
+*/
+static void Put_Body(FileClass& file, FilePipe& fpipe, int digest_pos, SnapshotPipe const* snapshot, int save_net)
+{
+    SavePipe pipe(&FastKey, BlowfishEngine::MAX_KEY_LENGTH, SAVE_BLOCK_SIZE);
+
+    pipe.Put_To(fpipe);
+    if (snapshot != NULL) {
+        snapshot->Write_To(pipe);
+    } else {
+        Put_All(pipe, save_net);
+    }
+
+    /*
+    **	Output the real final message digest. This is the one that is of
+    **	the data image as it exists on the disk.
+    */
+    pipe.Put_Digest(file, fpipe, digest_pos);
+
+    pipe.End();
+}
+
+/*
+**	A save file that remembers the first error it ran into, so that a save
+**	written by another thread can report it when it is finished.
+*/
+class SaveFileClass : public CDFileClass
+{
+public:
+    SaveFileClass(void)
+        : Status(0)
+    {
+    }
+
+    virtual void Error(int error, int canretry = false, char const* filename = NULL)
+    {
+        if (Status == 0) {
+            Status = (error != 0) ? error : EIO;
+        }
+        CDFileClass::Error(error, canretry, filename);
+    }
+
+    int Status;
+};
+
+/*
+**	A save being written out by another thread. The header and the space for
+**	the message digest are already in the file.
+*/
+struct BackgroundSaveType
+{
+    SaveFileClass File;
+    int DigestPos;
+    SnapshotPipe Data;
+    std::thread Thread;
+};
+
+static BackgroundSaveType* BackgroundSave = NULL;
+
+/*
+**	Runs on the save thread. Only touches the save's own data, and FastKey,
+**	which never changes. Write, seek and close errors end up in the file's
+**	status for Finish_Background_Save to report.
+*/
+static void Write_Background_Save(BackgroundSaveType* save)
+{
+    FilePipe fpipe(&save->File);
+
+    Put_Body(save->File, fpipe, save->DigestPos, &save->Data, 0);
+
+    save->File.Close();
+    save->Data.Clear();
+}
+
+/***********************************************************************************************
+ * Finish_Background_Save -- Waits for a save being written by another thread.                 *
+ *                                                                                             *
+ *    Must be called before anything reads or writes save game files, and before the program   *
+ *    ends, so that the file of a background save is complete. If the file could not be        *
+ *    written it is logged and deleted, since it would not load.                               *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the last background save written? True if there was none.               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+bool Finish_Background_Save(void)
+{
+    bool ok = true;
+
+    if (BackgroundSave != NULL) {
+        BackgroundSave->Thread.join();
+        if (BackgroundSave->File.Status != 0) {
+            DBG_ERROR("Background save to '%s' failed: %s",
+                      BackgroundSave->File.File_Name(),
+                      strerror(BackgroundSave->File.Status));
+            BackgroundSave->File.Delete();
+            ok = false;
+        }
+        delete BackgroundSave;
+        BackgroundSave = NULL;
+    }
+    return (ok);
+}
+
+static void Finish_Background_Save_At_Exit(void)
+{
+    Finish_Background_Save();
+}
+
+/*
+**	Copies the game data to memory and starts a thread to compress, encrypt and
+**	write it. The pointers must already be coded. The file is opened and the
+**	header written here, so that a file that can't be written is reported
+**	straight away.
+*/
+static bool Start_Background_Save(const char* file_name,
+                                  const char* descr,
+                                  unsigned scenario,
+                                  HousesType house,
+                                  int save_net)
+{
+    static bool exit_hooked = false;
+
+    BackgroundSaveType* save = new BackgroundSaveType;
+    save->File.Set_Name(file_name);
+    if (!save->File.Open(WRITE)) {
+        delete save;
+        return (false);
+    }
+
+    FilePipe fpipe(&save->File);
+    Put_Header(fpipe, descr, scenario, house);
+
+    /*
+    **	Store a dummy message digest, the thread writes the real one.
+    */
+    save->DigestPos = save->File.Seek(0, SEEK_CUR);
+    char digest[20];
+    memset(digest, '\0', sizeof(digest));
+    fpipe.Put(digest, sizeof(digest));
+
+    Put_All(save->Data, save_net);
+
+    if (!exit_hooked) {
+        atexit(Finish_Background_Save_At_Exit);
+        exit_hooked = true;
+    }
+
+    BackgroundSave = save;
+    save->Thread = std::thread(Write_Background_Save, save);
+    return (true);
+}
+
 /***************************************************************************
  * Save_Game -- saves a game to disk                                       *
  *                                                                         *
@@ -345,6 +553,8 @@ bool Save_Game(int id, char const* descr, bool)
 bool NowSavingGame = false; // TEMP MBL: Need to discuss better solution with Steve
 bool Save_Game(const char* file_name, const char* descr)
 {
+    Finish_Background_Save();
+
     NowSavingGame = true; // TEMP MBL: Need to discuss better solution with Steve
 
     int save_net = 0; // 1 = save network/modem game
@@ -364,6 +574,24 @@ bool Save_Game(const char* file_name, const char* descr)
     */
     Code_All_Pointers();
 
+    /*
+    **	A background save only holds the game up while the data is copied to
+    **	memory.
+    */
+#ifdef REMASTER_BUILD
+    if (Rule.IsBackgroundSave && !RunningAsDLL) {
+#else
+    if (Rule.IsBackgroundSave) {
+#endif
+        bool ok = Start_Background_Save(file_name, descr, scenario, house, save_net);
+
+        Decode_All_Pointers();
+
+        NowSavingGame = false; // TEMP MBL: Need to discuss better solution with Steve
+
+        return (ok);
+    }
+
     /*
     **	Open the file
     */
@@ -379,32 +607,9 @@ bool Save_Game(const char* file_name, const char* descr)
     }
 #endif
     /*
-    **	Save the description, scenario #, and house
-    **	(scenario # & house are saved separately from the actual Scenario &
-    **	PlayerPtr globals for convenience; we can quickly find out which
-    **	house & scenario this save-game file is for by reading these values.
-    **	Also, PlayerPtr is stored in a coded form in Save_Misc_Values(),
-    **	which may or may not be a HousesType number; so, saving 'house'
-    **	here ensures we can always pull out the house for this file.)
+    **	Save the description, scenario #, house and save-game version.
     */
-    char descr_buf[DESCRIP_MAX];
-    memset(descr_buf, '\0', sizeof(descr_buf));
-    sprintf(descr_buf, "%s\r\n", descr); // put CR-LF after text
-    // descr_buf[strlen(descr_buf) + 1] = 26;		// put CTRL-Z after NULL
-    fpipe.Put(descr_buf, DESCRIP_MAX);
-
-    fpipe.Put(&scenario, sizeof(scenario));
-
-    fpipe.Put(&house, sizeof(house));
-
-    /*
-    **	Save the save-game version, for loading verification
-    */
-    unsigned int version = SAVEGAME_VERSION;
-#ifdef FIXIT_CSII //	checked - ajw 9/28/98
-    version++;
-#endif
-    fpipe.Put(&version, sizeof(version));
+    Put_Header(fpipe, descr, scenario, house);
 
     int pos = file.Seek(0, SEEK_CUR);
 
@@ -419,26 +624,7 @@ bool Save_Game(const char* file_name, const char* descr)
     **	and then encrypted. The message digest is calculated in the
     **	process by using the data just as it is written to disk.
     */
-    SHAPipe sha;
-    BlowPipe bpipe(BlowPipe::ENCRYPT);
-    LCWPipe pipe(LCWPipe::COMPRESS, SAVE_BLOCK_SIZE);
-    bpipe.Key(&FastKey, BlowfishEngine::MAX_KEY_LENGTH);
-
-    sha.Put_To(fpipe);
-    bpipe.Put_To(sha);
-    pipe.Put_To(bpipe);
-    Put_All(pipe, save_net);
-
-    /*
-    **	Output the real final message digest. This is the one that is of
-    **	the data image as it exists on the disk.
-    */
-    pipe.Flush();
-    file.Seek(pos, SEEK_SET);
-    sha.Result(digest);
-    fpipe.Put(digest, sizeof(digest));
-
-    pipe.End();
+    Put_Body(file, fpipe, pos, NULL, save_net);
 
     Decode_All_Pointers();
 
@@ -515,6 +701,11 @@ bool Load_Game(const char* file_name)
     char descr_buf[DESCRIP_MAX];
     int load_net = 0; // 1 = save network/modem game
 
+    /*
+    **	A save still being written must be finished first.
+    */
+    Finish_Background_Save();
+
     /*
     **	Open the file
     */
@@ -1437,6 +1628,7 @@ bool Get_Savefile_Info(int id, char* buf, unsigned* scenp, HousesType* housep)
     /*
     **	Generate the filename to load
     */
+    Finish_Background_Save();
     sprintf(name, "SAVEGAME.%03d", id);
     CDFileClass file(name);
 
@@ -324,6 +324,18 @@ bool Start_Scenario(char* name, bool briefing)
         return (false);
     }
 
+    /*
+    **	The scenario may have turned on the parallel logic, so start the worker threads now if
+    **	they aren't running yet. It may also have turned on the reference index after some
+    **	objects were made, so build it from scratch.
+    */
+    if (Rule.IsParallelLogic && LogicJobs.Chunks() == 1) {
+        LogicJobs.Start();
+    }
+    if (Rule.IsReferenceIndex) {
+        References.Rebuild();
+    }
+
     /*
     ** This was added in the Sept 16th 2020 update, causes colors to alternate for both in standalone.
     ** Seems likely it would affect the remaster classic renderer as well?
@@ -413,6 +425,11 @@ bool Start_Scenario(char* name, bool briefing)
         Theme.Queue_Song(THEME_FIRST);
     }
 
+    /*
+    ** Decode the sound effects now rather than in the middle of the first battle.
+    */
+    Preload_Sound_Effects();
+
     /*
     ** Set the options values, since the palette has been initialized by Read_Scenario
     */
@@ -732,6 +749,15 @@ void Post_Load_Game(int load_multi)
     }
     Scen.BridgeCount = Map.Intact_Bridge_Count();
     Map.Zone_Reset(MZONEF_ALL);
+    TechnoGrid.Rebuild();
+    TechnoState.Rebuild();
+    StateHash.Rebuild();
+    References.Rebuild();
+    Map.Tiberium_Rebuild();
+
+    if (Rule.IsParallelLogic && LogicJobs.Chunks() == 1) {
+        LogicJobs.Start();
+    }
 }
 
 /***********************************************************************************************
@@ -756,6 +782,7 @@ void Clear_Scenario(void)
 {
     // TCTCTC -- possibly just use in-place new of scenario object?
     ChronalVortex.Stop();
+    PathCache.Clear();
 
     Scen.MissionTimer = 0;
     Scen.MissionTimer.Stop();
@@ -825,6 +852,10 @@ void Clear_Scenario(void)
     TerrainClass::Init();
     UnitClass::Init();
     VesselClass::Init();
+    TechnoGrid.Clear();
+    TechnoState.Clear();
+    StateHash.Clear();
+    References.Clear();
 
     FactoryClass::Init();
 
@@ -0,0 +1,82 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef SIMCTX_H
+#define SIMCTX_H
+
+/*
+**	Per cell A* search state. A node only holds valid data when its generation matches the
+**	generation of the current search.
+*/
+struct AStarNodeType
+{
+    unsigned short Generation; // Search that this node data belongs to.
+    unsigned short Cost;       // Cost of the best known route from the start cell.
+    short HeapIndex;           // Position in the open heap, or -1 once closed.
+    FacingType From;           // Direction that was moved to enter this cell.
+};
+
+/*
+**	Working storage of the path finders. The path returned by Find_Path() or Find_Path_AStar()
+**	lives here too, so it is only valid until the next search in the same context.
+*/
+struct PathScratchType
+{
+    PathType Path;                                  // Path returned by the last search.
+    unsigned int MainOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the main path
+    unsigned int LeftOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the left path
+    unsigned int RightOverlap[MAP_CELL_TOTAL / 32]; // overlap list for the right path
+    CELL StartLocation;                             // Start of the search in progress.
+    CELL DestLocation;                              // Destination, used by the threat check.
+
+    AStarNodeType Nodes[MAP_CELL_TOTAL];
+    CELL OpenHeap[MAP_CELL_TOTAL];
+    unsigned short OpenScore[MAP_CELL_TOTAL];
+    int OpenCount;
+    unsigned short Generation;
+    FacingType MoveList[MAP_CELL_TOTAL];
+};
+
+/*
+**	Simulation state that used to be kept in file and function statics. So far this is only the
+**	path finder scratch; the rest of a match (the map, the object heaps, the houses and the
+**	scenario) is still global. Whoever runs a simulation owns its context and makes it current on
+**	the thread that advances it. The game's own context, MainSimContext, is current on every
+**	thread until something else is set, which includes the logic job workers.
+*/
+class SimContextClass
+{
+public:
+    SimContextClass(void)
+        : Path()
+    {
+    }
+
+    PathScratchType Path;
+
+    static SimContextClass* Current(void)
+    {
+        return (Active);
+    }
+
+    static void Set_Current(SimContextClass* context)
+    {
+        Active = context;
+    }
+
+private:
+    static thread_local SimContextClass* Active;
+
+    SimContextClass(SimContextClass const& rvalue) = delete;
+    SimContextClass& operator=(SimContextClass const& context) = delete;
+};
+
+#endif
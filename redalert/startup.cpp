@@ -470,7 +470,14 @@ int main(int argc, char* argv[])
 
         Memory_Error_Exit = Print_Error_End_Exit;
 
+        int exit_code = EXIT_SUCCESS;
+#ifdef BENCH_SIM_BUILD
+        if (!Bench_Sim(argc, argv)) {
+            exit_code = EXIT_FAILURE;
+        }
+#else
         Main_Game(argc, argv);
+#endif
 
         if (RunningAsDLL) { // PG
             return (EXIT_SUCCESS);
@@ -514,7 +521,7 @@ int main(int argc, char* argv[])
         } while (ReadyToQuit == 1);
 #endif
 
-        return (EXIT_SUCCESS);
+        return (exit_code);
     }
 
     return (EXIT_SUCCESS);
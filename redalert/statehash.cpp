@@ -0,0 +1,405 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "function.h"
+
+/*
+**	The object heap and name that go with each of the tables.
+*/
+static FixedIHeapClass* const KindHeap[] = {&Aircraft, &Buildings, &Infantry, &Units, &Vessels};
+static char const* const KindName[] = {"Aircraft", "Buildings", "Infantry", "Units", "Vessels"};
+
+/*
+**	No region, used for free slots.
+*/
+#define REGION_NONE -1
+
+StateHashClass::StateHashClass(void)
+    : Rehashed(0)
+    , HouseHash(0)
+    , RootHash(0)
+    , ScrubKind(0)
+    , ScrubIndex(0)
+    , IsStale(true)
+{
+    memset(Tables, 0, sizeof(Tables));
+    memset(RegionHash, 0, sizeof(RegionHash));
+}
+
+StateHashClass::~StateHashClass(void)
+{
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        delete[] Tables[kind].Hash;
+        delete[] Tables[kind].Region;
+        delete[] Tables[kind].IsChanged;
+        delete[] Tables[kind].ChangedList;
+    }
+}
+
+int StateHashClass::Kind(RTTIType rtti)
+{
+    switch (rtti) {
+    case RTTI_AIRCRAFT:
+        return (0);
+    case RTTI_BUILDING:
+        return (1);
+    case RTTI_INFANTRY:
+        return (2);
+    case RTTI_UNIT:
+        return (3);
+    case RTTI_VESSEL:
+        return (4);
+    default:
+        return (-1);
+    }
+}
+
+/*
+**	Fetches the object in a slot, or NULL if the slot is free.
+*/
+TechnoClass const* StateHashClass::Object(int kind, int id)
+{
+    TechnoClass const* techno = NULL;
+    switch (kind) {
+    case 0:
+        techno = Aircraft.Raw_Ptr(id);
+        break;
+    case 1:
+        techno = Buildings.Raw_Ptr(id);
+        break;
+    case 2:
+        techno = Infantry.Raw_Ptr(id);
+        break;
+    case 3:
+        techno = Units.Raw_Ptr(id);
+        break;
+    default:
+        techno = Vessels.Raw_Ptr(id);
+        break;
+    }
+
+    if (techno != NULL && !techno->IsActive) {
+        techno = NULL;
+    }
+    return (techno);
+}
+
+/*
+**	Scrambles the bits of a value so that a small change to any input changes about half of the
+**	bits of the result.
+*/
+unsigned long long StateHashClass::Mix(unsigned long long value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return (value);
+}
+
+/*
+**	The object's slot is part of its hash, so that two identical objects don't cancel each other
+**	out when they are combined.
+*/
+unsigned long long StateHashClass::Hash_Object(int kind, TechnoClass const* techno)
+{
+    int type = 0;
+    TARGET navcom = TARGET_NONE;
+    switch (kind) {
+    case 0:
+        type = static_cast<AircraftClass const*>(techno)->Class->Type;
+        navcom = static_cast<AircraftClass const*>(techno)->NavCom;
+        break;
+    case 1:
+        type = static_cast<BuildingClass const*>(techno)->Class->Type;
+        break;
+    case 2:
+        type = static_cast<InfantryClass const*>(techno)->Class->Type;
+        navcom = static_cast<InfantryClass const*>(techno)->NavCom;
+        break;
+    case 3:
+        type = static_cast<UnitClass const*>(techno)->Class->Type;
+        navcom = static_cast<UnitClass const*>(techno)->NavCom;
+        break;
+    default:
+        type = static_cast<VesselClass const*>(techno)->Class->Type;
+        navcom = static_cast<VesselClass const*>(techno)->NavCom;
+        break;
+    }
+
+    unsigned long long hash = Mix(((unsigned long long)(kind + 1) << 32) | (unsigned)techno->ID);
+    hash = Mix(hash ^ ((unsigned long long)type << 32) ^ (unsigned)techno->Owner());
+    hash = Mix(hash ^ ((unsigned long long)techno->Coord << 32) ^ (unsigned)techno->Height);
+    hash = Mix(hash ^ ((unsigned long long)techno->Strength << 32) ^ (unsigned)techno->Mission);
+    hash = Mix(hash ^ ((unsigned long long)techno->TarCom << 32) ^ (unsigned)navcom);
+    hash = Mix(hash ^ ((unsigned long long)techno->PrimaryFacing.Current() << 32) ^ (unsigned)techno->IsInLimbo);
+    return (hash);
+}
+
+int StateHashClass::Region_Of(TechnoClass const* techno)
+{
+    if (techno->IsInLimbo) {
+        return (REGION_LIMBO);
+    }
+
+    CELL cell = Coord_Cell(techno->Coord);
+    return ((Cell_Y(cell) >> REGION_SHIFT) * (MAP_CELL_W >> REGION_SHIFT) + (Cell_X(cell) >> REGION_SHIFT));
+}
+
+/*
+**	Sizes the tables to match the object heaps. This must be called whenever the heaps have
+**	been set up.
+*/
+void StateHashClass::Init(void)
+{
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        TableType& table = Tables[kind];
+        int size = KindHeap[kind]->Length();
+
+        if (table.Size != size) {
+            delete[] table.Hash;
+            delete[] table.Region;
+            delete[] table.IsChanged;
+            delete[] table.ChangedList;
+            table.Size = size;
+            table.Hash = new unsigned long long[size];
+            table.Region = new short[size];
+            table.IsChanged = new unsigned char[size];
+            table.ChangedList = new int[size];
+        }
+    }
+    Clear();
+}
+
+void StateHashClass::Clear(void)
+{
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        TableType& table = Tables[kind];
+        table.ChangedCount = 0;
+        table.Rollup = 0;
+        for (int index = 0; index < table.Size; index++) {
+            table.Hash[index] = 0;
+            table.Region[index] = REGION_NONE;
+            table.IsChanged[index] = false;
+        }
+    }
+    memset(RegionHash, 0, sizeof(RegionHash));
+    HouseHash = 0;
+    RootHash = 0;
+    ScrubKind = 0;
+    ScrubIndex = 0;
+    IsStale = true;
+}
+
+/*
+**	Throws away the hashes so that every object is hashed again on the next update. This is
+**	needed after a saved game has been loaded, since loading does not flag the objects.
+*/
+void StateHashClass::Rebuild(void)
+{
+    Clear();
+}
+
+/*
+**	Flags an object as changed so that it will be rehashed on the next update. Objects that
+**	aren't techno objects are ignored.
+*/
+void StateHashClass::Changed(ObjectClass const* object)
+{
+    int kind = Kind(object->RTTI);
+    if (kind < 0 || (unsigned)object->ID >= (unsigned)Tables[kind].Size) {
+        return;
+    }
+
+    TableType& table = Tables[kind];
+    if (!table.IsChanged[object->ID]) {
+        table.IsChanged[object->ID] = true;
+        table.ChangedList[table.ChangedCount++] = object->ID;
+    }
+}
+
+/*
+**	Takes an object that is being deleted out of the hashes.
+*/
+void StateHashClass::Remove(RTTIType rtti, int id)
+{
+    int kind = Kind(rtti);
+    if (kind >= 0 && (unsigned)id < (unsigned)Tables[kind].Size) {
+        Set(kind, id, 0, REGION_NONE);
+    }
+}
+
+/*
+**	Replaces the hash held for a slot, taking the old one out of the combined hashes and
+**	putting the new one in.
+*/
+void StateHashClass::Set(int kind, int id, unsigned long long hash, int region)
+{
+    TableType& table = Tables[kind];
+    unsigned long long old = table.Hash[id];
+    int old_region = table.Region[id];
+
+    if (old == hash && old_region == region) {
+        return;
+    }
+
+    table.Rollup ^= old ^ hash;
+    if (old_region != REGION_NONE) {
+        RegionHash[old_region] ^= old;
+    }
+    if (region != REGION_NONE) {
+        RegionHash[region] ^= hash;
+    }
+    table.Hash[id] = hash;
+    table.Region[id] = (short)region;
+}
+
+void StateHashClass::Rehash(int kind, int id)
+{
+    TechnoClass const* techno = Object(kind, id);
+    if (techno == NULL) {
+        Set(kind, id, 0, REGION_NONE);
+    } else {
+        Set(kind, id, Hash_Object(kind, techno), Region_Of(techno));
+    }
+    Rehashed++;
+}
+
+/*
+**	Rehashes the objects that have been flagged as changed, plus the next few in turn, and works
+**	out the new root hash. This should be called once a game frame, at the same point in every
+**	game, or the hashes won't match up.
+*/
+void StateHashClass::Update(void)
+{
+    Rehashed = 0;
+
+    if (IsStale) {
+        for (int kind = 0; kind < KIND_COUNT; kind++) {
+            for (int id = 0; id < Tables[kind].Size; id++) {
+                Rehash(kind, id);
+            }
+        }
+        IsStale = false;
+    }
+
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        TableType& table = Tables[kind];
+        for (int index = 0; index < table.ChangedCount; index++) {
+            int id = table.ChangedList[index];
+            table.IsChanged[id] = false;
+            Rehash(kind, id);
+        }
+        table.ChangedCount = 0;
+    }
+
+    /*
+    **	Pick up anything that changed without being flagged.
+    */
+    for (int count = 0; count < SCRUB_COUNT; count++) {
+        while (ScrubIndex >= Tables[ScrubKind].Size) {
+            ScrubIndex = 0;
+            ScrubKind = (ScrubKind + 1) % KIND_COUNT;
+            if (ScrubKind == 0) {
+                break;
+            }
+        }
+        if (ScrubIndex < Tables[ScrubKind].Size) {
+            Rehash(ScrubKind, ScrubIndex);
+        }
+        ScrubIndex++;
+    }
+
+    /*
+    **	There are only a few houses, so they are hashed every time.
+    */
+    HouseHash = 0;
+    for (int index = 0; index < Houses.Count(); index++) {
+        HouseClass const* house = (HouseClass const*)Houses.Active_Ptr(index);
+        unsigned long long hash = Mix(((unsigned long long)house->Class->House << 32) | (unsigned)house->Credits);
+        hash = Mix(hash ^ ((unsigned long long)house->Power << 32) ^ (unsigned)house->Drain);
+        hash = Mix(hash ^ ((unsigned long long)house->Tiberium << 32) ^ (unsigned)house->IsDefeated);
+        HouseHash ^= hash;
+    }
+
+    RootHash = Mix(HouseHash ^ Scen.RandomNumber.Seed);
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        RootHash = Mix(RootHash ^ Tables[kind].Rollup);
+    }
+}
+
+unsigned long long StateHashClass::Kind_Hash(RTTIType rtti) const
+{
+    int kind = Kind(rtti);
+    return ((kind < 0) ? 0 : Tables[kind].Rollup);
+}
+
+unsigned long long StateHashClass::Region_Hash(int region) const
+{
+    return (((unsigned)region < (unsigned)REGION_COUNT) ? RegionHash[region] : 0);
+}
+
+unsigned long long StateHashClass::Object_Hash(RTTIType rtti, int id) const
+{
+    int kind = Kind(rtti);
+    if (kind < 0 || (unsigned)id >= (unsigned)Tables[kind].Size) {
+        return (0);
+    }
+    return (Tables[kind].Hash[id]);
+}
+
+/*
+**	Writes out every level of the hashes, so that the files from two games can be compared to
+**	find the objects they disagree on.
+*/
+void StateHashClass::Write(FileClass& file)
+{
+    char buffer[256];
+
+    snprintf(buffer, sizeof(buffer), "\nState hash: %016llx\n", RootHash);
+    file.Write(buffer, strlen(buffer));
+    snprintf(buffer, sizeof(buffer), "Houses: %016llx\n", HouseHash);
+    file.Write(buffer, strlen(buffer));
+
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        snprintf(buffer, sizeof(buffer), "%s: %016llx\n", KindName[kind], Tables[kind].Rollup);
+        file.Write(buffer, strlen(buffer));
+    }
+
+    for (int region = 0; region < REGION_COUNT; region++) {
+        if (RegionHash[region] == 0) {
+            continue;
+        }
+
+        if (region == REGION_LIMBO) {
+            snprintf(buffer, sizeof(buffer), "Region limbo: %016llx\n", RegionHash[region]);
+        } else {
+            snprintf(buffer,
+                     sizeof(buffer),
+                     "Region %d,%d: %016llx\n",
+                     (region % (MAP_CELL_W >> REGION_SHIFT)) << REGION_SHIFT,
+                     (region / (MAP_CELL_W >> REGION_SHIFT)) << REGION_SHIFT,
+                     RegionHash[region]);
+        }
+        file.Write(buffer, strlen(buffer));
+
+        for (int kind = 0; kind < KIND_COUNT; kind++) {
+            TableType const& table = Tables[kind];
+            for (int id = 0; id < table.Size; id++) {
+                if (table.Region[id] == region) {
+                    snprintf(buffer, sizeof(buffer), "  %s %d: %016llx\n", KindName[kind], id, table.Hash[id]);
+                    file.Write(buffer, strlen(buffer));
+                }
+            }
+        }
+    }
+}
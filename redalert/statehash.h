@@ -0,0 +1,114 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+class FileClass;
+
+/*
+**	Hierarchical hash of the game state, used to track down where a desync happened. Every
+**	techno object has its own 64 bit hash, and these are combined into a hash for each kind of
+**	object and a hash for each region of the map. The kind hashes, the houses and the random
+**	number seed are then combined into a single root hash. Two games that disagree on the root
+**	can compare the kind or region hashes to narrow down where they differ, and then the
+**	object hashes within that to find the object itself.
+**
+**	The object hashes are combined with exclusive or, so when an object changes only its old
+**	hash has to be taken out and the new one put in. Objects are rehashed when the game flags
+**	them as changed (moved, damaged, given new orders, created or deleted) and a few are also
+**	rehashed every frame in turn so that any change that isn't flagged still shows up within a
+**	short time. Since both of these only depend on the game logic, every game that is in sync
+**	holds the same hashes on the same frame.
+*/
+class StateHashClass
+{
+public:
+    enum
+    {
+        REGION_SHIFT = 4, // Regions are 16x16 cells.
+        REGION_LIMBO = (MAP_CELL_W >> REGION_SHIFT) * (MAP_CELL_H >> REGION_SHIFT), // Objects not on the map.
+        REGION_COUNT = REGION_LIMBO + 1,
+        SCRUB_COUNT = 32 // Objects rehashed every frame whether they were flagged or not.
+    };
+
+    StateHashClass(void);
+    ~StateHashClass(void);
+
+    void Init(void);
+    void Clear(void);
+    void Rebuild(void);
+
+    void Changed(ObjectClass const* object);
+    void Remove(RTTIType rtti, int id);
+    void Update(void);
+
+    unsigned long long Root(void) const
+    {
+        return (RootHash);
+    };
+    unsigned long long Kind_Hash(RTTIType rtti) const;
+    unsigned long long Region_Hash(int region) const;
+    unsigned long long Object_Hash(RTTIType rtti, int id) const;
+    unsigned long long House_Hash(void) const
+    {
+        return (HouseHash);
+    };
+
+    void Write(FileClass& file);
+
+    /*
+    **	Statistics for tuning.
+    */
+    unsigned int Rehashed; // Objects rehashed by the last update.
+
+private:
+    enum
+    {
+        KIND_COUNT = 5 // Aircraft, buildings, infantry, units and vessels.
+    };
+
+    struct TableType
+    {
+        int Size;                  // Number of slots, the same as the size of the object heap.
+        unsigned long long* Hash;  // Hash of the object in each slot, zero when the slot is free.
+        short* Region;             // Region the object was in when it was last hashed.
+        unsigned char* IsChanged;  // Slot is in the changed list.
+        int* ChangedList;          // Slots flagged as changed since the last update.
+        int ChangedCount;
+        unsigned long long Rollup; // All the object hashes combined.
+    };
+
+    static int Kind(RTTIType rtti);
+    static TechnoClass const* Object(int kind, int id);
+    static unsigned long long Mix(unsigned long long value);
+    static unsigned long long Hash_Object(int kind, TechnoClass const* techno);
+    static int Region_Of(TechnoClass const* techno);
+
+    void Rehash(int kind, int id);
+    void Set(int kind, int id, unsigned long long hash, int region);
+
+    TableType Tables[KIND_COUNT];
+    unsigned long long RegionHash[REGION_COUNT];
+    unsigned long long HouseHash;
+    unsigned long long RootHash;
+    int ScrubKind;   // Where the rehash of unflagged objects has got to.
+    int ScrubIndex;
+    bool IsStale;    // Every object has to be rehashed on the next update.
+
+    // The assignment operator is not supported.
+    StateHashClass& operator=(StateHashClass const&) = delete;
+
+    // The copy constructor is not supported.
+    StateHashClass(StateHashClass const&) = delete;
+};
+
+#endif
@@ -0,0 +1,120 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "function.h"
+
+/*
+**	The kind of object that each slot in the grid is used for.
+*/
+static RTTIType const KindRTTI[] = {RTTI_AIRCRAFT, RTTI_BUILDING, RTTI_INFANTRY, RTTI_UNIT, RTTI_VESSEL};
+
+TechnoGridClass::TechnoGridClass(void)
+{
+    Clear();
+}
+
+int TechnoGridClass::Bucket(CELL cell)
+{
+    return ((Cell_Y(cell) >> BUCKET_SHIFT) * BUCKET_WIDTH + (Cell_X(cell) >> BUCKET_SHIFT));
+}
+
+int TechnoGridClass::Kind(RTTIType rtti)
+{
+    switch (rtti) {
+    case RTTI_AIRCRAFT:
+        return (0);
+    case RTTI_BUILDING:
+        return (1);
+    case RTTI_INFANTRY:
+        return (2);
+    case RTTI_UNIT:
+        return (3);
+    case RTTI_VESSEL:
+        return (4);
+    default:
+        return (-1);
+    }
+}
+
+void TechnoGridClass::Clear(void)
+{
+    memset(Count, 0, sizeof(Count));
+    memset(Houses, 0, sizeof(Houses));
+}
+
+/*
+**	Recounts the whole map from the cell occupation lists. This is needed after a saved game
+**	is loaded and whenever an object that is on the map changes owner.
+*/
+void TechnoGridClass::Rebuild(void)
+{
+    Clear();
+    for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
+        for (ObjectClass const* object = Map[cell].Cell_Occupier(); object != NULL; object = object->Next) {
+            Add(cell, object);
+        }
+    }
+}
+
+void TechnoGridClass::Add(CELL cell, ObjectClass const* object)
+{
+    int kind = Kind(object->What_Am_I());
+    if (kind < 0 || (unsigned)cell >= MAP_CELL_TOTAL) {
+        return;
+    }
+
+    HousesType house = object->Owner();
+    if ((unsigned)house >= HOUSE_COUNT) {
+        return;
+    }
+
+    int bucket = Bucket(cell);
+    Count[bucket][kind][house]++;
+    Houses[bucket][kind] |= (1U << house);
+}
+
+void TechnoGridClass::Remove(CELL cell, ObjectClass const* object)
+{
+    int kind = Kind(object->What_Am_I());
+    if (kind < 0 || (unsigned)cell >= MAP_CELL_TOTAL) {
+        return;
+    }
+
+    HousesType house = object->Owner();
+    if ((unsigned)house >= HOUSE_COUNT) {
+        return;
+    }
+
+    int bucket = Bucket(cell);
+    if (Count[bucket][kind][house] > 0 && --Count[bucket][kind][house] == 0) {
+        Houses[bucket][kind] &= ~(1U << house);
+    }
+}
+
+/*
+**	Could the cell specified be occupied by an object of one of the kinds in the RTTI mask
+**	that is owned by one of the houses in the house mask? A false return is definite, a
+**	true return only means that the cell needs to be examined.
+*/
+bool TechnoGridClass::Is_Candidate(CELL cell, int rttimask, unsigned houses) const
+{
+    if ((unsigned)cell >= MAP_CELL_TOTAL) {
+        return (false);
+    }
+
+    unsigned int const* bucket = Houses[Bucket(cell)];
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        if (((1 << KindRTTI[kind]) & rttimask) && (bucket[kind] & houses)) {
+            return (true);
+        }
+    }
+    return (false);
+}
@@ -0,0 +1,62 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef TECHGRID_H
+#define TECHGRID_H
+
+/*
+**	Coarse index of where the techno objects on the map are. The map is divided into square
+**	buckets of cells and each bucket keeps a count of the objects occupying its cells, split
+**	by the kind of object and the house that owns it. Target scans use this to skip over the
+**	parts of the map that can't hold anything they are looking for.
+**
+**	The counts follow the cell occupation lists exactly. They are maintained by the
+**	CellClass::Occupy_Down() and CellClass::Occupy_Up() routines, which are only ever called
+**	by MapClass::Place_Down() and MapClass::Pick_Up().
+*/
+class TechnoGridClass
+{
+public:
+    TechnoGridClass(void);
+
+    void Clear(void);
+    void Rebuild(void);
+
+    void Add(CELL cell, ObjectClass const* object);
+    void Remove(CELL cell, ObjectClass const* object);
+
+    bool Is_Candidate(CELL cell, int rttimask, unsigned houses) const;
+
+private:
+    enum
+    {
+        BUCKET_SHIFT = 3, // Buckets are 8x8 cells.
+        BUCKET_WIDTH = MAP_CELL_W >> BUCKET_SHIFT,
+        BUCKET_COUNT = BUCKET_WIDTH * (MAP_CELL_H >> BUCKET_SHIFT),
+        KIND_COUNT = 5 // Aircraft, buildings, infantry, units and vessels.
+    };
+
+    static int Bucket(CELL cell);
+    static int Kind(RTTIType rtti);
+
+    /*
+    **	Number of objects of each kind and owner in each bucket.
+    */
+    unsigned short Count[BUCKET_COUNT][KIND_COUNT][HOUSE_COUNT];
+
+    /*
+    **	For each bucket and kind of object, a bit is set for every house that has at least
+    **	one object of that kind in the bucket.
+    */
+    unsigned int Houses[BUCKET_COUNT][KIND_COUNT];
+};
+
+#endif
@@ -597,15 +597,15 @@ void TechnoClass::Debug_Dump(MonoClass* mono) const
     }
     if (Target_Legal(TarCom)) {
         mono->Set_Cursor(29, 3);
-        mono->Printf("%08X", TarCom);
+        mono->Printf("%08X", (TARGET)TarCom);
     }
     if (Target_Legal(SuspendedTarCom)) {
         mono->Set_Cursor(38, 3);
-        mono->Printf("%08X", SuspendedTarCom);
+        mono->Printf("%08X", (TARGET)SuspendedTarCom);
     }
     if (Target_Legal(ArchiveTarget)) {
         mono->Set_Cursor(69, 5);
-        mono->Printf("%08X", ArchiveTarget);
+        mono->Printf("%08X", (TARGET)ArchiveTarget);
     }
     mono->Set_Cursor(47, 3);
     mono->Printf("%02X:%02X", PrimaryFacing.Current(), PrimaryFacing.Desired());
@@ -786,6 +786,7 @@ bool TechnoClass::Revealed(HouseClass* house)
         if (Session.Type == GAME_NORMAL) {
             if (house == PlayerPtr) {
                 IsDiscoveredByPlayer = true;
+                TechnoState.Update(this);
 
                 if (!IsOwnedByPlayer) {
 
@@ -1093,6 +1094,7 @@ void TechnoClass::Per_Cell_Process(PCPType why)
         */
         if (!IsLocked && Map.In_Radar(cell)) {
             IsLocked = true;
+            TechnoState.Update(this);
         }
 
         /*
@@ -1279,6 +1281,7 @@ bool TechnoClass::Unlimbo(COORDINATE coord, DirType dir)
         Commence();
 
         IsLocked = Map.In_Radar(Coord_Cell(coord));
+        TechnoState.Update(this);
         return (true);
     }
     return (false);
@@ -2101,6 +2104,53 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
         return !House->Is_Ally(object) && ((Cloak == CLOAKED) || is_invisible);
     }
 
+    /*
+    **	Ground layers with fewer objects than this are always scanned in one thread.
+    */
+#define PARALLEL_SCAN_MINIMUM 256
+
+    /*
+    **	A whole map scan of the ground layer, split into chunks. Each chunk records the first of
+    **	its best objects.
+    */
+    struct GroundScanType
+    {
+        TechnoClass const* Scanner;
+        ThreatType Method;
+        int Mask;
+        unsigned Houses;
+        int Zone;
+        ObjectClass const* BestObject[JobPoolClass::MAX_CHUNKS];
+        int BestValue[JobPoolClass::MAX_CHUNKS];
+    };
+
+    static void Scan_Ground_Layer(int chunk, int first, int last, void* data)
+    {
+        GroundScanType& scan = *static_cast<GroundScanType*>(data);
+        ObjectClass const* bestobject = NULL;
+        int bestval = -1;
+
+        for (int index = first; index < last; index++) {
+            ObjectClass const* object = Map.Layer[LAYER_GROUND][index];
+
+            int value = 0;
+            if (!object->Is_Techno() || !((1 << object->What_Am_I()) & scan.Mask)
+                || !(scan.Houses & (1U << object->Owner()))) {
+                continue;
+            }
+            if (scan.Scanner->Evaluate_Object(
+                    scan.Method, scan.Mask, -1, (TechnoClass const*)object, value, scan.Zone)) {
+                if (value > bestval) {
+                    bestobject = object;
+                    bestval = value;
+                }
+            }
+        }
+
+        scan.BestObject[chunk] = bestobject;
+        scan.BestValue[chunk] = bestval;
+    }
+
     /***********************************************************************************************
      * TechnoClass::Greatest_Threat -- Determines best target given search criteria.               *
      *                                                                                             *
@@ -2186,6 +2236,13 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
         if (method & THREAT_BOATS)
             mask |= (1 << RTTI_VESSEL);
 
+        /*
+        **	Only objects owned by these houses can ever be chosen. Medics look for friends to
+        **	heal and everyone else looks for enemies. This lets the scans below skip objects
+        **	and map areas that would be rejected anyway.
+        */
+        unsigned houses = (Combat_Damage() < 0) ? House->Get_Allies() : ~House->Get_Allies();
+
         /*
         **	Limit area target scans use a method where the actual map cells are
         **	examined for occupants. The occupant is then examined in turn. The
@@ -2219,7 +2276,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
                     TechnoClass* object = Aircraft.Ptr(index);
 
                     int value = 0;
-                    if (object->In_Which_Layer() != LAYER_GROUND
+                    if ((houses & (1U << object->Owner())) && object->In_Which_Layer() != LAYER_GROUND
                         && Evaluate_Object(method, mask, range, object, value)) {
                         if (value > bestval) {
                             bestobject = object;
@@ -2268,7 +2325,8 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
 
                     if ((Cell_Y(cell) - radius) >= Map.MapCellY) {
                         newcell = XY_Cell(Cell_X(cell) + x, Cell_Y(cell) - radius);
-                        if (Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
+                        if (TechnoGrid.Is_Candidate(newcell, mask, houses)
+                            && Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
                             if (bestval < value) {
                                 bestobject = object;
                             }
@@ -2284,7 +2342,8 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
 
                     if ((Cell_Y(cell) + radius) < (Map.MapCellY + Map.MapCellHeight)) {
                         newcell = XY_Cell(Cell_X(cell) + x, Cell_Y(cell) + radius);
-                        if (Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
+                        if (TechnoGrid.Is_Candidate(newcell, mask, houses)
+                            && Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
                             if (bestval < value) {
                                 bestobject = object;
                             }
@@ -2312,7 +2371,8 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
 
                     if ((Cell_X(cell) - radius) >= Map.MapCellX) {
                         newcell = XY_Cell(Cell_X(cell) - radius, Cell_Y(cell) + y);
-                        if (Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
+                        if (TechnoGrid.Is_Candidate(newcell, mask, houses)
+                            && Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
                             if (bestval < value) {
                                 bestobject = object;
                             }
@@ -2328,7 +2388,8 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
 
                     if ((Cell_X(cell) + radius) < (Map.MapCellX + Map.MapCellWidth)) {
                         newcell = XY_Cell(Cell_X(cell) + radius, Cell_Y(cell) + y);
-                        if (Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
+                        if (TechnoGrid.Is_Candidate(newcell, mask, houses)
+                            && Evaluate_Cell(method, mask, newcell, range, &object, value, zone)) {
                             if (bestval < value) {
                                 bestobject = object;
                             }
@@ -2371,7 +2432,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
                     TechnoClass* object = Aircraft.Ptr(index);
 
                     int value = 0;
-                    if (Evaluate_Object(method, mask, -1, object, value)) {
+                    if ((houses & (1U << object->Owner())) && Evaluate_Object(method, mask, -1, object, value)) {
                         if (value > bestval) {
                             bestobject = object;
                             bestval = value;
@@ -2391,17 +2452,25 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
 
             /*
             **	Now scan through the entire ground layer. This is painful, but what other
-            **	choice is there?
+            **	choice is there? A large layer is split between the logic worker threads.
+            **	The chunks are compared in order afterwards, so the first of equally good
+            **	objects is still the one picked. The profiler isn't thread safe, so the scan
+            **	stays in one thread while it is running.
             */
-            for (int index = 0; index < Map.Layer[LAYER_GROUND].Count(); index++) {
-                ObjectClass const* object = Map.Layer[LAYER_GROUND][index];
-
-                int value = 0;
-                if (object->Is_Techno() && Evaluate_Object(method, mask, -1, (TechnoClass const*)object, value, zone)) {
-                    if (value > bestval) {
-                        bestobject = object;
-                        bestval = value;
-                    }
+            GroundScanType scan;
+            scan.Scanner = this;
+            scan.Method = method;
+            scan.Mask = mask;
+            scan.Houses = houses;
+            scan.Zone = zone;
+
+            int minimum = (Rule.IsParallelLogic && Benches == NULL) ? PARALLEL_SCAN_MINIMUM : INT_MAX;
+            int chunks = LogicJobs.Run(Map.Layer[LAYER_GROUND].Count(), minimum, Scan_Ground_Layer, &scan);
+
+            for (int chunk = 0; chunk < chunks; chunk++) {
+                if (scan.BestValue[chunk] > bestval) {
+                    bestobject = scan.BestObject[chunk];
+                    bestval = scan.BestValue[chunk];
                 }
             }
         }
@@ -3007,6 +3076,8 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
         if (target == TarCom)
             return;
 
+        StateHash.Changed(this);
+
         if (!Target_Legal(target)) {
             target = TARGET_NONE;
         } else {
@@ -4062,6 +4133,9 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
             */
             House = newowner;
             IsOwnedByPlayer = (House == PlayerPtr);
+            TechnoGrid.Rebuild();
+            TechnoState.Update(this);
+            StateHash.Changed(this);
 
             return (true);
         }
@@ -7184,6 +7258,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
 
         if (Session.Type != GAME_GLYPHX_MULTIPLAYER && player == PlayerPtr) {
             IsDiscoveredByPlayer = true;
+            TechnoState.Update(this);
         }
     }
 
@@ -7203,6 +7278,7 @@ bool TechnoClass::Evaluate_Object(ThreatType method,
     {
         IsDiscoveredByPlayerMask = 0;
         IsDiscoveredByPlayer = false;
+        TechnoState.Update(this);
     }
 
     /***********************************************************************************************
@@ -186,7 +186,7 @@ public:
     **	the transport to become available. It is also used by harvesters so that they know
     **	where to head back to after unloading.
     */
-    TARGET ArchiveTarget;
+    TargetRefClass ArchiveTarget;
 
     /*
     **	This is the house that the unit belongs to.
@@ -204,8 +204,8 @@ public:
     **	This is the target value for the item that this vehicle should ATTACK. If this
     **	is a vehicle with a turret, then it may differ from its movement destination.
     */
-    TARGET TarCom;
-    TARGET SuspendedTarCom;
+    TargetRefClass TarCom;
+    TargetRefClass SuspendedTarCom;
 
     /*
     **	This is the visible facing for the unit or building.
@@ -0,0 +1,190 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "function.h"
+
+/*
+**	The object heap that goes with each of the tables.
+*/
+static FixedIHeapClass* const KindHeap[] = {&Aircraft, &Buildings, &Infantry, &Units, &Vessels};
+
+TechnoStateClass::TechnoStateClass(void)
+{
+    memset(Tables, 0, sizeof(Tables));
+}
+
+TechnoStateClass::~TechnoStateClass(void)
+{
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        delete[] Tables[kind].House;
+        delete[] Tables[kind].Type;
+        delete[] Tables[kind].Flags;
+    }
+}
+
+int TechnoStateClass::Kind(RTTIType rtti)
+{
+    switch (rtti) {
+    case RTTI_AIRCRAFT:
+        return (0);
+    case RTTI_BUILDING:
+        return (1);
+    case RTTI_INFANTRY:
+        return (2);
+    case RTTI_UNIT:
+        return (3);
+    case RTTI_VESSEL:
+        return (4);
+    default:
+        return (-1);
+    }
+}
+
+/*
+**	Sizes the tables to match the object heaps. This must be called whenever the heaps have
+**	been set up.
+*/
+void TechnoStateClass::Init(void)
+{
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        TableType& table = Tables[kind];
+        int size = KindHeap[kind]->Length();
+
+        if (table.Size != size) {
+            delete[] table.House;
+            delete[] table.Type;
+            delete[] table.Flags;
+            table.Size = size;
+            table.House = new signed char[size];
+            table.Type = new unsigned char[size];
+            table.Flags = new unsigned char[size];
+        }
+    }
+    Clear();
+}
+
+void TechnoStateClass::Clear(void)
+{
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        TableType& table = Tables[kind];
+        table.Top = 0;
+        if (table.Size > 0) {
+            memset(table.House, -1, table.Size);
+            memset(table.Type, 0, table.Size);
+            memset(table.Flags, 0, table.Size);
+        }
+    }
+}
+
+/*
+**	Fills the tables in from the objects themselves. This is needed after a saved game has been
+**	loaded, since loading does not construct the objects.
+*/
+void TechnoStateClass::Rebuild(void)
+{
+    Clear();
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        FixedIHeapClass* heap = KindHeap[kind];
+        for (int index = 0; index < heap->Count(); index++) {
+            TechnoClass const* techno = NULL;
+            switch (kind) {
+            case 0:
+                techno = (AircraftClass const*)heap->Active_Ptr(index);
+                break;
+            case 1:
+                techno = (BuildingClass const*)heap->Active_Ptr(index);
+                break;
+            case 2:
+                techno = (InfantryClass const*)heap->Active_Ptr(index);
+                break;
+            case 3:
+                techno = (UnitClass const*)heap->Active_Ptr(index);
+                break;
+            default:
+                techno = (VesselClass const*)heap->Active_Ptr(index);
+                break;
+            }
+            Update(techno);
+        }
+    }
+}
+
+/*
+**	Copies the current values from the object into its slot.
+*/
+void TechnoStateClass::Update(TechnoClass const* techno)
+{
+    int kind = Kind(techno->What_Am_I());
+    if (kind < 0) {
+        return;
+    }
+
+    TableType& table = Tables[kind];
+    int id = techno->ID;
+    if ((unsigned)id >= (unsigned)table.Size) {
+        return;
+    }
+
+    int type = 0;
+    switch (techno->What_Am_I()) {
+    case RTTI_AIRCRAFT:
+        type = static_cast<AircraftClass const*>(techno)->Class->Type;
+        break;
+    case RTTI_BUILDING:
+        type = static_cast<BuildingClass const*>(techno)->Class->Type;
+        break;
+    case RTTI_INFANTRY:
+        type = static_cast<InfantryClass const*>(techno)->Class->Type;
+        break;
+    case RTTI_UNIT:
+        type = static_cast<UnitClass const*>(techno)->Class->Type;
+        break;
+    default:
+        type = static_cast<VesselClass const*>(techno)->Class->Type;
+        break;
+    }
+
+    int flags = 0;
+    if (techno->IsLocked) {
+        flags |= IS_LOCKED;
+    }
+    if (techno->IsInLimbo) {
+        flags |= IS_IN_LIMBO;
+    }
+    if (techno->IsDiscoveredByPlayer) {
+        flags |= IS_DISCOVERED_BY_PLAYER;
+    }
+
+    table.House[id] = (signed char)techno->House.Raw();
+    table.Type[id] = (unsigned char)type;
+    table.Flags[id] = (unsigned char)flags;
+    if (id >= table.Top) {
+        table.Top = id + 1;
+    }
+}
+
+/*
+**	Frees the slot of an object that is being deleted.
+*/
+void TechnoStateClass::Remove(RTTIType rtti, int id)
+{
+    int kind = Kind(rtti);
+    if (kind < 0 || (unsigned)id >= (unsigned)Tables[kind].Size) {
+        return;
+    }
+
+    TableType& table = Tables[kind];
+    table.House[id] = -1;
+    table.Flags[id] = 0;
+    while (table.Top > 0 && table.House[table.Top - 1] == -1) {
+        table.Top--;
+    }
+}
@@ -0,0 +1,76 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#ifndef TECHSTAT_H
+#define TECHSTAT_H
+
+/*
+**	Compact copy of the techno object values that the per frame scans look at. Each kind of
+**	techno object has a table with one slot for every entry in its object heap, stored as
+**	separate arrays so that a scan only touches the values it is interested in rather than
+**	pulling every object it visits into the cache.
+**
+**	The tables are kept up to date by the routines that change these values on the objects:
+**	construction and deletion, limbo and unlimbo, ownership changes and so on. The coordinate
+**	is refreshed after each object has been given its logic processing for the frame.
+*/
+class TechnoStateClass
+{
+public:
+    enum
+    {
+        IS_LOCKED = 0x01,              // TechnoClass::IsLocked.
+        IS_IN_LIMBO = 0x02,            // TechnoClass::IsInLimbo.
+        IS_DISCOVERED_BY_PLAYER = 0x04 // TechnoClass::IsDiscoveredByPlayer.
+    };
+
+    struct TableType
+    {
+        int Size;            // Number of slots, the same as the size of the object heap.
+        int Top;             // All slots from here on are free.
+        signed char* House;  // Heap index of the owning house, or -1 if the slot is free.
+        unsigned char* Type; // Type of the object within its kind.
+        unsigned char* Flags;
+    };
+
+    TechnoStateClass(void);
+    ~TechnoStateClass(void);
+
+    void Init(void);
+    void Clear(void);
+    void Rebuild(void);
+
+    void Update(TechnoClass const* techno);
+    void Remove(RTTIType rtti, int id);
+
+    TableType const& Table(RTTIType rtti) const
+    {
+        return (Tables[Kind(rtti)]);
+    };
+
+private:
+    enum
+    {
+        KIND_COUNT = 5 // Aircraft, buildings, infantry, units and vessels.
+    };
+
+    static int Kind(RTTIType rtti);
+
+    TableType Tables[KIND_COUNT];
+
+    // The assignment operator is not supported.
+    TechnoStateClass& operator=(TechnoStateClass const&) = delete;
+
+    // The copy constructor is not supported.
+    TechnoStateClass(TechnoStateClass const&) = delete;
+};
+
+#endif
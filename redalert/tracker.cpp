@@ -70,26 +70,36 @@ void Detach_This_From_All(TARGET target, bool all)
         for (index = 0; index < TeamTypes.Count(); index++) {
             TeamTypes.Ptr(index)->Detach(target, all);
         }
-        for (index = 0; index < Units.Count(); index++) {
-            Units.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Vessels.Count(); index++) {
-            Vessels.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Aircraft.Count(); index++) {
-            Aircraft.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Buildings.Count(); index++) {
-            Buildings.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Bullets.Count(); index++) {
-            Bullets.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Infantry.Count(); index++) {
-            Infantry.Ptr(index)->Detach(target, all);
-        }
-        for (index = 0; index < Anims.Count(); index++) {
-            Anims.Ptr(index)->Detach(target, all);
+        /*
+        **	The reference index knows which objects may refer to the target, so only those
+        **	need to be visited. Otherwise every object is.
+        */
+        if (Rule.IsReferenceIndex && References.Detach(target, all)) {
+            if (Rule.IsReferenceCheck) {
+                References.Check(target, all);
+            }
+        } else {
+            for (index = 0; index < Units.Count(); index++) {
+                Units.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Vessels.Count(); index++) {
+                Vessels.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Aircraft.Count(); index++) {
+                Aircraft.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Buildings.Count(); index++) {
+                Buildings.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Bullets.Count(); index++) {
+                Bullets.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Infantry.Count(); index++) {
+                Infantry.Ptr(index)->Detach(target, all);
+            }
+            for (index = 0; index < Anims.Count(); index++) {
+                Anims.Ptr(index)->Detach(target, all);
+            }
         }
 
         Map.Detach(target, all);
@@ -202,6 +202,8 @@ void UnitClass::operator delete(void* ptr)
     if (ptr != NULL) {
         ((UnitClass*)ptr)->IsActive = false;
     }
+    TechnoState.Remove(RTTI_UNIT, Units.ID((UnitClass*)ptr));
+    StateHash.Remove(RTTI_UNIT, Units.ID((UnitClass*)ptr));
     Units.Free((UnitClass*)ptr);
 }
 
@@ -302,6 +304,8 @@ UnitClass::UnitClass(UnitType classid, HousesType house)
     //	if (Session.Type == GAME_INTERNET) {
     //		House->UnitTotals->Increment_Unit_Total((int)classid);
     //	}
+
+    TechnoState.Update(this);
 }
 
 #ifdef CHEAT_KEYS
@@ -118,6 +118,8 @@ VesselClass::VesselClass(VesselType classid, HousesType house)
     //	if (Session.Type == GAME_INTERNET) {
     //		House->UnitTotals->Increment_Unit_Total((int)classid);
     //	}
+
+    TechnoState.Update(this);
 }
 
 /***********************************************************************************************
@@ -207,6 +209,8 @@ void VesselClass::operator delete(void* ptr)
         assert(((VesselClass*)ptr)->IsActive);
         ((VesselClass*)ptr)->IsActive = false;
     }
+    TechnoState.Remove(RTTI_VESSEL, Vessels.ID((VesselClass*)ptr));
+    StateHash.Remove(RTTI_VESSEL, Vessels.ID((VesselClass*)ptr));
     Vessels.Free((VesselClass*)ptr);
 }
 
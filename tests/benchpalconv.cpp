@@ -0,0 +1,246 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "palconv.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#ifdef SDL2_BUILD
+#include <SDL.h>
+#endif
+
+/*
+** Palette conversion benchmark.
+**
+** Converts a random 8 bit frame to 32 and 16 bit RGB with PaletteConvertClass. When the SDL2 backend is built the
+** same frame is also converted with SDL_BlitSurface, which must give the same pixels. Either way a few palette
+** entries are first checked against fixed values in several formats.
+**
+** Usage: bench_palconv [-WIDTH:<pixels>] [-HEIGHT:<pixels>] [-FRAMES:<count>]
+*/
+
+struct FormatType
+{
+    char const* Name;
+    int Bits;
+    uint32_t Masks[4];
+#ifdef SDL2_BUILD
+    Uint32 Format;
+#endif
+};
+
+static FormatType const Formats[] = {
+#ifdef SDL2_BUILD
+    {"ARGB8888", 32, {0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000}, SDL_PIXELFORMAT_ARGB8888},
+    {"RGB565", 16, {0xF800, 0x07E0, 0x001F, 0}, SDL_PIXELFORMAT_RGB565},
+#else
+    {"ARGB8888", 32, {0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000}},
+    {"RGB565", 16, {0xF800, 0x07E0, 0x001F, 0}},
+#endif
+};
+
+static double Now(void)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+** A few palette entries and what they must come out as in each format, worked out by hand. Index 0 is fully
+** transparent as in the game palettes.
+*/
+static unsigned char const KnownColors[][4] = {
+    {0x00, 0x00, 0x00, 0x00},
+    {0x12, 0x34, 0x56, 0xFF},
+    {0xFF, 0xFF, 0xFF, 0xFF},
+    {0xF8, 0x04, 0x08, 0xFF},
+    {0x80, 0x40, 0x20, 0xFF},
+};
+
+struct KnownFormatType
+{
+    char const* Name;
+    int Bits;
+    uint32_t Masks[4];
+    uint32_t Pixels[sizeof(KnownColors) / sizeof(KnownColors[0])];
+};
+
+static KnownFormatType const KnownFormats[] = {
+    {"ARGB8888",
+     32,
+     {0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000},
+     {0x00000000, 0xFF123456, 0xFFFFFFFF, 0xFFF80408, 0xFF804020}},
+    {"ABGR8888",
+     32,
+     {0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000},
+     {0x00000000, 0xFF563412, 0xFFFFFFFF, 0xFF0804F8, 0xFF204080}},
+    {"RGB888", 32, {0x00FF0000, 0x0000FF00, 0x000000FF, 0}, {0x000000, 0x123456, 0xFFFFFF, 0xF80408, 0x804020}},
+    {"RGB565", 16, {0xF800, 0x07E0, 0x001F, 0}, {0x0000, 0x11AA, 0xFFFF, 0xF821, 0x8204}},
+    {"RGB555", 16, {0x7C00, 0x03E0, 0x001F, 0}, {0x0000, 0x08CA, 0x7FFF, 0x7C01, 0x4104}},
+};
+
+/*
+** Converts a row that goes through the known entries several times, long enough to take both the unrolled and
+** the leftover pixel paths, and checks every pixel against the values above.
+*/
+static bool Check_Known_Values(void)
+{
+    enum
+    {
+        KNOWN = sizeof(KnownColors) / sizeof(KnownColors[0]),
+        WIDTH = 23
+    };
+
+    unsigned char colors[256 * 4];
+    memset(colors, 0, sizeof(colors));
+    memcpy(colors, KnownColors, sizeof(KnownColors));
+
+    unsigned char row[WIDTH];
+    for (int i = 0; i < WIDTH; i++) {
+        row[i] = (unsigned char)(i % KNOWN);
+    }
+
+    bool same = true;
+
+    for (unsigned f = 0; f < sizeof(KnownFormats) / sizeof(KnownFormats[0]); f++) {
+        KnownFormatType const& format = KnownFormats[f];
+        unsigned char converted[WIDTH * 4];
+
+        PaletteConvertClass converter;
+        converter.Set_Format(format.Bits, format.Masks[0], format.Masks[1], format.Masks[2], format.Masks[3]);
+        converter.Set_Colors(colors);
+        converter.Convert(row, WIDTH, converted, sizeof(converted), WIDTH, 1);
+
+        for (int i = 0; i < WIDTH; i++) {
+            uint32_t pixel;
+            if (format.Bits == 32) {
+                memcpy(&pixel, &converted[i * 4], 4);
+            } else {
+                uint16_t value;
+                memcpy(&value, &converted[i * 2], 2);
+                pixel = value;
+            }
+
+            if (pixel != format.Pixels[row[i]]) {
+                printf("%s: pixel %d (entry %d) is %08X, expected %08X\n",
+                       format.Name,
+                       i,
+                       row[i],
+                       (unsigned)pixel,
+                       (unsigned)format.Pixels[row[i]]);
+                same = false;
+                break;
+            }
+        }
+    }
+
+    return same;
+}
+
+int main(int argc, char** argv)
+{
+    int width = 1920;
+    int height = 1080;
+    int frames = 100;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "-WIDTH:", 7) == 0) {
+            width = atoi(argv[i] + 7);
+        } else if (strncmp(argv[i], "-HEIGHT:", 8) == 0) {
+            height = atoi(argv[i] + 8);
+        } else if (strncmp(argv[i], "-FRAMES:", 8) == 0) {
+            frames = atoi(argv[i] + 8);
+        } else {
+            printf("Usage: bench_palconv [-WIDTH:<pixels>] [-HEIGHT:<pixels>] [-FRAMES:<count>]\n");
+            return 1;
+        }
+    }
+
+    if (width < 1 || height < 1 || frames < 1) {
+        printf("The size and count must be at least 1.\n");
+        return 1;
+    }
+
+    unsigned seed = 1;
+    std::vector<unsigned char> frame(width * height);
+    for (size_t i = 0; i < frame.size(); i++) {
+        seed = seed * 1103515245 + 12345;
+        frame[i] = (unsigned char)(seed >> 16);
+    }
+
+    unsigned char colors[256 * 4];
+    for (int i = 0; i < 256 * 4; i++) {
+        seed = seed * 1103515245 + 12345;
+        colors[i] = (unsigned char)(seed >> 16);
+    }
+    for (int i = 0; i < 256; i++) {
+        colors[i * 4 + 3] = i == 0 ? 0 : 0xFF;
+    }
+
+#ifdef SDL2_BUILD
+    SDL_Surface* source = SDL_CreateRGBSurfaceFrom(&frame[0], width, height, 8, width, 0, 0, 0, 0);
+    SDL_SetPaletteColors(source->format->palette, (SDL_Color*)colors, 0, 256);
+#endif
+
+    bool same = Check_Known_Values();
+
+    for (unsigned f = 0; f < sizeof(Formats) / sizeof(Formats[0]); f++) {
+        FormatType const& format = Formats[f];
+        int pitch = width * format.Bits / 8;
+        std::vector<unsigned char> converted(pitch * height);
+
+        PaletteConvertClass converter;
+        converter.Set_Format(format.Bits, format.Masks[0], format.Masks[1], format.Masks[2], format.Masks[3]);
+        converter.Set_Colors(colors);
+
+        double start = Now();
+        for (int i = 0; i < frames; i++) {
+            converter.Convert(&frame[0], width, &converted[0], pitch, width, height);
+        }
+        double table_time = Now() - start;
+
+#ifdef SDL2_BUILD
+        std::vector<unsigned char> expected(pitch * height);
+        SDL_Surface* dest =
+            SDL_CreateRGBSurfaceWithFormatFrom(&expected[0], width, height, format.Bits, pitch, format.Format);
+
+        start = Now();
+        for (int i = 0; i < frames; i++) {
+            SDL_BlitSurface(source, nullptr, dest, nullptr);
+        }
+        double blit_time = Now() - start;
+
+        SDL_FreeSurface(dest);
+
+        bool match = memcmp(&expected[0], &converted[0], expected.size()) == 0;
+        same &= match;
+
+        printf("%s %dx%d: SDL_BlitSurface %.3f ms/frame, palette table %.3f ms/frame, %.2fx, output %s\n",
+               format.Name,
+               width,
+               height,
+               blit_time * 1000.0 / frames,
+               table_time * 1000.0 / frames,
+               blit_time / table_time,
+               match ? "matches" : "DIFFERS");
+#else
+        printf("%s %dx%d: palette table %.3f ms/frame\n", format.Name, width, height, table_time * 1000.0 / frames);
+#endif
+    }
+
+#ifdef SDL2_BUILD
+    SDL_FreeSurface(source);
+#endif
+
+    return same ? 0 : 1;
+}
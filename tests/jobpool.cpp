@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include "common/jobpool.h"
+
+struct BestType
+{
+    int Value;
+    int Index;
+};
+
+struct SearchType
+{
+    int const* Values;
+    BestType Best[JobPoolClass::MAX_CHUNKS];
+};
+
+/*
+** Finds the first of the highest values, the way the game's target scans do.
+*/
+static void Find_Best(int chunk, int first, int last, void* data)
+{
+    SearchType& search = *static_cast<SearchType*>(data);
+    BestType best = {-1, -1};
+
+    for (int index = first; index < last; ++index) {
+        if (search.Values[index] > best.Value) {
+            best.Value = search.Values[index];
+            best.Index = index;
+        }
+    }
+
+    search.Best[chunk] = best;
+}
+
+int test_matches_serial(JobPoolClass& pool)
+{
+    static int values[5000];
+    unsigned seed = 1;
+
+    for (int pass = 0; pass < 200; ++pass) {
+        int count = 1 + pass * 25;
+
+        for (int index = 0; index < count; ++index) {
+            seed = seed * 1103515245 + 12345;
+            values[index] = (seed >> 16) % 50;
+        }
+
+        SearchType search;
+        search.Values = values;
+        int chunks = pool.Run(count, 0, Find_Best, &search);
+
+        BestType best = {-1, -1};
+        for (int chunk = 0; chunk < chunks; ++chunk) {
+            if (search.Best[chunk].Value > best.Value) {
+                best = search.Best[chunk];
+            }
+        }
+
+        BestType serial = {-1, -1};
+        for (int index = 0; index < count; ++index) {
+            if (values[index] > serial.Value) {
+                serial.Value = values[index];
+                serial.Index = index;
+            }
+        }
+
+        if (best.Value != serial.Value || best.Index != serial.Index) {
+            fprintf(stderr,
+                    "%d items in %d chunks: best %d at %d, expected %d at %d\n",
+                    count,
+                    chunks,
+                    best.Value,
+                    best.Index,
+                    serial.Value,
+                    serial.Index);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    JobPoolClass pool;
+
+    if (test_matches_serial(pool) != 0) {
+        return 1;
+    }
+
+    pool.Start(3);
+    if (pool.Chunks() != 4 || test_matches_serial(pool) != 0) {
+        return 1;
+    }
+
+    pool.Stop();
+    pool.Start(0);
+    if (test_matches_serial(pool) != 0) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "common/gbuffer.h"
+#include "common/keyframe.h"
+#include "common/shape.h"
+#include "common/wwkeyboard.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+bool GameInFocus;
+int ScreenWidth;
+int WindowList[9][9];
+char* _ShapeBuffer = 0;
+WWKeyboardClass* Keyboard;
+
+void Process_Network()
+{
+}
+
+void Focus_Restore()
+{
+}
+
+void Focus_Loss()
+{
+}
+
+int Open_File(char const*, int)
+{
+    return 0;
+}
+
+void Close_File(int)
+{
+}
+
+int Read_File(int, void*, unsigned int)
+{
+    return 0;
+}
+
+void Mem_Copy(void const* source, void* dest, unsigned int bytes)
+{
+    memmove(dest, source, bytes);
+}
+
+void Buffer_Frame_To_Page(int x, int y, int w, int h, void* buffer, GraphicViewPortClass& view, int flags, ...);
+
+// Copied from keybuff.cpp
+#define SHAPE_TRANS 0x40
+
+enum
+{
+    FRAME_W = 45,
+    FRAME_H = 30,
+    PAGE_W = 80,
+    PAGE_H = 50,
+    GHOST_LEVELS = 3
+};
+
+static unsigned Seed = 12345;
+
+static unsigned char Random_Byte()
+{
+    Seed = Seed * 1103515245 + 12345;
+    return (Seed >> 16) & 0xFF;
+}
+
+/*
+** A frame held in the big shape buffer, with and without its opaque spans.
+*/
+static char ShapeBuffer[sizeof(ShapeHeaderType) + FRAME_W * FRAME_H + FRAME_H * 64];
+static ShapeHeaderType* Header = reinterpret_cast<ShapeHeaderType*>(ShapeBuffer);
+static unsigned char* Frame = reinterpret_cast<unsigned char*>(ShapeBuffer + sizeof(ShapeHeaderType));
+static char* Spans;
+
+static unsigned char GhostTable[256 + 256 * GHOST_LEVELS];
+static unsigned char FadeTable[256];
+static unsigned char Background[PAGE_W * PAGE_H];
+
+static void Make_Frame()
+{
+    // Rows of alternating transparent and opaque runs, with a fully transparent row and a fully
+    // opaque one.
+    for (int y = 0; y < FRAME_H; ++y) {
+        bool opaque = (Random_Byte() & 1) != 0;
+        int x = 0;
+
+        while (x < FRAME_W) {
+            int run = 1 + Random_Byte() % 20;
+
+            for (; run > 0 && x < FRAME_W; --run, ++x) {
+                unsigned char pixel = 0;
+
+                if (y == 4 || (y != 7 && opaque)) {
+                    pixel = 1 + Random_Byte() % 255;
+                }
+                Frame[y * FRAME_W + x] = pixel;
+            }
+            opaque = !opaque;
+        }
+    }
+
+    Spans = reinterpret_cast<char*>(Frame + FRAME_W * FRAME_H);
+    Build_Shape_Spans(Frame, FRAME_W, FRAME_H, reinterpret_cast<unsigned short*>(Spans));
+
+    BigShapeBufferStart = ShapeBuffer;
+    UseBigShapeBuffer = true;
+    Header->draw_flags = -1;
+    Header->shape_data = reinterpret_cast<char*>(sizeof(ShapeHeaderType));
+    Header->shape_buffer = 0;
+
+    for (int i = 0; i < 256; ++i) {
+        GhostTable[i] = (i % 3 == 0) ? Random_Byte() % GHOST_LEVELS : 0xFF;
+        FadeTable[i] = Random_Byte();
+    }
+    for (int i = 256; i < (int)sizeof(GhostTable); ++i) {
+        GhostTable[i] = Random_Byte();
+    }
+    for (int i = 0; i < PAGE_W * PAGE_H; ++i) {
+        Background[i] = Random_Byte();
+    }
+}
+
+static void Draw(GraphicBufferClass& page, bool spans, int x, int y, int flags, int fade_count)
+{
+    Header->span_data = spans ? Spans - (uintptr_t)ShapeBuffer : nullptr;
+    memcpy(page.Get_Buffer(), Background, sizeof(Background));
+
+    if (flags & SHAPE_GHOST) {
+        if (flags & SHAPE_FADING) {
+            Buffer_Frame_To_Page(x, y, FRAME_W, FRAME_H, ShapeBuffer, page, flags, GhostTable, FadeTable, fade_count);
+        } else {
+            Buffer_Frame_To_Page(x, y, FRAME_W, FRAME_H, ShapeBuffer, page, flags, GhostTable);
+        }
+    } else if (flags & SHAPE_FADING) {
+        Buffer_Frame_To_Page(x, y, FRAME_W, FRAME_H, ShapeBuffer, page, flags, FadeTable, fade_count);
+    } else {
+        Buffer_Frame_To_Page(x, y, FRAME_W, FRAME_H, ShapeBuffer, page, flags);
+    }
+}
+
+/*
+** Drawing with the spans must give the same picture as drawing without them.
+*/
+int test_spans()
+{
+    static const int flag_sets[] = {SHAPE_TRANS,
+                                    SHAPE_TRANS | SHAPE_GHOST,
+                                    SHAPE_TRANS | SHAPE_FADING,
+                                    SHAPE_TRANS | SHAPE_GHOST | SHAPE_FADING};
+    static const int fade_counts[] = {0, 1, 3};
+    static const int places[][2] = {{10, 8}, {-7, -5}, {PAGE_W - 30, PAGE_H - 12}, {-20, 30}};
+    int ret = 0;
+
+    GraphicBufferClass with_spans(PAGE_W, PAGE_H);
+    GraphicBufferClass without_spans(PAGE_W, PAGE_H);
+
+    if (!with_spans.Lock() || !without_spans.Lock()) {
+        fprintf(stderr, "gb.Lock() failed.\n");
+        return 1;
+    }
+
+    for (int flags : flag_sets) {
+        for (int fade_count : fade_counts) {
+            for (auto& place : places) {
+                Draw(with_spans, true, place[0], place[1], flags, fade_count);
+                Draw(without_spans, false, place[0], place[1], flags, fade_count);
+
+                if (memcmp(with_spans.Get_Buffer(), without_spans.Get_Buffer(), PAGE_W * PAGE_H) != 0) {
+                    fprintf(stderr,
+                            "Drawing with spans at %d,%d with flags %04X and fade count %d did not match.\n",
+                            place[0],
+                            place[1],
+                            flags,
+                            fade_count);
+                    ret = 1;
+                }
+            }
+        }
+    }
+
+    with_spans.Unlock();
+    without_spans.Unlock();
+    return ret;
+}
+
+/*
+** The transparent blit without spans must match drawing one pixel at a time.
+*/
+int test_trans()
+{
+    int ret = 0;
+    GraphicBufferClass page(PAGE_W, PAGE_H);
+
+    if (!page.Lock()) {
+        fprintf(stderr, "gb.Lock() failed.\n");
+        return 1;
+    }
+
+    Draw(page, false, 3, 2, SHAPE_TRANS, 0);
+
+    unsigned char expected[PAGE_W * PAGE_H];
+    memcpy(expected, Background, sizeof(expected));
+    for (int y = 0; y < FRAME_H; ++y) {
+        for (int x = 0; x < FRAME_W; ++x) {
+            if (Frame[y * FRAME_W + x]) {
+                expected[(y + 2) * PAGE_W + x + 3] = Frame[y * FRAME_W + x];
+            }
+        }
+    }
+
+    if (memcmp(page.Get_Buffer(), expected, sizeof(expected)) != 0) {
+        fprintf(stderr, "Buffer_Frame_To_Page with SHAPE_TRANS did not generate the expected result.\n");
+        ret = 1;
+    }
+
+    page.Unlock();
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    Make_Frame();
+    ret |= test_spans();
+    ret |= test_trans();
+
+    return ret;
+}
@@ -196,6 +196,30 @@ int test_bitarray()
     return ret;
 }
 
+int test_lowest_bit()
+{
+    int ret = 0;
+
+    for (int bit = 0; bit < 32; bit++) {
+        unsigned value = 1U << bit;
+        int result = Lowest_Bit(value);
+
+        if (result != bit) {
+            fprintf(stderr, "Lowest_Bit(%08X) -> %d, expected %d\n", value, result, bit);
+            ret = 1;
+        }
+
+        result = Lowest_Bit(value | 0x80000000U);
+
+        if (result != bit) {
+            fprintf(stderr, "Lowest_Bit(%08X) -> %d, expected %d\n", value | 0x80000000U, result, bit);
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
+
 int test_swap()
 {
     int ret = 0;
@@ -267,6 +291,7 @@ int main(int argc, char** argv)
     ret |= test_calcx_calcy();
     ret |= test_fixed_cardinal();
     ret |= test_bitarray();
+    ret |= test_lowest_bit();
     ret |= test_swap();
     ret |= test_strtrim();
 
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "common/ramfile.h"
+#include "common/savepipe.h"
+#include "common/sha.h"
+#include "common/xpipe.h"
+
+/*
+** Counts what it is given and throws it away.
+*/
+class CountPipe : public Pipe
+{
+public:
+    CountPipe(void)
+        : Count(0)
+    {
+    }
+
+    virtual int Put(void const* source, int slen)
+    {
+        Count += slen;
+        return (slen);
+    }
+
+    int Count;
+};
+
+/*
+** Game data stand-in: many small puts of mixed sizes, some of it repetitive so LCW has work to do.
+*/
+static void Put_Data(Pipe& pipe)
+{
+    unsigned seed = 12345;
+    char chunk[3000];
+
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245 + 12345;
+        int size = 1 + (seed >> 16) % sizeof(chunk);
+        for (int j = 0; j < size; j++) {
+            chunk[j] = (i & 1) ? (char)(j / 16) : (char)((seed >> 8) + j * 7);
+        }
+        pipe.Put(chunk, size);
+    }
+}
+
+/*
+** Writes a save file the way the game does: a header with room for the digest, then the body through the
+** save pipe, fed either directly or from a snapshot of the data. Returns the offset of the digest.
+*/
+static int Save(std::vector<char>& image, SnapshotPipe const* snapshot)
+{
+    static char const key[BlowfishEngine::MAX_KEY_LENGTH] = "save pipe test key, any 56 bytes will do for this test";
+    static char const header[] = "save pipe test header";
+
+    image.assign(8 * 1024 * 1024, 0);
+    RAMFileClass file(&image[0], (int)image.size());
+    file.Open(WRITE);
+    FilePipe fpipe(&file);
+
+    fpipe.Put(header, sizeof(header));
+    int digest_pos = file.Seek(0, SEEK_CUR);
+    char digest[20] = {0};
+    fpipe.Put(digest, sizeof(digest));
+
+    SavePipe pipe(key, sizeof(key), 4096);
+    pipe.Put_To(fpipe);
+    if (snapshot != NULL) {
+        snapshot->Write_To(pipe);
+    } else {
+        Put_Data(pipe);
+    }
+    pipe.Put_Digest(file, fpipe, digest_pos);
+    pipe.End();
+
+    image.resize(file.Size());
+    file.Close();
+    return (digest_pos);
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<char> direct;
+    int digest_pos = Save(direct, NULL);
+
+    SnapshotPipe snapshot;
+    Put_Data(snapshot);
+    std::vector<char> background;
+    Save(background, &snapshot);
+
+    if (direct.size() <= (unsigned)digest_pos + 20 || direct != background) {
+        fprintf(stderr,
+                "Saving from a snapshot wrote different bytes (%d and %d bytes).\n",
+                (int)direct.size(),
+                (int)background.size());
+        return 1;
+    }
+
+    /*
+    ** The digest must be of the body as it is in the file, since that is what loading checks.
+    */
+    SHAEngine sha;
+    char digest[20];
+    sha.Hash(&direct[digest_pos + 20], (int)direct.size() - digest_pos - 20);
+    sha.Result(digest);
+    if (memcmp(digest, &direct[digest_pos], sizeof(digest)) != 0) {
+        fprintf(stderr, "The message digest in the file doesn't match the body.\n");
+        return 1;
+    }
+
+    snapshot.Clear();
+    CountPipe empty;
+    snapshot.Write_To(empty);
+    if (empty.Count != 0) {
+        fprintf(stderr, "A cleared snapshot still had data.\n");
+        return 1;
+    }
+
+    printf("%d bytes saved the same both ways.\n", (int)direct.size());
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <atomic>
+#include <stdio.h>
+#include <thread>
+#include "common/spscqueue.h"
+
+int test_single_thread()
+{
+    SPSCQueueClass<int, 8> queue;
+    int value = 0;
+
+    if (!queue.Is_Empty() || queue.Get(value)) {
+        fprintf(stderr, "New queue is not empty\n");
+        return 1;
+    }
+
+    for (int i = 0; i < 7; ++i) {
+        if (!queue.Put(i)) {
+            fprintf(stderr, "Put(%d) failed before the queue was full\n", i);
+            return 1;
+        }
+    }
+
+    if (queue.Put(7)) {
+        fprintf(stderr, "Put succeeded on a full queue\n");
+        return 1;
+    }
+
+    for (int i = 0; i < 7; ++i) {
+        if (!queue.Get(value) || value != i) {
+            fprintf(stderr, "Get() -> %d, expected %d\n", value, i);
+            return 1;
+        }
+    }
+
+    if (!queue.Is_Empty()) {
+        fprintf(stderr, "Queue is not empty after taking every item\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_two_threads()
+{
+    static SPSCQueueClass<unsigned, 64> queue;
+    static std::atomic<bool> stop(false);
+    const unsigned count = 1000000;
+
+    std::thread producer([]() {
+        for (unsigned i = 0; i < count; ++i) {
+            while (!queue.Put(i)) {
+                if (stop.load()) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int ret = 0;
+
+    for (unsigned expected = 0; expected < count;) {
+        unsigned value;
+
+        if (!queue.Get(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (value != expected) {
+            fprintf(stderr, "Get() -> %u, expected %u\n", value, expected);
+            ret = 1;
+            stop = true;
+            break;
+        }
+
+        ++expected;
+    }
+
+    producer.join();
+
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_single_thread();
+    ret |= test_two_threads();
+
+    return ret;
+}
@@ -0,0 +1,194 @@
+#include "function.h"
+#include "common/benchjobs.h"
+#include "settings.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/*
+** Headless simulation benchmark.
+**
+** Plays back a game recorded with the -X switch (RecordFile) as fast as the game logic allows. Rendering
+** and audio are provided by the null backends and the frame limiter is bypassed, so the numbers reported only
+** reflect the cost of the simulation itself. The final game CRC is reported so that changes to the logic can be
+** checked for sync breakage against a known good run of the same recording.
+**
+** Several -BENCHFILE recordings can be given to check a batch of them. Each is played in a process of its own,
+** -BENCHJOBS at a time, or as many as there are cores if it isn't given.
+**
+** Usage: bench_simtd [-BENCHFILE:<recording>...] [-BENCHJOBS:<count>] [-BENCHFRAMES:<count>] [-BENCHCRC:<interval>]
+**                    [game options]
+*/
+
+enum
+{
+    MAX_BENCH_FILES = 256
+};
+
+static long long Percentile(std::vector<long long> const& sorted, int percent)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+
+    size_t index = (sorted.size() - 1) * percent / 100;
+    return sorted[index];
+}
+
+/*
+** Plays back one recording and prints its report. Returns false if the recording couldn't be played.
+*/
+static bool Play_Recording(char const* record_name, int max_frames, int crc_interval, int argc, char* argv[])
+{
+    /*
+    ** Skip the intro movie and make sure nothing throttles the game loop.
+    */
+    Special.IsFromInstall = true;
+    int frame_limit = Settings.Video.FrameLimit;
+    Settings.Video.FrameLimit = 0;
+
+    if (!Init_Game(argc, argv)) {
+        Settings.Video.FrameLimit = frame_limit;
+        return false;
+    }
+
+    RecordGame = false;
+    PlaybackGame = true;
+    RecordFile.Set_Name(record_name);
+
+    if (!RecordFile.Is_Available()) {
+        printf("bench_sim: recording '%s' not found.\n", record_name);
+        Settings.Video.FrameLimit = frame_limit;
+        return false;
+    }
+
+    /*
+    ** Select_Game loads the recorded session values and starts the scenario without entering the menus.
+    */
+    if (!Select_Game(false) || !PlaybackGame) {
+        printf("bench_sim: unable to start playback of '%s'.\n", record_name);
+        Settings.Video.FrameLimit = frame_limit;
+        return false;
+    }
+
+    SpecialDialog = SDLG_NONE;
+    InMainLoop = true;
+
+    std::vector<long long> frame_times;
+    frame_times.reserve(max_frames > 0 ? max_frames : 65536);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (;;) {
+        auto frame_start = std::chrono::steady_clock::now();
+        bool done = Main_Loop();
+        auto frame_end = std::chrono::steady_clock::now();
+
+        frame_times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(frame_end - frame_start).count());
+
+        if (crc_interval > 0 && (Frame % crc_interval) == 0) {
+            printf("bench_sim: frame %d CRC %08X\n", Frame, Get_Game_CRC());
+        }
+
+        if (done || (max_frames > 0 && (int)frame_times.size() >= max_frames)) {
+            break;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::vector<long long> sorted(frame_times);
+    std::sort(sorted.begin(), sorted.end());
+
+    printf("bench_sim: %s\n", record_name);
+    printf("  frames:     %d\n", (int)frame_times.size());
+    printf("  elapsed:    %.3f s\n", seconds);
+    printf("  ticks/sec:  %.1f\n", seconds > 0 ? frame_times.size() / seconds : 0.0);
+    printf("  frame p50:  %lld us\n", Percentile(sorted, 50));
+    printf("  frame p99:  %lld us\n", Percentile(sorted, 99));
+    printf("  frame max:  %lld us\n", sorted.empty() ? 0 : sorted.back());
+    printf("  final CRC:  %08X\n", Get_Game_CRC());
+
+    InMainLoop = false;
+    RecordFile.Close();
+    PlaybackGame = false;
+    Settings.Video.FrameLimit = frame_limit;
+    return true;
+}
+
+struct BenchJobsType
+{
+    char const* Files[MAX_BENCH_FILES];
+    int Count;
+    int MaxFrames;
+    int CRCInterval;
+    int Argc;
+    char** Argv;
+};
+
+static bool Bench_Job(int job, void* data)
+{
+    BenchJobsType const& jobs = *static_cast<BenchJobsType*>(data);
+    return Play_Recording(jobs.Files[job], jobs.MaxFrames, jobs.CRCInterval, jobs.Argc, jobs.Argv);
+}
+
+/*
+** Returns false if any recording could not be played, so that the exit code tells a batch script about it.
+*/
+bool Bench_Sim(int argc, char* argv[])
+{
+    BenchJobsType jobs;
+    jobs.Count = 0;
+    jobs.MaxFrames = 0;
+    jobs.CRCInterval = 0;
+    jobs.Argc = argc;
+    jobs.Argv = argv;
+    int max_running = 0;
+    int dropped = 0;
+
+    for (int index = 1; index < argc; index++) {
+        if (strnicmp(argv[index], "-BENCHFILE:", 11) == 0) {
+            if (jobs.Count < MAX_BENCH_FILES) {
+                jobs.Files[jobs.Count++] = argv[index] + 11;
+            } else {
+                ++dropped;
+            }
+        } else if (strnicmp(argv[index], "-BENCHFRAMES:", 13) == 0) {
+            jobs.MaxFrames = atoi(argv[index] + 13);
+        } else if (strnicmp(argv[index], "-BENCHCRC:", 10) == 0) {
+            jobs.CRCInterval = atoi(argv[index] + 10);
+        } else if (strnicmp(argv[index], "-BENCHJOBS:", 11) == 0) {
+            max_running = atoi(argv[index] + 11);
+        }
+    }
+
+    if (jobs.Count == 0) {
+        jobs.Files[jobs.Count++] = "RECORD.BIN";
+    }
+
+    if (dropped > 0) {
+        printf("bench_sim: only %d recordings can be given at once, %d left out\n", MAX_BENCH_FILES, dropped);
+    }
+
+    if (jobs.Count == 1 && max_running <= 1) {
+        return Play_Recording(jobs.Files[0], jobs.MaxFrames, jobs.CRCInterval, argc, argv) && dropped == 0;
+    }
+
+    if (max_running <= 0) {
+        max_running = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int failed = Run_Bench_Jobs(jobs.Count, max_running, Bench_Job, &jobs);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("bench_sim: %d recordings, %d at a time, %d failed\n", jobs.Count, max_running, failed);
+    printf("  elapsed:    %.3f s\n", seconds);
+
+    return failed == 0 && dropped == 0;
+}
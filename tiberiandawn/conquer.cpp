@@ -1493,6 +1493,13 @@ FacingType KN_To_Facing(int input)
  *=============================================================================================*/
 static void Sync_Delay(void)
 {
+#ifdef BENCH_SIM_BUILD
+    /*
+    ** The simulation benchmark runs frames back to back, there is nothing to wait for.
+    */
+    FrameTimer.Set(0);
+#endif
+
     /*
     ** Slow down with frame limiter first.
     */
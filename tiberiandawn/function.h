@@ -292,6 +292,11 @@ void Stop_Speaking(void);
 void Sound_Effect(VocType voc, COORDINATE coord = 0, int variation = 1);
 bool Is_Speaking(void);
 
+/*
+**	BENCHSIM.CPP
+*/
+bool Bench_Sim(int argc, char* argv[]);
+
 /*
 **	COMBAT.CPP
 */
@@ -602,6 +607,7 @@ bool Queue_Options(void);
 bool Queue_Exit(void);
 void Queue_AI(void);
 void Add_CRC(uint32_t* crc, uint32_t val);
+uint32_t Get_Game_CRC(void);
 
 /*
 **	REINF.CPP
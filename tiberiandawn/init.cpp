@@ -1563,6 +1563,7 @@ void Anim_Init(void)
     // AnimControl.VBIBit = VertBlank;
     // AnimControl.DrawFlags |= VQACFGF_TOPLEFT;
     AnimControl.OptionFlags |= VQAOPTF_CAPTIONS | VQAOPTF_EVA;
+    AnimControl.OptionFlags |= VQAOPTF_PIPELINE;
 
     if (SlowPalette) {
         AnimControl.OptionFlags |= VQAOPTF_SLOWPAL;
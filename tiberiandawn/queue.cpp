@@ -66,6 +66,7 @@
  *                                                                         *
  * Debugging:																					*
  *   Compute_Game_CRC -- Computes a CRC value of the entire game.				*
+ *   Get_Game_CRC -- Computes and returns the CRC of the entire game.      *
  *   Add_CRC -- Adds a value to a CRC                                      *
  *   Print_CRCs -- Prints a data file for finding Sync Bugs						*
  *   Init_Queue_Mono -- inits mono display                                 *
@@ -3279,6 +3280,28 @@ static void Compute_Game_CRC(void)
 
 } /* end of Compute_Game_CRC */
 
+/***************************************************************************
+ * Get_Game_CRC -- Computes and returns the CRC of the entire game.        *
+ *                                                                         *
+ * This lets code outside the queue (such as the simulation benchmark)     *
+ * sample the same value that is exchanged between peers for sync checks.  *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none.																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		CRC of the current game state												*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+uint32_t Get_Game_CRC(void)
+{
+    Compute_Game_CRC();
+    return (GameCRC);
+
+} /* end of Get_Game_CRC */
+
 /***************************************************************************
  * Add_CRC -- Adds a value to a CRC                                        *
  *                                                                         *
@@ -448,7 +448,14 @@ int main(int argc, char** argv)
         Memory_Error_Exit = Print_Error_End_Exit;
 
         CCDebugString("C&C95 - Entering main game.\n");
+        int exit_code = EXIT_SUCCESS;
+#ifdef BENCH_SIM_BUILD
+        if (!Bench_Sim(argc, argv)) {
+            exit_code = EXIT_FAILURE;
+        }
+#else
         Main_Game(argc, argv);
+#endif
 
         if (RunningAsDLL) {
             return (EXIT_SUCCESS);
@@ -503,7 +510,7 @@ int main(int argc, char** argv)
         // AllSurfaces.Release();
         // Reset_Video_Mode();
         // Stop_Profiler();
-        return (EXIT_SUCCESS);
+        return (exit_code);
 
         if (Palette) {
             delete[] Palette;